@@ -33,6 +33,68 @@ Accum::Accum(const SplitFrontier* splitFrontier,
 }
 
 
+Accum::Accum(const Obs* obsCell_,
+	     IndexT obsEnd_,
+	     const SumCount& sumCount_) :
+  obsCell(obsCell_),
+  sampleIndex(nullptr),
+  obsStart(0),
+  obsEnd(obsEnd_),
+  sumCount(sumCount_),
+  cutResidual(obsEnd),
+  implicitCand(0),
+  sum(sumCount.sum),
+  sCount(sumCount.sCount) {
+}
+
+
+double Accum::subsetGini(const vector<double>& sumSampled,
+			 const vector<double>& ctgSum,
+			 double sum) {
+  double ssL = 0.0;
+  double sumL = 0.0;
+  double ssR = 0.0;
+  PredictorT ctg = 0;
+  for (auto maskedSum : sumSampled) {
+    sumL += maskedSum;
+    ssL += maskedSum * maskedSum;
+    ssR += (ctgSum[ctg] - maskedSum) * (ctgSum[ctg] - maskedSum);
+    ctg++;
+  }
+
+  return infoGini(ssL, ssR, sumL, sum - sumL);
+}
+
+
+STRIPE_CLONES
+void Accum::infoVarStripe(const double sumLeft[],
+			  const double sCountLeft[],
+			  double sumTot,
+			  double sCountTot,
+			  IndexT width,
+			  double infoStripe[]) {
+#pragma omp simd
+  for (IndexT idx = 0; idx < width; idx++) {
+    double sumRight = sumTot - sumLeft[idx];
+    infoStripe[idx] = (sumLeft[idx] * sumLeft[idx]) / sCountLeft[idx] + (sumRight * sumRight) / (sCountTot - sCountLeft[idx]);
+  }
+}
+
+
+STRIPE_CLONES
+void Accum::infoGiniStripe(const double ssLeft[],
+			   const double ssRight[],
+			   const double sumLeft[],
+			   double sumTot,
+			   IndexT width,
+			   double infoStripe[]) {
+#pragma omp simd
+  for (IndexT idx = 0; idx < width; idx++) {
+    infoStripe[idx] = ssLeft[idx] / sumLeft[idx] + ssRight[idx] / (sumTot - sumLeft[idx]);
+  }
+}
+
+
 SumCount Accum::filterMissing(const SplitNux& cand) const {
   double sumCand = cand.getSum();
   IndexT sCountCand = cand.getSCount();
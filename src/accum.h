@@ -17,6 +17,19 @@
 #include "typeparam.h"
 #include "sumcount.h"
 
+#include <vector>
+
+/**
+   @brief Compiles stripe kernels for several x86 instruction sets, the
+   loader selecting among them by the host processor.  Elsewhere a
+   single, portable kernel is compiled.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__) && defined(__GLIBC__)
+#define STRIPE_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define STRIPE_CLONES
+#endif
+
 
 /**
    @brief Accumulated values for categorical nodes.
@@ -62,9 +75,26 @@ public:
   double sum; ///< Running sum of trial LHS response.
   IndexT sCount; ///< Running sum of trial LHS sample counts.
 
+  static constexpr IndexT stripeWidth = 64; ///< # observations per stripe.
+
   Accum(const class SplitFrontier* splitFrontier,
 	const class SplitNux& cand);
 
+
+  /**
+     @brief Constructor for a local workspace of explicit observations,
+     as built by a finisher.
+
+     @param obsCell_ are the observations, in splitting order.
+
+     @param obsEnd_ is the number of observations.
+
+     @param sumCount_ summarizes the observations' responses.
+   */
+  Accum(const class Obs* obsCell_,
+	IndexT obsEnd_,
+	const SumCount& sumCount_);
+
   /**
      @brief Computes weighted-variance for trial split.
 
@@ -95,6 +125,50 @@ public:
   }
 
 
+  /**
+     @brief Determines whether a trial split respects a monotone
+     constraint.
+
+     @param monoMode is the direction of the constraint, if nonzero.
+
+     @param sumL is the response sum to the left of the split.
+
+     @param sCountL is the sample count to the left.
+
+     @param scTot summarizes the node's response.
+
+     @return false iff constrained and sense violated.
+   */
+  static bool senseMonotone(int monoMode,
+			    double sumL,
+			    IndexT sCountL,
+			    const SumCount& scTot) {
+    if (monoMode == 0)
+      return true;
+
+    IndexT sCountR = scTot.sCount - sCountL;
+    double sumR = scTot.sum - sumL;
+    bool accumNonDecreasing = (sumL * sCountR <= sumR * sCountL);
+    return monoMode > 0 ? accumNonDecreasing : !accumNonDecreasing;
+  }
+
+
+  /**
+     @brief Evaluates Gini of a subset from its per-category sums.
+
+     @param sumSampled are the subset's per-category response sums.
+
+     @param ctgSum are the node's per-category response sums.
+
+     @param sum is the node's response sum.
+
+     @return Gini information of the subset and its complement.
+   */
+  static double subsetGini(const vector<double>& sumSampled,
+			   const vector<double>& ctgSum,
+			   double sum);
+
+
   /**
      @brief Evaluates trial splitting information as Gini.
 
@@ -114,6 +188,42 @@ public:
   }
 
 
+  /**
+     @brief Evaluates weighted variance at each position of a stripe.
+
+     @param sumLeft[] are the trial left-hand response sums.
+
+     @param sCountLeft[] are the trial left-hand sample counts.
+
+     @param[out] infoStripe[] receives the information values.
+   */
+  static void infoVarStripe(const double sumLeft[],
+			    const double sCountLeft[],
+			    double sumTot,
+			    double sCountTot,
+			    IndexT width,
+			    double infoStripe[]);
+
+
+  /**
+     @brief Evaluates Gini at each position of a stripe.
+
+     @param ssLeft[] are the trial left-hand sums of squares.
+
+     @param ssRight[] are the trial right-hand sums of squares.
+
+     @param sumLeft[] are the trial left-hand response sums.
+
+     @param[out] infoStripe[] receives the information values.
+   */
+  static void infoGiniStripe(const double ssLeft[],
+			     const double ssRight[],
+			     const double sumLeft[],
+			     double sumTot,
+			     IndexT width,
+			     double infoStripe[]);
+
+
   /**
      @brief Maintains maximum 'info' value.
 
@@ -0,0 +1,96 @@
+// This file is part of ArboristCore.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file arena.cc
+
+   @brief Chunk management for per-thread bump allocation.
+
+   @author Mark Seligman
+ */
+
+#include "arena.h"
+
+#include <new>
+
+
+Arena::Arena() :
+  chunk(new (::operator new(chunkBytes)) Chunk()),
+  offset(chunkStart()) {
+}
+
+
+Arena::~Arena() {
+  disown(chunk);
+  for (Chunk* chunkRetired : retired) {
+    disown(chunkRetired);
+  }
+}
+
+
+void Arena::disown(Chunk* chunk) {
+  if (chunk->refCount.fetch_sub(1, memory_order_acq_rel) == 1) {
+    chunk->~Chunk();
+    ::operator delete(chunk);
+  }
+}
+
+
+void* Arena::allocate(size_t bytes) {
+  size_t extent = headerBytes + ((bytes + headerBytes - 1) & ~(headerBytes - 1));
+  char* base;
+  Chunk* owner;
+  if (extent >= largeBytes) {
+    base = static_cast<char*>(::operator new(extent));
+    owner = nullptr;
+  }
+  else {
+    if (offset + extent > chunkBytes) {
+      advance();
+    }
+    base = reinterpret_cast<char*>(chunk) + offset;
+    offset += extent;
+    owner = chunk;
+    owner->refCount.fetch_add(1, memory_order_relaxed);
+  }
+
+  *reinterpret_cast<Chunk**>(base) = owner;
+  return base + headerBytes;
+}
+
+
+void Arena::deallocate(void* ptr) {
+  char* base = static_cast<char*>(ptr) - headerBytes;
+  Chunk* owner = *reinterpret_cast<Chunk**>(base);
+  if (owner == nullptr) {
+    ::operator delete(base);
+  }
+  else if (owner->refCount.fetch_sub(1, memory_order_acq_rel) == 1) {
+    // Owner has already disowned the chunk.
+    owner->~Chunk();
+    ::operator delete(owner);
+  }
+}
+
+
+void Arena::advance() {
+  retired.push_back(chunk);
+  chunk = nullptr;
+  for (size_t idx = 0; idx < retired.size(); idx++) {
+    if (retired[idx]->refCount.load(memory_order_acquire) == 1) { // Owner only.
+      chunk = retired[idx];
+      retired[idx] = retired.back();
+      retired.pop_back();
+      break;
+    }
+  }
+
+  if (chunk == nullptr) {
+    chunk = new (::operator new(chunkBytes)) Chunk();
+  }
+  offset = chunkStart();
+}
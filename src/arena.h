@@ -0,0 +1,152 @@
+// This file is part of ArboristCore.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file arena.h
+
+   @brief Per-thread bump allocation for short-lived splitting temporaries.
+
+   @author Mark Seligman
+ */
+
+#ifndef CORE_ARENA_H
+#define CORE_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+
+/**
+   @brief Bump allocator over fixed-size chunks, one instance per thread.
+
+   Each chunk counts its live allocations, together with a reference
+   held by the owning thread.  A retired chunk is rewound and reused
+   as soon as its allocations have all been released, which for
+   level-scoped temporaries occurs at the close of the level.  Blocks
+   may be released by any thread, so vectors can migrate freely
+   between team members.  Large blocks bypass the arena.
+ */
+class Arena {
+  static constexpr size_t chunkBytes = 1ul << 16;
+  static constexpr size_t headerBytes = 16; ///< Preserves fundamental alignment.
+  static constexpr size_t largeBytes = chunkBytes / 4; ///< Smallest unpooled block.
+
+  /**
+     @brief Chunk header, at the base of each chunk.
+   */
+  struct Chunk {
+    atomic<size_t> refCount; ///< # live blocks, plus one while owned.
+
+    Chunk() : refCount(1) {
+    }
+  };
+
+  Chunk* chunk; ///< Current chunk.
+  size_t offset; ///< Bump position within current chunk.
+  vector<Chunk*> retired; ///< Owned chunks possibly holding live blocks.
+
+
+  /**
+     @brief Retires the current chunk and replaces it with a free one.
+   */
+  void advance();
+
+
+  /**
+     @brief Drops the owner's reference, freeing the chunk if unused.
+   */
+  static void disown(Chunk* chunk);
+
+
+  static size_t chunkStart() {
+    return (sizeof(Chunk) + headerBytes - 1) & ~(headerBytes - 1);
+  }
+
+public:
+
+  Arena();
+
+
+  /**
+     @brief Disowns all chunks; those still referenced are freed by
+     their last releasing thread.
+   */
+  ~Arena();
+
+
+  /**
+     @return block of at least 'bytes', aligned as operator new.
+   */
+  void* allocate(size_t bytes);
+
+
+  /**
+     @brief Releases a block allocated by any thread's arena.
+   */
+  static void deallocate(void* ptr);
+
+
+  /**
+     @return calling thread's arena.
+   */
+  static Arena& local() {
+    thread_local Arena arena;
+    return arena;
+  }
+};
+
+
+/**
+   @brief Standard allocator drawing from the calling thread's arena.
+ */
+template<typename T>
+struct ArenaAlloc {
+  using value_type = T;
+
+  ArenaAlloc() = default;
+
+
+  template<typename U>
+  ArenaAlloc(const ArenaAlloc<U>&) {
+  }
+
+
+  T* allocate(size_t n) {
+    static_assert(alignof(T) <= alignof(max_align_t), "Overaligned arena type");
+    return static_cast<T*>(Arena::local().allocate(n * sizeof(T)));
+  }
+
+
+  void deallocate(T* ptr,
+		  size_t) {
+    Arena::deallocate(ptr);
+  }
+};
+
+
+template<typename T, typename U>
+bool operator==(const ArenaAlloc<T>&, const ArenaAlloc<U>&) {
+  return true;
+}
+
+
+template<typename T, typename U>
+bool operator!=(const ArenaAlloc<T>&, const ArenaAlloc<U>&) {
+  return false;
+}
+
+
+/**
+   @brief Vector allocated from the arena of the thread growing it.
+ */
+template<typename T>
+using ArenaVec = vector<T, ArenaAlloc<T>>;
+
+#endif
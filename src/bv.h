@@ -380,6 +380,19 @@ class BitMatrix : public BV {
   }
 
   
+  /**
+     @brief Obtains the slot containing a given coordinate.
+
+     Bits within the slot are ordered by column, beginning with the
+     column nearest below 'col' aligned to the slot width.
+
+     @return slot contents, with short-circuit for zero-length matrix.
+   */
+  BVSlotT getSlot(unsigned int row, IndexT col) const {
+    return stride == 0 ? 0 : getRaw((static_cast<size_t>(row) * stride + col) / slotElts);
+  }
+
+
   void setBit(unsigned int row,
 		     IndexT col,
 		     bool on = true) {
@@ -37,7 +37,7 @@ void Cand::precandidates(const Frontier* frontier,
 void Cand::candidateCartesian(const Frontier* frontier,
 			      InterLevel* interLevel) {
   IndexT idx = 0;
-  vector<double> dRand = PRNG::rUnif<double>(nPred * nSplit);
+  vector<double> dRand = PRNG::rUnif<double>(nPred * nSplit, 1.0, PRNG::Purpose::candidate);
   for (IndexT splitIdx = 0; splitIdx < nSplit; splitIdx++) {
     if (!frontier->isUnsplitable(splitIdx)) { // Node can split.
       for (PredictorT predIdx = 0; predIdx < nPred; predIdx++) {
@@ -53,52 +53,73 @@ void Cand::candidateCartesian(const Frontier* frontier,
 
 void Cand::candidateBernoulli(const Frontier* frontier,
 			      InterLevel* interLevel,
-			      const vector<double>& predProb) {
-  vector<double> ruPred = PRNG::rUnif<double>(nSplit * nPred);
+			      const vector<double>& spaceProb,
+			      double probMax) {
+  const vector<PredictorT>& predSpace = frontier->getPredSpace();
+  PredictorT nSpace = predSpace.size();
+  if (probMax <= sparseProb) { // Skips over unsampled predictors.
+    uint64_t cursor = 0;
+    for (IndexT splitIdx = 0; splitIdx < nSplit; splitIdx++) {
+      if (frontier->isUnsplitable(splitIdx)) { // Node cannot split.
+	continue;
+      }
+      sampleSkip(nSpace, spaceProb, probMax, cursor,
+		 [&](PredictorT spaceIdx, double ru) {
+		   SplitCoord coord(splitIdx, predSpace[spaceIdx]);
+		   if (interLevel->preschedule(coord)) {
+		     preCand[splitIdx].emplace_back(coord, getRandLow(ru));
+		   }
+		 });
+    }
+    PRNG::skip(cursor, PRNG::Purpose::candidate);
+    return;
+  }
+
+  // Each node reads its own window of a notional level-wide draw.
   for (IndexT splitIdx = 0; splitIdx < nSplit; splitIdx++) {
     if (frontier->isUnsplitable(splitIdx)) { // Node cannot split.
       continue;
     }
-    IndexT ruOff = splitIdx * nPred;
-    for (PredictorT predIdx = 0; predIdx != nPred; predIdx++) {
-      if (ruPred[ruOff] < predProb[predIdx]) {
-	SplitCoord coord(splitIdx, predIdx);
+    vector<double> ruPred = PRNG::rUnifAt(static_cast<uint64_t>(splitIdx) * nSpace, nSpace, PRNG::Purpose::candidate);
+    for (PredictorT spaceIdx = 0; spaceIdx != nSpace; spaceIdx++) {
+      if (ruPred[spaceIdx] < spaceProb[spaceIdx]) {
+	SplitCoord coord(splitIdx, predSpace[spaceIdx]);
 	if (interLevel->preschedule(coord)) {
-	  preCand[splitIdx].emplace_back(coord, getRandLow(ruPred[ruOff]));
+	  preCand[splitIdx].emplace_back(coord, getRandLow(ruPred[spaceIdx]));
 	}
       }
-      ruOff++;
     }
   }
+  PRNG::skip(static_cast<uint64_t>(nSplit) * nSpace, PRNG::Purpose::candidate);
 }
 
 
 void Cand::candidateFixed(const Frontier* frontier,
 			  InterLevel* interLevel,
 			  PredictorT predFixed) {
-  vector<double> ruPred = PRNG::rUnif<double>(nSplit * nPred);
-
+  // Variates are read lazily from a notional level-wide draw, so that
+  // only those predictors visited incur a cost.
+  const vector<PredictorT>& predSpace = frontier->getPredSpace();
+  PredictorT nSpace = predSpace.size();
   for (IndexT splitIdx = 0; splitIdx < nSplit; splitIdx++) {
     if (frontier->isUnsplitable(splitIdx)) { // Node cannot split.
       continue;
     }
-    vector<PredictorT> predRand(nPred);
-    iota(predRand.begin(), predRand.end(), 0);
-    IndexT ruOff = splitIdx * nPred;
+    PredShuffle predRand(nSpace);
+    uint64_t ruOff = static_cast<uint64_t>(splitIdx) * nSpace;
     PredictorT schedCount = 0;
-    for (PredictorT predTop = nPred; predTop != 0; predTop--) {
-      PredictorT idxRand = predTop * ruPred[ruOff];
-      PredictorT predIdx = exchange(predRand[idxRand], predRand[predTop-1]);
-      SplitCoord coord(splitIdx, predIdx);
+    while (!predRand.empty()) {
+      double ru = PRNG::unifAt(ruOff++, PRNG::Purpose::candidate);
+      SplitCoord coord(splitIdx, predSpace[predRand.next(ru)]);
       if (interLevel->preschedule(coord)) {
-	preCand[splitIdx].emplace_back(coord, getRandLow(ruPred[ruOff]));
+	preCand[splitIdx].emplace_back(coord, getRandLow(ru));
 	if (++schedCount == predFixed) {
 	  break;
 	}
       }
-      ruOff++;
     }
   }
+  PRNG::skip(static_cast<uint64_t>(nSplit) * nSpace, PRNG::Purpose::candidate);
 }
 
 
@@ -18,8 +18,11 @@
 
 #include "typeparam.h"
 #include "splitcoord.h"
+#include "prng.h"
 
 #include <vector>
+#include <unordered_map>
+#include <cmath>
 
 /**
    @brief Minimal information needed to preschedule a splitting candidate.
@@ -48,7 +51,51 @@ struct PreCand {
 };
 
 
+/**
+   @brief Lazily-shuffled permutation of predictor indices.
+
+   Visits predictors in uniformly random order, without replacement,
+   as would a Fisher-Yates shuffle of the full range.  Only displaced
+   entries are recorded, so the cost is proportional to the number of
+   predictors visited rather than to the predictor count.
+ */
+class PredShuffle {
+  PredictorT top; ///< # predictors not yet visited.
+  unordered_map<PredictorT, PredictorT> displaced; ///< Position -> predictor.
+
+  PredictorT at(PredictorT pos) const {
+    auto it = displaced.find(pos);
+    return it == displaced.end() ? pos : it->second;
+  }
+
+public:
+  PredShuffle(PredictorT nPred) :
+    top(nPred) {
+  }
+
+
+  bool empty() const {
+    return top == 0;
+  }
+
+
+  /**
+     @param ru is a uniform variate over (0, 1).
+
+     @return next predictor in the permutation.
+   */
+  PredictorT next(double ru) {
+    PredictorT idxRand = top * ru;
+    PredictorT predIdx = at(idxRand);
+    displaced[idxRand] = at(--top);
+    return predIdx;
+  }
+};
+
+
 struct Cand {
+  static constexpr double sparseProb = 0.25; ///< Highest rate sampled by skipping.
+
   const IndexT nSplit;
   const PredictorT nPred;
 
@@ -70,13 +117,19 @@ struct Cand {
 
   /**
      @brief Accepts precandidates using Bernoulli sampling.
+
+     @param spaceProb are the probabilities of the tree's subspace.
+
+     @param probMax is the highest sampling probability.
    */
   void candidateBernoulli(const class Frontier* frontier,
 			  class InterLevel* interLevel,
-			  const vector<double>& predProb);
+			  const vector<double>& spaceProb,
+			  double probMax);
 
   /**
-     @brief Samples fixed number of precandidates without replacement.
+     @brief Samples fixed number of precandidates without replacement
+     from the tree's subspace.
    */
   void candidateFixed(const class Frontier* frontier,
 		      class InterLevel* interLevel,
@@ -97,6 +150,27 @@ struct Cand {
 						class SplitFrontier* splitFrontier) const;
 
 
+  /**
+     @brief Bernoulli sampling by geometric skips at the highest rate,
+     thinned to each predictor's own rate.
+
+     Cost is proportional to the expected number of predictors
+     sampled at the highest rate.
+
+     @param cursor is the offset of the next unread candidate
+     variate, advanced over those read.
+
+     @param visit is invoked on each predictor sampled, together with
+     its variate.
+   */
+  template<typename Visit>
+  static void sampleSkip(PredictorT nPred,
+			 const vector<double>& predProb,
+			 double probMax,
+			 uint64_t& cursor,
+			 Visit visit);
+
+
   /**
      @brief Extracts the 32 lowest-order mantissa bits of a double-valued
      random variate.
@@ -113,4 +187,29 @@ struct Cand {
   }
 };
 
+
+template<typename Visit>
+void Cand::sampleSkip(PredictorT nPred,
+		      const vector<double>& predProb,
+		      double probMax,
+		      uint64_t& cursor,
+		      Visit visit) {
+  if (probMax <= 0.0)
+    return;
+
+  double logMiss = log1p(-probMax);
+  PredictorT predIdx = 0;
+  while (true) {
+    double ru = PRNG::unifAt(cursor++, PRNG::Purpose::candidate);
+    double gap = probMax >= 1.0 ? 0.0 : floor(log(ru) / logMiss);
+    if (gap >= nPred - predIdx)
+      break;
+    predIdx += gap;
+    if (predProb[predIdx] >= probMax || PRNG::unifAt(cursor++, PRNG::Purpose::candidate) * probMax < predProb[predIdx]) {
+      visit(predIdx, ru);
+    }
+    predIdx++;
+  }
+}
+
 #endif
@@ -17,9 +17,14 @@
 #include "interlevel.h"
 #include "frontier.h"
 
+#include <algorithm>
+#include <numeric>
+
 
 PredictorT CandRF::predFixed = 0;
 vector<double> CandRF::predProb;
+double CandRF::probMax = 0.0;
+PredictorT CandRF::predTree = 0;
 
 
 CandRF::CandRF(InterLevel* interLevel) :
@@ -28,24 +33,60 @@ CandRF::CandRF(InterLevel* interLevel) :
 
 
 void CandRF::init(PredictorT feFixed,
-	     const vector<double>& feProb) {
+		  const vector<double>& feProb,
+		  PredictorT feTree) {
   predFixed = feFixed;
+  predTree = feTree;
   for (auto prob : feProb) {
     predProb.push_back(prob);
   }
+  probMax = predProb.empty() ? 0.0 : *max_element(predProb.begin(), predProb.end());
 }
 
 
 void CandRF::deInit() {
   predFixed = 0;
   predProb.clear();
+  probMax = 0.0;
+  predTree = 0;
+}
+
+
+vector<PredictorT> CandRF::treeSpace(PredictorT nPred) {
+  vector<PredictorT> predSpace;
+  if (predTree == 0 || predTree >= nPred) {
+    predSpace = vector<PredictorT>(nPred);
+    iota(predSpace.begin(), predSpace.end(), 0);
+    return predSpace;
+  }
+
+  PredShuffle predRand(nPred);
+  for (PredictorT idx = 0; idx != predTree; idx++) {
+    predSpace.push_back(predRand.next(PRNG::unifAt(idx, PRNG::Purpose::subspace)));
+  }
+  PRNG::skip(predTree, PRNG::Purpose::subspace);
+  sort(predSpace.begin(), predSpace.end());
+
+  return predSpace;
+}
+
+
+vector<double> CandRF::spaceProb(const vector<PredictorT>& predSpace) {
+  vector<double> probOut;
+  if (predFixed != 0)
+    return probOut;
+
+  for (PredictorT predIdx : predSpace) {
+    probOut.push_back(predProb[predIdx]);
+  }
+  return probOut;
 }
 
 
 void CandRF::precandidates(const Frontier* frontier,
 			   InterLevel* interLevel) {
   if (predFixed == 0) {
-    candidateBernoulli(frontier, interLevel, predProb);
+    candidateBernoulli(frontier, interLevel, frontier->getSpaceProb(), probMax);
   }
   else {
     candidateFixed(frontier, interLevel, predFixed);
@@ -29,11 +29,48 @@ struct CandRF : public Cand {
   CandRF(class InterLevel* interLevel);
 
   
+  /**
+     @param feTree is the size of the per-tree predictor subspace,
+     if nonzero.
+   */
   static void init(PredictorT feFixed,
-		   const vector<double>& feProb);
+		   const vector<double>& feProb,
+		   PredictorT feTree);
 
   static void deInit();
 
+
+  static PredictorT getPredFixed() {
+    return predFixed;
+  }
+
+
+  static const vector<double>& getPredProb() {
+    return predProb;
+  }
+
+
+  static double getProbMax() {
+    return probMax;
+  }
+
+
+  /**
+     @brief Draws the predictors eligible for splitting within a tree.
+
+     Draws from the calling thread's stream.
+
+     @return subspace predictors, in increasing order:  all if no
+     subspace has been specified.
+   */
+  static vector<PredictorT> treeSpace(PredictorT nPred);
+
+
+  /**
+     @return selection probabilities of the subspace predictors.
+   */
+  static vector<double> spaceProb(const vector<PredictorT>& predSpace);
+
   
   void precandidates(const class Frontier* frontier,
 		     class InterLevel* interLevel);
@@ -43,6 +80,8 @@ private:
   // Predictor sampling paraemters.
   static PredictorT predFixed;
   static vector<double> predProb;
+  static double probMax; ///< Highest of predProb.
+  static PredictorT predTree; ///< Per-tree subspace size, if nonzero.
 };
 
 #endif
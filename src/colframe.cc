@@ -0,0 +1,59 @@
+// This file is part of deframe.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file colframe.cc
+
+   @brief Methods transposing unsorted column-major frames.
+
+   @author Mark Seligman
+ */
+
+#include "colframe.h"
+
+#include <algorithm>
+
+
+ColFrame::ColFrame(size_t nObs_,
+		   vector<const double*> numBase_,
+		   vector<const unsigned int*> facBase_,
+		   vector<unsigned int> facTop_) :
+  nObs(nObs_),
+  numBase(std::move(numBase_)),
+  facBase(std::move(facBase_)),
+  facTop(std::move(facTop_)) {
+}
+
+
+void ColFrame::transpose(size_t obsStart,
+			 size_t extent,
+			 vector<double>& num,
+			 vector<CtgT>& fac) const {
+  size_t obsEnd = min(nObs, obsStart + extent);
+  size_t span = obsEnd - obsStart;
+  PredictorT nPredNum = getNPredNum();
+  PredictorT nPredFac = getNPredFac();
+  num.resize(span * nPredNum);
+  fac.resize(span * nPredFac);
+
+  // Column-outer order reads each front-end column sequentially.
+  for (PredictorT numIdx = 0; numIdx != nPredNum; numIdx++) {
+    const double* col = numBase[numIdx];
+    for (size_t obsIdx = obsStart; obsIdx != obsEnd; obsIdx++) {
+      num[(obsIdx - obsStart) * nPredNum + numIdx] = col[obsIdx];
+    }
+  }
+
+  // Codes exceeding the level count, including NA, map to the proxy.
+  for (PredictorT facIdx = 0; facIdx != nPredFac; facIdx++) {
+    const unsigned int* col = facBase[facIdx];
+    unsigned int maxVal = facTop[facIdx] + 1;
+    for (size_t obsIdx = obsStart; obsIdx != obsEnd; obsIdx++) {
+      fac[(obsIdx - obsStart) * nPredFac + facIdx] = min(maxVal, col[obsIdx]) - 1;
+    }
+  }
+}
@@ -0,0 +1,95 @@
+// This file is part of deframe.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file colframe.h
+
+   @brief Unsorted, column-major view of a prediction frame.
+
+   @author Mark Seligman
+ */
+
+#ifndef DEFRAME_COLFRAME_H
+#define DEFRAME_COLFRAME_H
+
+#include "typeparam.h"
+
+#include <vector>
+
+using namespace std;
+
+
+/**
+   @brief Aliases front-end columns for direct row-major prediction.
+
+   Unlike the RLEFrame, no ranking or run-length encoding is performed:
+   prediction reads observed values in place.  Columns must therefore
+   outlive the frame.
+ */
+struct ColFrame {
+  const size_t nObs; ///< # rows.
+  const vector<const double*> numBase; ///< Numeric columns, frame order.
+  const vector<const unsigned int*> facBase; ///< Factor columns, " ".
+  const vector<unsigned int> facTop; ///< Per-factor level count.
+
+
+  /**
+     @param facBase_ are one-based factor codes, in training encoding.
+
+     @param facTop_ are the cardinalities of the factors observed.
+   */
+  ColFrame(size_t nObs_,
+	   vector<const double*> numBase_,
+	   vector<const unsigned int*> facBase_,
+	   vector<unsigned int> facTop_);
+
+
+  /**
+     @brief Row count getter.
+   */
+  size_t getNRow() const {
+    return nObs;
+  }
+
+
+  /**
+     @brief Numeric predictor count getter.
+   */
+  PredictorT getNPredNum() const {
+    return numBase.size();
+  }
+
+
+  /**
+     @brief Factor predictor count getter.
+   */
+  PredictorT getNPredFac() const {
+    return facBase.size();
+  }
+
+
+  /**
+     @brief Gathers a block of rows into row-major staging.
+
+     Factor codes are clipped and rebased precisely as for the RLEFrame,
+     so that both paths present identical values to the forest walker.
+
+     @param obsStart is the first row of the block.
+
+     @param extent is the maximal number of rows to gather.
+
+     @param[out] num accumulates numeric values, by row.
+
+     @param[out] fac accumulates zero-based factor codes, by row.
+   */
+  void transpose(size_t obsStart,
+		 size_t extent,
+		 vector<double>& num,
+		 vector<CtgT>& fac) const;
+};
+
+#endif
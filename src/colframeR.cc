@@ -0,0 +1,113 @@
+// Copyright (C)  2012-2025   Mark Seligman
+//
+// This file is part of deframeR.
+//
+// deframeR is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// deframeR is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with deframeR.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+   @file colframeR.cc
+
+   @brief C++ interface to R entries for unsorted prediction frames.
+
+   @author Mark Seligman
+*/
+
+#include "colframeR.h"
+#include "rleframeR.h"
+
+
+List ColFrameR::wrapDF(const DataFrame& df, SEXP sSigTrain, SEXP sLevel) {
+  List lLevel(sLevel);
+  IntegerMatrix facVal;
+  if (!Rf_isNull(sSigTrain)) {
+    facVal = RLEFrameR::factorReconcile(df, List(sSigTrain), lLevel);
+  }
+  else {
+    facVal = IntegerMatrix(df.nrow(), lLevel.length());
+  }
+
+  // Integer-valued numeric columns are converted, with the copy
+  // retained by the wrapped list.  Double-valued columns are aliased.
+  List numVal;
+  IntegerVector facTop(lLevel.length());
+  unsigned int nFac = 0;
+  for (R_xlen_t predIdx = 0; predIdx < df.length(); predIdx++) {
+    if (Rf_isFactor(df[predIdx])) {
+      if (Rf_isNull(sSigTrain)) {
+	facVal(_, nFac) = IntegerVector(df[predIdx]);
+      }
+      facTop[nFac] = as<CharacterVector>(lLevel[nFac]).length();
+      nFac++;
+    }
+    else {
+      numVal.push_back(NumericVector(df[predIdx]));
+    }
+  }
+
+  List colFrame = List::create(
+			       _["numVal"] = numVal,
+			       _["facVal"] = facVal,
+			       _["facTop"] = facTop
+			       );
+  colFrame.attr("class") = "ColFrame";
+  return colFrame;
+}
+
+
+List ColFrameR::wrapNum(const NumericMatrix& blockNum) {
+  List colFrame = List::create(
+			       _["numVal"] = blockNum,
+			       _["facVal"] = IntegerMatrix(blockNum.nrow(), 0),
+			       _["facTop"] = IntegerVector(0)
+			       );
+  colFrame.attr("class") = "ColFrame";
+  return colFrame;
+}
+
+
+unique_ptr<ColFrame> ColFrameR::unwrap(const List& lDeframe) {
+  List colFrame((SEXP) lDeframe["colFrame"]);
+  if (!colFrame.inherits("ColFrame"))
+    stop("Expecting ColFrame");
+
+  size_t nRow = as<size_t>(lDeframe["nRow"]);
+  vector<const double*> numBase;
+  SEXP sNumVal = colFrame["numVal"];
+  if (Rf_isMatrix(sNumVal)) {
+    NumericMatrix blockNum(sNumVal);
+    for (int col = 0; col < blockNum.ncol(); col++) {
+      numBase.push_back(blockNum.begin() + col * nRow);
+    }
+  }
+  else {
+    List numVal(sNumVal);
+    for (R_xlen_t col = 0; col < numVal.length(); col++) {
+      numBase.push_back(NumericVector((SEXP) numVal[col]).begin());
+    }
+  }
+
+  // N.B.:  R factor codes are positive, save for NA, which converts to
+  // an out-of-range unsigned value and is subsequently clipped.
+  IntegerMatrix facVal((SEXP) colFrame["facVal"]);
+  IntegerVector facTop((SEXP) colFrame["facTop"]);
+  vector<const unsigned int*> facBase;
+  for (int col = 0; col < facVal.ncol(); col++) {
+    facBase.push_back(reinterpret_cast<const unsigned int*>(facVal.begin()) + col * nRow);
+  }
+
+  return make_unique<ColFrame>(nRow,
+			       std::move(numBase),
+			       std::move(facBase),
+			       vector<unsigned int>(facTop.begin(), facTop.end()));
+}
@@ -0,0 +1,80 @@
+// Copyright (C)  2012-2025  Mark Seligman
+//
+// This file is part of deframeR.
+//
+// deframeR is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// deframeR is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with deframeR.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+   @file colframeR.h
+
+   @brief C++ class definitions for managing unsorted ColFrame object.
+
+   @author Mark Seligman
+
+ */
+
+
+#ifndef DEFRAMER_COLFRAMER_H
+#define DEFRAMER_COLFRAMER_H
+
+#include <Rcpp.h>
+using namespace Rcpp;
+
+#include <vector>
+#include <memory>
+using namespace std;
+
+#include "colframe.h"
+
+
+/**
+   @brief Methods for caching and consuming unsorted frames.
+
+   Columns are retained in their front-end representation, so no
+   presorting is performed.
+ */
+struct ColFrameR {
+  /**
+     @brief Wraps the columns of a data frame.
+
+     @param df is the data frame, screened for numeric and factor types.
+
+     @param sSigTrain is the training signature, possibly null.
+
+     @param sLevel are factor levels, if any.
+
+     @return R-style list aliasing the columns.
+   */
+  static List wrapDF(const DataFrame& df,
+		     SEXP sSigTrain,
+		     SEXP sLevel);
+
+
+  /**
+     @brief Wraps a numeric matrix.
+   */
+  static List wrapNum(const NumericMatrix& blockNum);
+
+
+  /**
+     @brief Builds a core frame aliasing the wrapped columns.
+
+     @param lDeframe is a Deframe object containing a ColFrame.
+
+     @return core ColFrame, valid only while lDeframe is live.
+   */
+  static unique_ptr<ColFrame> unwrap(const List& lDeframe);
+};
+
+#endif
@@ -0,0 +1,219 @@
+// This file is part of ArboristCore.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file compacttree.cc
+
+   @brief Methods building and walking compact decision trees.
+
+   @author Mark Seligman
+ */
+
+#include "compacttree.h"
+
+// Inclusion only:
+#include "quant.h"
+
+
+const unsigned int CompactTree::bfsLevels = 3;
+
+
+/**
+   @brief Hints that a node will shortly be read.
+ */
+static inline void prefetchNode(const CompactNode* cNode) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(cNode);
+#endif
+}
+
+
+unsigned int CompactTree::predWidth(const vector<DecTree>& decTree) {
+  PredictorT predMax = 0;
+  for (const DecTree& tree : decTree) {
+    for (const DecNode& decNode : tree.getNode()) {
+      if (decNode.isNonterminal())
+	predMax = max(predMax, decNode.getPredIdx());
+    }
+  }
+
+  unsigned int width = 1;
+  while ((predMax >> width) != 0)
+    width++;
+  return width;
+}
+
+
+CompactTree::CompactTree(const DecTree& decTree,
+			 unsigned int predBits_) :
+  predBits(predBits_),
+  predMask((1u << predBits) - 1),
+  facSplit(size_t(0)),
+  facObserved(size_t(0)) {
+  const vector<DecNode>& decNode = decTree.getNode();
+  if (decNode.empty() || predBits >= 30)
+    return;
+
+  position = layout(decTree);
+  uint32_t offsetMax = CompactNode::fieldMask >> predBits;
+  node = vector<CompactNode>(decNode.size());
+  decIdx = vector<IndexT>(decNode.size());
+  splitScore = vector<double>(decNode.size() / 2);
+  for (IndexT nodeIdx = 0; nodeIdx != decNode.size(); nodeIdx++) {
+    IndexT pos = position[nodeIdx];
+    CompactNode& cNode = node[pos];
+    decIdx[pos] = nodeIdx;
+    const DecNode& dNode = decNode[nodeIdx];
+    if (dNode.isTerminal()) {
+      cNode.header = CompactNode::terminalBit | dNode.getLeafIdx();
+      cNode.setVal(decTree.getScore(nodeIdx));
+    }
+    else {
+      IndexT offset = position[dNode.getIdTrue(nodeIdx)] - pos;
+      if (offset > offsetMax) { // Header overflow:  walk DecTree instead.
+	node.clear();
+	decIdx.clear();
+	position.clear();
+	splitScore.clear();
+	return;
+      }
+      cNode.header = (offset << predBits) | dNode.getPredIdx();
+      if (dNode.getInvert()) // Consulted by numeric splits only.
+	cNode.header |= CompactNode::invertBit;
+      cNode.setVal(dNode.getSplitNum());
+      splitScore[pairIdx(pos)] = decTree.getScore(nodeIdx);
+    }
+  }
+  facSplit = decTree.getFacSplit();
+  facObserved = decTree.getFacObserved();
+}
+
+
+DecTree CompactTree::expand() const {
+  vector<DecNode> decNode(node.size());
+  vector<double> nodeScore(node.size());
+  for (IndexT pos = 0; pos != node.size(); pos++) {
+    IndexT nodeIdx = decIdx[pos];
+    DecNode& dNode = decNode[nodeIdx];
+    const CompactNode& cNode = node[pos];
+    if (isTerminal(pos)) {
+      dNode.setLeaf(cNode.header & ~CompactNode::terminalBit);
+      nodeScore[nodeIdx] = cNode.getVal();
+    }
+    else {
+      dNode.critCut(cNode.header & predMask, cNode.getVal());
+      dNode.setDelIdx(decIdx[posTrue(pos)] - nodeIdx);
+      dNode.setInvert((cNode.header & CompactNode::invertBit) != 0);
+      nodeScore[nodeIdx] = splitScore[pairIdx(pos)];
+    }
+  }
+  return DecTree(decNode, facSplit, facObserved, nodeScore);
+}
+
+
+vector<IndexT> CompactTree::layout(const DecTree& decTree) {
+  const vector<DecNode>& decNode = decTree.getNode();
+  vector<IndexT> position(decNode.size());
+  IndexT posNext = 1; // Root at position zero.
+
+  // Breadth-first:  children of each node at a given level are
+  // allocated as a pair, in level order.
+  vector<IndexT> frontier;
+  frontier.push_back(0);
+  for (unsigned int level = 1; level < bfsLevels; level++) {
+    vector<IndexT> frontierNext;
+    for (IndexT nodeIdx : frontier) {
+      if (decNode[nodeIdx].isNonterminal()) {
+	IndexT idTrue = decNode[nodeIdx].getIdTrue(nodeIdx);
+	position[idTrue] = posNext++;
+	position[idTrue + 1] = posNext++;
+	frontierNext.push_back(idTrue);
+	frontierNext.push_back(idTrue + 1);
+      }
+    }
+    frontier = std::move(frontierNext);
+  }
+
+  // Depth-first below the frontier, true branch first.
+  for (IndexT subRoot : frontier) {
+    vector<IndexT> stack;
+    stack.push_back(subRoot);
+    while (!stack.empty()) {
+      IndexT nodeIdx = stack.back();
+      stack.pop_back();
+      if (decNode[nodeIdx].isNonterminal()) {
+	IndexT idTrue = decNode[nodeIdx].getIdTrue(nodeIdx);
+	position[idTrue] = posNext++;
+	position[idTrue + 1] = posNext++;
+	stack.push_back(idTrue + 1);
+	stack.push_back(idTrue);
+      }
+    }
+  }
+
+  return position;
+}
+
+
+IndexT CompactTree::walkRow(const double num[],
+			    const CtgT fac[],
+			    PredictorT nPredNum,
+			    bool trapUnobserved,
+			    IndexT idx) const {
+  IndexT pos = position[idx];
+  while (!isTerminal(pos)) {
+    const CompactNode& cNode = node[pos];
+    PredictorT predIdx = cNode.header & predMask;
+    bool trueBranch;
+    if (predIdx >= nPredNum) {
+      size_t bitOffset = static_cast<size_t>(cNode.getVal()) + fac[predIdx - nPredNum];
+      if (trapUnobserved && !facObserved.testBit(bitOffset))
+	break;
+      trueBranch = facSplit.testBit(bitOffset);
+    }
+    else {
+      double val = num[predIdx];
+      if (isnan(val)) {
+	if (trapUnobserved)
+	  break;
+	trueBranch = (cNode.header & CompactNode::invertBit) != 0;
+      }
+      else {
+	trueBranch = val <= cNode.getVal();
+      }
+    }
+    pos = posTrue(pos) + (trueBranch ? 0 : 1);
+  }
+  return decIdx[pos];
+}
+
+
+void CompactTree::walkLanes(const PredictFrame* frame,
+			    bool trapUnobserved,
+			    const size_t obsIdx[],
+			    unsigned int nLane,
+			    IndexT finalIdx[]) const {
+  IndexT pos[DecTree::nLaneMax];
+  unsigned int live[DecTree::nLaneMax];
+  for (unsigned int lane = 0; lane != nLane; lane++) {
+    pos[lane] = 0;
+    live[lane] = lane;
+  }
+
+  unsigned int nLive = nLane;
+  while (nLive != 0) {
+    unsigned int nNext = 0;
+    for (unsigned int liveIdx = 0; liveIdx != nLive; liveIdx++) {
+      unsigned int lane = live[liveIdx];
+      if (advance(frame, trapUnobserved, obsIdx[lane], pos[lane], finalIdx[lane])) {
+	prefetchNode(&node[pos[lane]]);
+	live[nNext++] = lane;
+      }
+    }
+    nLive = nNext;
+  }
+}
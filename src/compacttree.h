@@ -0,0 +1,278 @@
+// This file is part of ArboristCore.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file compacttree.h
+
+   @brief Compact inference representation of a decision tree.
+
+   @author Mark Seligman
+ */
+
+#ifndef FOREST_COMPACTTREE_H
+#define FOREST_COMPACTTREE_H
+
+#include "typeparam.h"
+#include "predictframe.h"
+#include "dectree.h"
+
+#include <vector>
+#include <cstring>
+#include <cmath>
+
+
+/**
+   @brief Twelve-byte node, four-byte aligned.
+
+   A 32-bit header packs the node's flags, splitting predictor and
+   offset to its children, which are stored as an adjacent pair.  The
+   trailing eight bytes hold the splitting criterion, as encoded by
+   Crit, or, for terminals, the score.  Terminal headers instead
+   record the node's leaf index.
+ */
+struct CompactNode {
+  static const uint32_t terminalBit = 1u << 31;
+  static const uint32_t invertBit = 1u << 30; ///< Missing takes true branch.
+  static const uint32_t fieldMask = invertBit - 1;
+
+  uint32_t header;
+  uint32_t payload[2]; ///< Avoids eight-byte alignment.
+
+  double getVal() const {
+    double val;
+    memcpy(&val, payload, sizeof(val));
+    return val;
+  }
+
+
+  void setVal(double val) {
+    memcpy(payload, &val, sizeof(val));
+  }
+};
+
+
+/**
+   @brief Flat encoding of a DecTree, laid out for walking.
+
+   The top levels are stored breadth-first, so that the nodes visited
+   by every walk share cache lines.  Each remaining subtree is stored
+   depth-first, beginning with its root's children.  Trees whose
+   offsets do not fit the header are left empty and walked as DecTrees.
+
+   Walks report DecTree indices, which remain the external naming of
+   nodes.  The DecTree itself need not be retained, as it can be
+   recovered from the encoding.
+ */
+class CompactTree {
+  static const unsigned int bfsLevels; ///< # levels stored breadth-first.
+
+  unsigned int predBits; ///< Header bits encoding predictor.
+  uint32_t predMask;
+  vector<CompactNode> node;
+  vector<IndexT> decIdx; ///< DecTree index of node, by position.
+  vector<IndexT> position; ///< Position of node, by DecTree index.
+  vector<double> splitScore; ///< Nonterminal score, by child pair.
+  BV facSplit; ///< Categories splitting node.
+  BV facObserved; ///< Categories observed at node.
+
+
+  bool isTerminal(IndexT pos) const {
+    return (node[pos].header & CompactNode::terminalBit) != 0;
+  }
+
+
+  /**
+     @return position of the true branch of a nonterminal.
+   */
+  IndexT posTrue(IndexT pos) const {
+    return pos + ((node[pos].header & CompactNode::fieldMask) >> predBits);
+  }
+
+
+  /**
+     @brief Children are allocated as adjacent pairs from position one,
+     so a nonterminal is named by the ordinal of its pair.
+
+     @return ordinal of a nonterminal's child pair.
+   */
+  IndexT pairIdx(IndexT pos) const {
+    return (posTrue(pos) - 1) / 2;
+  }
+
+  /**
+     @brief Assigns compact positions to the nodes of a DecTree.
+
+     @return per-node position, indexed by DecTree position.
+   */
+  static vector<IndexT> layout(const DecTree& decTree);
+
+public:
+
+  /**
+     @param predBits_ is the width of the widest predictor index.
+   */
+  CompactTree(const DecTree& decTree,
+	      unsigned int predBits_);
+
+
+  /**
+     @brief Determines bit width of the highest predictor index split.
+   */
+  static unsigned int predWidth(const vector<DecTree>& decTree);
+
+
+  bool isEmpty() const {
+    return node.empty();
+  }
+
+
+  size_t getNodeBytes() const {
+    return node.size() * sizeof(CompactNode);
+  }
+
+
+  size_t nodeCount() const {
+    return node.size();
+  }
+
+
+  /**
+     @brief Recovers the DecTree encoded.
+
+     Terminals are recovered without splitting predictor or inversion
+     sense, neither of which is consulted.
+   */
+  DecTree expand() const;
+
+
+  /**
+     @return true iff node is terminal, in which case outputs leaf index.
+   */
+  bool getLeafIdx(IndexT nodeIdx,
+		  IndexT& leafIdx) const {
+    const CompactNode& cNode = node[position[nodeIdx]];
+    if ((cNode.header & CompactNode::terminalBit) != 0) {
+      leafIdx = cNode.header & ~CompactNode::terminalBit;
+      return true;
+    }
+    return false;
+  }
+
+
+  /**
+     @brief Reads terminal scores in place.
+   */
+  double getScore(IndexT nodeIdx) const {
+    IndexT pos = position[nodeIdx];
+    return isTerminal(pos) ? node[pos].getVal() : splitScore[pairIdx(pos)];
+  }
+
+
+  /**
+     @return offset of true branch, as DecTree indices, else zero iff terminal.
+   */
+  IndexT getDelIdx(IndexT nodeIdx) const {
+    IndexT pos = position[nodeIdx];
+    return isTerminal(pos) ? 0 : decIdx[posTrue(pos)] - nodeIdx;
+  }
+
+
+  /**
+     @return splitting predictor of a nonterminal.
+   */
+  PredictorT getPredIdx(IndexT nodeIdx) const {
+    return node[position[nodeIdx]].header & predMask;
+  }
+
+
+  /**
+     @brief Advances a walk by one node.
+
+     @param[in, out] pos is the current position, updated on advance.
+
+     @param[out] finalIdx outputs DecTree index iff walk has exited.
+
+     @return true iff walk continues.
+   */
+  bool advance(const PredictFrame* frame,
+	       bool trapUnobserved,
+	       size_t obsIdx,
+	       IndexT& pos,
+	       IndexT& finalIdx) const {
+    const CompactNode& cNode = node[pos];
+    uint32_t header = cNode.header;
+    if ((header & CompactNode::terminalBit) != 0) {
+      finalIdx = decIdx[pos];
+      return false;
+    }
+
+    bool isFactor;
+    IndexT blockIdx = frame->getIdx(header & predMask, isFactor);
+    bool trueBranch;
+    if (isFactor) {
+      size_t bitOffset = frame->baseFac(obsIdx)[blockIdx] + static_cast<size_t>(cNode.getVal());
+      if (trapUnobserved && !facObserved.testBit(bitOffset)) {
+	finalIdx = decIdx[pos];
+	return false;
+      }
+      trueBranch = facSplit.testBit(bitOffset);
+    }
+    else {
+      double val = frame->baseNum(obsIdx)[blockIdx];
+      if (isnan(val)) {
+	if (trapUnobserved) {
+	  finalIdx = decIdx[pos];
+	  return false;
+	}
+	trueBranch = (header & CompactNode::invertBit) != 0;
+      }
+      else {
+	trueBranch = val <= cNode.getVal();
+      }
+    }
+    pos += ((header & CompactNode::fieldMask) >> predBits) + (trueBranch ? 0 : 1);
+    return true;
+  }
+
+
+  /**
+     @brief Walks an observation to exit.
+
+     @return DecTree index of the final node.
+   */
+  IndexT walkObs(const PredictFrame* frame,
+		 bool trapUnobserved,
+		 size_t obsIdx) const {
+    IndexT pos = 0;
+    IndexT finalIdx;
+    while (advance(frame, trapUnobserved, obsIdx, pos, finalIdx)) {
+    }
+    return finalIdx;
+  }
+
+
+  /**
+     @brief As DecTree::walkRow(), but on the compact layout.
+   */
+  IndexT walkRow(const double num[],
+		 const CtgT fac[],
+		 PredictorT nPredNum,
+		 bool trapUnobserved,
+		 IndexT idx) const;
+
+
+  /**
+     @brief As DecTree::walkLanes(), but on the compact layout.
+   */
+  void walkLanes(const PredictFrame* frame,
+		 bool trapUnobserved,
+		 const size_t obsIdx[],
+		 unsigned int nLane,
+		 IndexT finalIdx[]) const;
+};
+
+#endif
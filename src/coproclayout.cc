@@ -20,6 +20,7 @@
 PredictorFrame *PredictorFrame::Factory(unique_ptr<RLEFrame> rleFrame,
 			const Coproc *coproc,
 			double autoCompress,
+			IndexT nBin,
 			vector<string>& diag) {
-  return new PredictorFrame(std::move(rleFrame), autoCompress, true, diag);
+  return new PredictorFrame(std::move(rleFrame), autoCompress, nBin, true, diag);
 }
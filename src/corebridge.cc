@@ -12,6 +12,11 @@ unsigned int CoreBridge::setNThread(unsigned int nThread) {
 }
 
 
+void CoreBridge::seed() {
+  FECore::seed();
+}
+
+
 void CoreBridge::deInit() {
   FECore::deInit();
 }
@@ -38,6 +38,12 @@ struct CoreBridge {
   static unsigned int setNThread(unsigned int nThread);
 
 
+  /**
+     @brief Seeds the core PRNG from the front end's session.
+   */
+  static void seed();
+
+
   static void deInit();
 };
 
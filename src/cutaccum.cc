@@ -22,15 +22,40 @@
 
 #include <numeric>
 
+IndexT CutAccum::approxNode = 0;
+
+
 CutAccum::CutAccum(const SplitNux& cand,
 		   const SplitFrontier* splitFrontier) :
   Accum(splitFrontier, cand),
+  cutStride(stride(obsEnd - obsStart)),
+  obsLeft(-1),
+  obsRight(-1),
+  residualLeft(false) {
+}
+
+
+CutAccum::CutAccum(const Obs* obsCell,
+		   IndexT nObs,
+		   const SumCount& scTot) :
+  Accum(obsCell, nObs, scTot),
+  cutStride(stride(nObs)),
   obsLeft(-1),
   obsRight(-1),
   residualLeft(false) {
 }
 
 
+void CutAccum::immutables(IndexT approxNode) {
+  CutAccum::approxNode = approxNode;
+}
+
+
+void CutAccum::deInit() {
+  approxNode = 0;
+}
+
+
 IndexT CutAccum::lhImplicit(const SplitNux& cand) const {
   IndexT implicitCand = cand.getImplicitCount();
   if (implicitCand == 0) // cutResidual set to 0 otherwise.
@@ -61,6 +86,22 @@ double CutAccum::interpolateRank(const InterLevel* interLevel,
 }
 
 
+IndexT CutAccum::untiedCut(IndexT idxCut) const {
+  if (idxCut == obsEnd)
+    return obsEnd;
+
+  for (IndexT idx = idxCut; idx > obsStart; idx--) {
+    if (!obsCell[idx].isTied())
+      return idx;
+  }
+  for (IndexT idx = idxCut + 1; idx < obsEnd; idx++) {
+    if (!obsCell[idx].isTied())
+      return idx;
+  }
+  return obsEnd;
+}
+
+
 CutAccumReg::CutAccumReg(const SplitNux& cand,
 			 const SFReg* sfReg) :
   CutAccum(cand, sfReg),
@@ -68,6 +109,15 @@ CutAccumReg::CutAccumReg(const SplitNux& cand,
 }
 
 
+CutAccumReg::CutAccumReg(const Obs* obsCell,
+			 IndexT nObs,
+			 const SumCount& scTot,
+			 int monoMode_) :
+  CutAccum(obsCell, nObs, scTot),
+  monoMode(monoMode_) {
+}
+
+
 void CutAccum::applyResidual(const Obs* obsCell) {
   double ySumExpl = 0.0;
   IndexT sCountExpl = 0;
@@ -95,6 +145,18 @@ CutAccumCtg::CutAccumCtg(const SplitNux& cand,
 }
 
 
+CutAccumCtg::CutAccumCtg(const Obs* obsCell,
+			 IndexT nObs,
+			 const SumCount& scTot,
+			 const CtgNux& ctgNux_) :
+  CutAccum(obsCell, nObs, scTot),
+  ctgNux(ctgNux_),
+  ctgAccum(vector<double>(ctgNux.nCtg())),
+  ssL(ctgNux.sumSquares),
+  ssR(0.0) {
+}
+
+
 void CutAccumCtg::applyResidual(const Obs* obsCell) {
   vector<double> ctgExpl(ctgAccum.size());
   double ySumExpl = 0.0;
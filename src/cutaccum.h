@@ -29,7 +29,19 @@
    Accum is tailored for right-to-left index traversal.
  */
 class CutAccum : public Accum {
+  static IndexT approxNode; ///< Cell size above which cuts are sketched.
+
+
+  /**
+     @return spacing of trial cuts over a cell of given extent.
+   */
+  static IndexT stride(IndexT extent) {
+    return approxNode == 0 || extent <= approxNode ? 1 : (extent + approxNode - 1) / approxNode;
+  }
+
 protected:
+  const IndexT cutStride; ///< Minimal spacing of trial cuts:  unity iff exact.
+
 
   /**
      @brief As above, but directionless.
@@ -62,6 +74,17 @@ protected:
   void applyResidual(const Obs* obsCell);
 
 
+  /**
+     @brief Moves a cut to the nearest untied position, preferring
+     positions to the left.
+
+     @param idxCut is the leftmost position right of the cut.
+
+     @return nearest untied position, else obsEnd.
+   */
+  IndexT untiedCut(IndexT idxCut) const;
+
+
   /**
      @brief Revises argmax in right-to-left traversal.
    */
@@ -84,6 +107,27 @@ public:
   CutAccum(const class SplitNux& cand,
 	   const class SplitFrontier* splitFrontier);
 
+
+  /**
+     @brief As above, but over a local workspace of explicit observations.
+   */
+  CutAccum(const Obs* obsCell,
+	   IndexT nObs,
+	   const SumCount& scTot);
+
+
+  /**
+     @brief Registers the approximation threshold.
+
+     @param approxNode is the explicit observation count above which
+     cuts are sketched from roughly this many sampled observations,
+     if nonzero.
+   */
+  static void immutables(IndexT approxNode);
+
+
+  static void deInit();
+
   
   IndexT lhImplicit(const class SplitNux& cand) const;
 
@@ -185,6 +229,17 @@ public:
 	      class SFCtg* sfCtg);
 
 
+  /**
+     @brief As above, but over a local workspace.
+
+     @param ctgNux_ summarizes the workspace by category.
+   */
+  CutAccumCtg(const Obs* obsCell,
+	      IndexT nObs,
+	      const SumCount& scTot,
+	      const CtgNux& ctgNux_);
+
+
   /**
      @brief Updtes category sum and squared sums.
 
@@ -211,13 +266,16 @@ protected:
      @return false iff monotone and sense violated.
    */
   bool senseMonotone() const {
-    if (monoMode == 0)
-      return true;
+    return senseMonotone(sum, sCount);
+  }
+
 
-    IndexT sCountR = sumCount.sCount - sCount;
-    double sumR = sumCount.sum - sum;
-    bool accumNonDecreasing = (sum * sCountR <= sumR * sCount);
-    return monoMode > 0 ? accumNonDecreasing : !accumNonDecreasing;
+  /**
+     @brief As above, but with explicit left-hand accumulations.
+   */
+  bool senseMonotone(double sumL,
+		     IndexT sCountL) const {
+    return Accum::senseMonotone(monoMode, sumL, sCountL, sumCount);
   }
 
     /**
@@ -264,6 +322,17 @@ protected:
 public:
   CutAccumReg(const class SplitNux& splitCand,
 	      const struct SFReg* spReg);
+
+
+  /**
+     @brief As above, but over a local workspace.
+
+     @param monoMode_ is the monotone constraint drawn for the predictor.
+   */
+  CutAccumReg(const Obs* obsCell,
+	      IndexT nObs,
+	      const SumCount& scTot,
+	      int monoMode_);
 };
 
 
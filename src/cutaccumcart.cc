@@ -26,6 +26,15 @@ CutAccumRegCart::CutAccumRegCart(const SplitNux& cand,
 }
 
 
+CutAccumRegCart::CutAccumRegCart(const Obs* obsCell,
+				 IndexT nObs,
+				 const SumCount& scTot,
+				 int monoMode) :
+  CutAccumReg(obsCell, nObs, scTot, monoMode) {
+  info = (sum * sum) / sCount;
+}
+
+
 void CutAccumRegCart::split(const SFRegCart* spReg,
 			    SplitNux& cand) {
   CutAccumRegCart cutAccum(cand, spReg);
@@ -34,6 +43,19 @@ void CutAccumRegCart::split(const SFRegCart* spReg,
 }
 
 
+double CutAccumRegCart::splitObs(const Obs obsCell[],
+				 IndexT nObs,
+				 const SumCount& scTot,
+				 int monoMode,
+				 IndexT& obsLeft) {
+  CutAccumRegCart cutAccum(obsCell, nObs, scTot, monoMode);
+  double infoCell = cutAccum.info;
+  cutAccum.splitExplicit();
+  obsLeft = cutAccum.hasArgmax() ? cutAccum.obsLeft : nObs;
+  return cutAccum.info - infoCell;
+}
+
+
 double CutAccumRegCart::splitReg(const SFRegCart* spReg,
 				 const SplitNux& cand) {
   double infoCell = info;
@@ -41,20 +63,110 @@ double CutAccumRegCart::splitReg(const SFRegCart* spReg,
     splitImpl();
   }
   else {
-    splitRL(obsStart, obsEnd);
+    splitExplicit();
   }
   return info - infoCell;
 }
 
 
+void CutAccumRegCart::splitExplicit() {
+  if (cutStride > 1) {
+    sketchRL();
+  }
+  else {
+    splitRL(obsStart, obsEnd);
+  }
+}
+
+
 void CutAccumRegCart::splitRL(IndexT idxStart, IndexT idxEnd) {
-  for (IndexT idx = idxEnd - 1; idx != idxStart; idx--) {
-    if (!accumulateReg(obsCell[idx])) {
-      argmaxRL(infoVar(), idx-1);
+  for (IndexT idxTop = idxEnd - 1; idxTop > idxStart; ) {
+    IndexT width = min(stripeWidth, idxTop - idxStart);
+    stripeRL(idxTop, width);
+    idxTop -= width;
+  }
+}
+
+
+void CutAccumRegCart::stripeRL(IndexT idxTop, IndexT width) {
+  for (IndexT pos = 0; pos != width; pos++) {
+    untied[pos] = !accumulateReg(obsCell[idxTop - pos]);
+    sumLeft[pos] = sum;
+    sCountLeft[pos] = sCount;
+  }
+
+  infoVarStripe(sumLeft, sCountLeft, sumCount.sum, sumCount.sCount, width, infoStripe);
+
+  // Visits in accumulation order, so that ties in information resolve
+  // as in a scalar walk.
+  for (IndexT pos = 0; pos != width; pos++) {
+    if (untied[pos] && senseMonotone(sumLeft[pos], sCountLeft[pos]) && trialSplit(infoStripe[pos])) {
+      obsLeft = idxTop - pos - 1;
+      obsRight = idxTop - pos;
     }
   }
 }
 
+void CutAccumRegCart::sketchRL() {
+  // One observation is sampled from each stratum of 'cutStride'
+  // positions, the lowest stratum possibly short, and the sample is
+  // itself split between strata.
+  IndexT half = cutStride / 2;
+  IndexT idxFloor = obsEnd - ((obsEnd - obsStart - 1) / cutStride) * cutStride;
+  const Obs& obsFloor = obsCell[obsStart + (idxFloor - obsStart) / 2];
+  SumCount scSample(obsFloor.getYSum(), obsFloor.getSCount());
+  for (IndexT idxCut = idxFloor; idxCut != obsEnd; idxCut += cutStride) {
+    scSample.sum += obsCell[idxCut + half].getYSum();
+    scSample.sCount += obsCell[idxCut + half].getSCount();
+  }
+
+  double sumRight = 0.0;
+  IndexT sCountRight = 0;
+  IndexT idxSketch = obsEnd; // Sample argmax cut, if any.
+  double infoSketch = 0.0;
+  for (IndexT idxCut = obsEnd; idxCut != idxFloor; ) {
+    IndexT idxStripe = idxCut;
+    IndexT width = 0;
+    for (; width != stripeWidth && idxCut != idxFloor; width++) {
+      idxCut -= cutStride;
+      const Obs& obs = obsCell[idxCut + half];
+      sumRight += obs.getYSum();
+      sCountRight += obs.getSCount();
+      sumLeft[width] = scSample.sum - sumRight;
+      sCountLeft[width] = scSample.sCount - sCountRight;
+    }
+
+    infoVarStripe(sumLeft, sCountLeft, scSample.sum, scSample.sCount, width, infoStripe);
+    for (IndexT pos = 0; pos != width; pos++) {
+      if (infoStripe[pos] > infoSketch && Accum::senseMonotone(monoMode, sumLeft[pos], sCountLeft[pos], scSample)) {
+	infoSketch = infoStripe[pos];
+	idxSketch = idxStripe - (pos + 1) * cutStride;
+      }
+    }
+  }
+
+  IndexT idxCut = untiedCut(idxSketch);
+  if (idxCut == obsEnd)
+    return;
+
+  // Confirms the sketched cut by an exact pass over its shorter side.
+  if (idxCut - obsStart < obsEnd - idxCut) {
+    sum = 0.0;
+    sCount = 0;
+    for (IndexT idx = obsStart; idx != idxCut; idx++) {
+      sum += obsCell[idx].getYSum();
+      sCount += obsCell[idx].getSCount();
+    }
+  }
+  else {
+    for (IndexT idx = idxCut; idx != obsEnd; idx++) {
+      (void) accumulateReg(obsCell[idx]);
+    }
+  }
+  argmaxRL(infoVar(), idxCut - 1);
+}
+
+
 void CutAccumRegCart::splitImpl() {
   if (cutResidual < obsEnd) {
     // Tries obsEnd/obsEnd-1, ..., cut+1/cut.
@@ -97,6 +209,15 @@ CutAccumCtgCart::CutAccumCtgCart(const SplitNux& cand,
 }
 
 
+CutAccumCtgCart::CutAccumCtgCart(const Obs* obsCell,
+				 IndexT nObs,
+				 const SumCount& scTot,
+				 const CtgNux& ctgNux) :
+  CutAccumCtg(obsCell, nObs, scTot, ctgNux) {
+  info = ssL / sum;
+}
+
+
 void CutAccumCtgCart::split(SFCtgCart* spCtg,
 			    SplitNux& cand) {
   CutAccumCtgCart cutAccum(cand, spCtg);
@@ -105,6 +226,19 @@ void CutAccumCtgCart::split(SFCtgCart* spCtg,
 }
 
 
+double CutAccumCtgCart::splitObs(const Obs obsCell[],
+				 IndexT nObs,
+				 const SumCount& scTot,
+				 const CtgNux& ctgNux,
+				 IndexT& obsLeft) {
+  CutAccumCtgCart cutAccum(obsCell, nObs, scTot, ctgNux);
+  double infoCell = cutAccum.info;
+  cutAccum.splitExplicit();
+  obsLeft = cutAccum.hasArgmax() ? cutAccum.obsLeft : nObs;
+  return cutAccum.info - infoCell;
+}
+
+
 // Initializes from final index and loops over remaining indices.
 double CutAccumCtgCart::splitCtg(const SFCtgCart* spCtg,
 				 const SplitNux& cand) {
@@ -113,18 +247,125 @@ double CutAccumCtgCart::splitCtg(const SFCtgCart* spCtg,
     splitImpl();
   }
   else {
-    splitRL(obsStart, obsEnd);
+    splitExplicit();
   }
   return info - infoCell;
 }
 
 
+void CutAccumCtgCart::splitExplicit() {
+  if (cutStride > 1) {
+    sketchRL();
+  }
+  else {
+    splitRL(obsStart, obsEnd);
+  }
+}
+
+
 void CutAccumCtgCart::splitRL(IndexT idxStart, IndexT idxEnd) {
-  for (IndexT idx = idxEnd - 1; idx != idxStart; idx--) {
-    if (!accumulateCtg(obsCell[idx])) {
-      argmaxRL(infoGini(), idx-1);
+  for (IndexT idxTop = idxEnd - 1; idxTop > idxStart; ) {
+    IndexT width = min(stripeWidth, idxTop - idxStart);
+    stripeRL(idxTop, width);
+    idxTop -= width;
+  }
+}
+
+
+void CutAccumCtgCart::stripeRL(IndexT idxTop, IndexT width) {
+  for (IndexT pos = 0; pos != width; pos++) {
+    untied[pos] = !accumulateCtg(obsCell[idxTop - pos]);
+    ssLeft[pos] = ssL;
+    ssRight[pos] = ssR;
+    sumLeft[pos] = sum;
+  }
+
+  infoGiniStripe(ssLeft, ssRight, sumLeft, sumCount.sum, width, infoStripe);
+
+  for (IndexT pos = 0; pos != width; pos++) {
+    if (untied[pos])
+      argmaxRL(infoStripe[pos], idxTop - pos - 1);
+  }
+}
+
+
+void CutAccumCtgCart::sketchRL() {
+  IndexT half = cutStride / 2;
+  IndexT idxFloor = obsEnd - ((obsEnd - obsStart - 1) / cutStride) * cutStride;
+  vector<double> ctgSample(ctgAccum.size());
+  const Obs& obsFloor = obsCell[obsStart + (idxFloor - obsStart) / 2];
+  ctgSample[obsFloor.getCtg()] = obsFloor.getYSum();
+  double sumSample = obsFloor.getYSum();
+  for (IndexT idxCut = idxFloor; idxCut != obsEnd; idxCut += cutStride) {
+    const Obs& obs = obsCell[idxCut + half];
+    ctgSample[obs.getCtg()] += obs.getYSum();
+    sumSample += obs.getYSum();
+  }
+
+  vector<double> ctgRight(ctgAccum.size());
+  double ssRightSample = 0.0;
+  double ssLeftSample = 0.0;
+  for (double sumCtg : ctgSample) {
+    ssLeftSample += sumCtg * sumCtg;
+  }
+  double sumRight = 0.0;
+  IndexT idxSketch = obsEnd;
+  double infoSketch = 0.0;
+  for (IndexT idxCut = obsEnd; idxCut != idxFloor; ) {
+    IndexT idxStripe = idxCut;
+    IndexT width = 0;
+    for (; width != stripeWidth && idxCut != idxFloor; width++) {
+      idxCut -= cutStride;
+      const Obs& obs = obsCell[idxCut + half];
+      double ySum = obs.getYSum();
+      PredictorT ctg = obs.getCtg();
+      ssRightSample += ySum * ySum + 2.0 * ySum * ctgRight[ctg];
+      ssLeftSample += ySum * ySum - 2.0 * ySum * (ctgSample[ctg] - ctgRight[ctg]);
+      ctgRight[ctg] += ySum;
+      sumRight += ySum;
+      ssLeft[width] = ssLeftSample;
+      ssRight[width] = ssRightSample;
+      sumLeft[width] = sumSample - sumRight;
+    }
+
+    infoGiniStripe(ssLeft, ssRight, sumLeft, sumSample, width, infoStripe);
+    for (IndexT pos = 0; pos != width; pos++) {
+      if (infoStripe[pos] > infoSketch) {
+	infoSketch = infoStripe[pos];
+	idxSketch = idxStripe - (pos + 1) * cutStride;
+      }
+    }
+  }
+
+  IndexT idxCut = untiedCut(idxSketch);
+  if (idxCut == obsEnd)
+    return;
+
+  // Confirms the sketched cut by an exact pass over its shorter side.
+  if (idxCut - obsStart < obsEnd - idxCut) {
+    vector<double> ctgLeft(ctgAccum.size());
+    sum = 0.0;
+    sCount = 0;
+    for (IndexT idx = obsStart; idx != idxCut; idx++) {
+      const Obs& obs = obsCell[idx];
+      ctgLeft[obs.getCtg()] += obs.getYSum();
+      sum += obs.getYSum();
+      sCount += obs.getSCount();
+    }
+    ssL = 0.0;
+    ssR = 0.0;
+    for (PredictorT ctg = 0; ctg != ctgAccum.size(); ctg++) {
+      ctgAccum[ctg] = ctgNux.ctgSum[ctg] - ctgLeft[ctg];
+      ssL += ctgLeft[ctg] * ctgLeft[ctg];
+      ssR += ctgAccum[ctg] * ctgAccum[ctg];
+    }
+  }
+  else {
+    for (IndexT idx = idxCut; idx != obsEnd; idx++) {
+      (void) accumulateCtg(obsCell[idx]);
     }
   }
+  argmaxRL(infoGini(), idxCut - 1);
 }
 
 
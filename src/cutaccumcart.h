@@ -26,6 +26,11 @@
    @brief Auxiliary workspace information specific to regression.
  */
 class CutAccumRegCart : public CutAccumReg {
+  // Stripe workspace, indexed by distance from the stripe's top.
+  double sumLeft[stripeWidth];
+  double sCountLeft[stripeWidth];
+  bool untied[stripeWidth];
+  double infoStripe[stripeWidth];
 
   /**
      @brief Updates with residual and possibly splits.
@@ -49,12 +54,35 @@ public:
 		  const struct SFRegCart* spReg);
 
 
+  CutAccumRegCart(const Obs* obsCell,
+		  IndexT nObs,
+		  const SumCount& scTot,
+		  int monoMode);
+
+
   /**
      @brief Static entry for regression splitting.
    */
   static void split(const struct SFRegCart* spReg,
 		    class SplitNux& cand);
 
+
+  /**
+     @brief Static entry for splitting a local workspace, as by a finisher.
+
+     @param obsCell are explicit observations, in rank order.
+
+     @param[out] obsLeft outputs the left index of the argmax cut, if
+     any, else nObs.
+
+     @return information gain.
+   */
+  static double splitObs(const Obs obsCell[],
+			 IndexT nObs,
+			 const SumCount& scTot,
+			 int monoMode,
+			 IndexT& obsLeft);
+
   
   /**
      @brief Private regresion splitting method.
@@ -81,6 +109,35 @@ public:
 	       IndexT idxEnd);
 
 
+  /**
+     @brief Accumulates a stripe of observations right to left, then
+     evaluates and tests all untied positions at once.
+
+     @param idxTop is the rightmost index of the stripe.
+
+     @param width is the number of observations in the stripe.
+   */
+  void stripeRL(IndexT idxTop,
+		IndexT width);
+
+
+  /**
+     @brief Splits a cell having no implicit observations, sketching
+     if the cell is large enough to approximate.
+   */
+  void splitExplicit();
+
+
+  /**
+     @brief Estimates the argmax over cuts spaced by stride, from one
+     sampled observation per stratum, then evaluates that cut exactly.
+
+     Only the sample and the shorter side of the chosen cut are
+     visited.
+   */
+  void sketchRL();
+
+
   /**
      @brief Splits a range bounded to the right by a residual.
    */
@@ -92,6 +149,12 @@ public:
    @brief Splitting accumulator for classification.
  */
 class CutAccumCtgCart : public CutAccumCtg {
+  // Stripe workspace, as with regression.
+  double ssLeft[stripeWidth];
+  double ssRight[stripeWidth];
+  double sumLeft[stripeWidth];
+  bool untied[stripeWidth];
+  double infoStripe[stripeWidth];
 
   /**
      @brief Attempts to split at residual.
@@ -122,11 +185,27 @@ public:
 		  class SFCtgCart* spCtg);
 
 
+  CutAccumCtgCart(const Obs* obsCell,
+		  IndexT nObs,
+		  const SumCount& scTot,
+		  const CtgNux& ctgNux);
+
+
   /**
      @brief Static entry for classification splitting.
    */
   static void split(class SFCtgCart* spCtg,
 		    class SplitNux& cand);
+
+
+  /**
+     @brief As with regression, splits a local workspace.
+   */
+  static double splitObs(const Obs obsCell[],
+			 IndexT nObs,
+			 const SumCount& scTot,
+			 const CtgNux& ctgNux,
+			 IndexT& obsLeft);
   
 
   /**
@@ -149,6 +228,25 @@ public:
 	       IndexT idxEnd);
 
 
+  /**
+     @brief As with regression, accumulates and evaluates by stripe.
+   */
+  void stripeRL(IndexT idxTop,
+		IndexT width);
+
+
+  /**
+     @brief As with regression.
+   */
+  void splitExplicit();
+
+
+  /**
+     @brief As with regression, sketches per-category sums.
+   */
+  void sketchRL();
+
+
   /**
      @brief As above, but with implicit dense blob.
    */
@@ -29,6 +29,70 @@ DecTree::DecTree(const vector<DecNode>& decNode_,
 }
 
 
+/**
+   @brief Hints that a node will shortly be read.
+ */
+static inline void prefetchNode(const DecNode* node) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(node);
+#endif
+}
+
+
+void DecTree::walkLanes(const PredictFrame* frame,
+			bool trapUnobserved,
+			const size_t obsIdx[],
+			unsigned int nLane,
+			IndexT finalIdx[]) const {
+  unsigned int live[nLaneMax]; // Lanes still walking.
+  for (unsigned int lane = 0; lane != nLane; lane++) {
+    finalIdx[lane] = 0;
+    live[lane] = lane;
+  }
+
+  unsigned int nLive = nLane;
+  while (nLive != 0) {
+    unsigned int nNext = 0;
+    for (unsigned int liveIdx = 0; liveIdx != nLive; liveIdx++) {
+      unsigned int lane = live[liveIdx];
+      const DecNode& node = decNode[finalIdx[lane]];
+      IndexT delIdx = trapUnobserved ? node.advanceTrap(frame, this, obsIdx[lane]) : node.advance(frame, this, obsIdx[lane]);
+      if (delIdx != 0) {
+	finalIdx[lane] += delIdx;
+	prefetchNode(&decNode[finalIdx[lane]]);
+	live[nNext++] = lane;
+      }
+    }
+    nLive = nNext;
+  }
+}
+
+
+IndexT DecTree::walkRow(const double num[],
+		       const CtgT fac[],
+		       PredictorT nPredNum,
+		       bool trapUnobserved,
+		       IndexT idx) const {
+  IndexT delIdx;
+  do {
+    const DecNode& node = decNode[idx];
+    if (node.isTerminal())
+      return idx;
+    PredictorT predIdx = node.getPredIdx();
+    if (predIdx >= nPredNum) {
+      size_t bitOffset = node.getBitOffset() + fac[predIdx - nPredNum];
+      delIdx = trapUnobserved ? node.advanceFactorTrap(facSplit, facObserved, bitOffset) : node.advanceFactor(facSplit, bitOffset);
+    }
+    else {
+      delIdx = trapUnobserved ? node.advanceNumTrap(num[predIdx]) : node.advanceNum(num[predIdx]);
+    }
+    idx += delIdx;
+  } while (delIdx != 0);
+
+  return idx;
+}
+
+
 vector<DecTree> DecTree::unpack(unsigned int nTree,
 				const double nodeExtent[],
 				const complex<double> nodes[],
@@ -33,6 +33,8 @@ class DecTree {
 
 public:
 
+  static const unsigned int nLaneMax = 8; ///< Maximal lockstep walks.
+
   DecTree(const vector<DecNode>& decNode_,
 	  const BV& facSplit_,
 	  const BV& facObserved_,
@@ -89,6 +91,43 @@ public:
   }
 
 
+  /**
+     @brief Resumes a walk from a given node over a single row.
+
+     @param num are the row's numeric values, in core order.
+
+     @param fac are the row's zero-based factor codes, in core order.
+
+     @param idx is the node at which to resume.
+
+     @return final index of the walk.
+   */
+  IndexT walkRow(const double num[],
+		 const CtgT fac[],
+		 PredictorT nPredNum,
+		 bool trapUnobserved,
+		 IndexT idx) const;
+
+
+  /**
+     @brief Walks a group of observations in lockstep.
+
+     Interleaving independent walks allows successive node fetches
+     to overlap, rather than stalling on each in turn.
+
+     @param obsIdx are the observation indices, one per lane.
+
+     @param nLane is the number of lanes in use:  <= nLaneMax.
+
+     @param[out] finalIdx outputs the final walk index, per lane.
+   */
+  void walkLanes(const PredictFrame* frame,
+		 bool trapUnobserved,
+		 const size_t obsIdx[],
+		 unsigned int nLane,
+		 IndexT finalIdx[]) const;
+
+
   size_t nodeCount() const {
     return decNode.size();
   }
@@ -27,6 +27,7 @@
 #include "deframe.h"
 #include "block.h"
 #include "rleframeR.h"
+#include "colframeR.h"
 
 #include<memory>
 
@@ -79,6 +80,41 @@ RcppExport SEXP deframeNum(SEXP sX) {
 }
 
 
+// [[Rcpp::export]]
+RcppExport SEXP deframeDirectDF(SEXP sDf,
+				SEXP sPredClass,
+				SEXP sLevel,
+				SEXP sSigTrain) {
+  if (!SignatureR::checkTypes(sSigTrain, as<CharacterVector>(sPredClass)))
+    stop("Training, prediction data types do not match.");
+
+  DataFrame df(sDf);
+  List deframe = List::create(
+			      _["colFrame"] = ColFrameR::wrapDF(df, sSigTrain, sLevel),
+			      _["nRow"] = df.nrow(),
+			      _["signature"] = SignatureR::wrapDF(df,
+								  as<CharacterVector>(sPredClass),
+								  List(sLevel),
+								  List::create(0))
+			      );
+  deframe.attr("class") = "Deframe";
+  return deframe;
+}
+
+
+RcppExport SEXP deframeDirectNum(SEXP sX) {
+  NumericMatrix blockNum(sX);
+  List deframe = List::create(
+			      _["colFrame"] = ColFrameR::wrapNum(blockNum),
+			      _["nRow"] = blockNum.nrow(),
+			      _["signature"] = SignatureR::wrapNumeric(blockNum)
+			      );
+
+  deframe.attr("class") = "Deframe";
+  return deframe;
+}
+
+
 /**
    @brief Reads an S4 object containing (sparse) dgCMatrix.
  */
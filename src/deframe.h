@@ -69,6 +69,27 @@ RcppExport SEXP deframeFac(SEXP sX);
 RcppExport SEXP deframeNum(SEXP sX);
 
 
+/**
+   @brief Wraps frame components for direct prediction, without presorting.
+
+   Parameters as with deframeDF(), save that factor values are not required.
+
+   @return wrapped frame aliasing the columns of the original.
+ */
+RcppExport SEXP deframeDirectDF(SEXP sX,
+				SEXP sPredClass,
+				SEXP sLevels,
+				SEXP sSigTrain);
+
+
+/**
+   @brief Wraps a numeric-valued matrix for direct prediction.
+
+   @param sX is the matrix.
+ */
+RcppExport SEXP deframeDirectNum(SEXP sX);
+
+
 /**
    @brief Encodes a sparse matrix compressed using 'I', 'P' indices.
  */
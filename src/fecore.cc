@@ -15,6 +15,7 @@
 
 #include "fecore.h"
 #include "ompthread.h"
+#include "prng.h"
 
 
 void FECore::init(unsigned int nThread) {
@@ -32,6 +33,11 @@ unsigned int FECore::getNThread() {
 }
 
 
+void FECore::seed() {
+  PRNG::seed(PRNG::frontSeed());
+}
+
+
 void FECore::deInit() {
   OmpThread::deInit();
 }
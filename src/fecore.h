@@ -42,6 +42,14 @@ struct FECore {
    */
   static unsigned int getNThread();
 
+
+  /**
+     @brief Seeds the core PRNG with a value drawn by the front end.
+
+     Invoked once per training, sampling or prediction request.
+   */
+  static void seed();
+
   
   /**
      @brief Static resetting of core parameters.
@@ -39,6 +39,11 @@ void FEPredict::initCtgProb(bool doProb) {
 }
 
 
+void FEPredict::initSink(PredictSink* sink) {
+  ForestPrediction::initSink(sink);
+}
+
+
 void FEPredict::deInit() {
   Predict::deInit();
   ForestPrediction::deInit();
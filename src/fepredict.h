@@ -49,6 +49,12 @@ struct FEPredict {
   static void initCtgProb(bool doProb);
 
 
+  /**
+     @brief Sets the block-wise output sink, if any.
+   */
+  static void initSink(struct PredictSink* sink);
+
+
   static void deInit();
 };
 
@@ -23,6 +23,7 @@
 #include "pretree.h"
 #include "partition.h"
 #include "sfcart.h"
+#include "cutaccum.h"
 #include "splitnux.h"
 #include "sampledobs.h"
 #include "algparam.h"
@@ -31,8 +32,9 @@
 #include <algorithm>
 
 void FETrain::initProb(PredictorT predFixed,
-                     const vector<double> &predProb) {
-  CandType::init(predFixed, predProb);
+                     const vector<double> &predProb,
+		     PredictorT predTree) {
+  CandType::init(predFixed, predProb, predTree);
 }
 
 
@@ -43,11 +45,15 @@ void FETrain::initTree(IndexT leafMax) {
 
 void FETrain::initSplit(unsigned int minNode,
                       unsigned int totLevels,
+                      unsigned int finishNode,
                       double minRatio,
-		      const vector<double>& feSplitQuant) {
+		      const vector<double>& feSplitQuant,
+		      bool extraTrees,
+		      unsigned int approxNode) {
   IndexSet::immutables(minNode);
-  Frontier::immutables(totLevels);
+  Frontier::immutables(totLevels, finishNode, extraTrees);
   SplitNux::immutables(minRatio, feSplitQuant);
+  CutAccum::immutables(approxNode);
 }
 
 
@@ -116,5 +122,6 @@ void FETrain::deInit() {
   SamplerNux::unsetMasks();
   CandType::deInit();
   SFRegCart::deImmutables();
+  CutAccum::deInit();
   FECore::deInit();
 }
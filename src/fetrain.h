@@ -66,9 +66,12 @@ struct FETrain {
 
   /**
      @brief Registers per-node probabilities of predictor selection.
+
+     @param predTree is the per-tree predictor subspace size, if nonzero.
   */
   static void initProb(unsigned int predFixed,
-                       const vector<double> &predProb);
+                       const vector<double> &predProb,
+		       unsigned int predTree);
 
   /**
      @brief Registers tree-shape parameters.
@@ -83,14 +86,24 @@ struct FETrain {
 
      @param totLevels is the maximum tree depth to train.
 
+     @param finishNode is the node size below which splitting is depth-first, if nonzero.
+
      @param minRatio is the minimum information ratio of a node to its parent.
      
      @param splitQuant is a per-predictor quantile specification.
+
+     @param extraTrees is true iff cuts are drawn at random.
+
+     @param approxNode is the cell size above which cuts are sketched
+     from a sample, if nonzero.
   */
   static void initSplit(unsigned int minNode,
                         unsigned int totLevels,
+                        unsigned int finishNode,
                         double minRatio,
-			const vector<double>& feSplitQuant);
+			const vector<double>& feSplitQuant,
+			bool extraTrees,
+			unsigned int approxNode);
   
   /**
      @brief Registers monotone specifications for regression.
@@ -0,0 +1,651 @@
+// This file is part of ArboristCore.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file finisher.cc
+
+   @brief Depth-first splitting of small nodes on local copies.
+
+   @author Mark Seligman
+ */
+
+#include "finisher.h"
+#include "frontier.h"
+#include "indexset.h"
+#include "samplemap.h"
+#include "sampledobs.h"
+#include "predictorframe.h"
+#include "nodescorer.h"
+#include "pretree.h"
+#include "splitnux.h"
+#include "splitfrontier.h"
+#include "runaccum.h"
+#include "cutaccumcart.h"
+#include "accum.h"
+#include "bheap.h"
+#include "candrf.h"
+#include "booster.h"
+#include "util.h"
+#include "prng.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+
+Finisher::Finisher(const Frontier* frontier,
+		   const IndexSet& iSet,
+		   const SampleMap& smTerminal,
+		   unsigned int level) :
+  frame(frontier->getFrame()),
+  sampledObs(frontier->getSampledObs()),
+  scorer(frontier->getScorer()),
+  predSpace(frontier->getPredSpace()),
+  spaceProb(frontier->getSpaceProb()),
+  nCtg(frontier->getNCtg()),
+  ctgSplit(nCtg > 0 && !Booster::boosting()),
+  ptRoot(iSet.getPTId()),
+  termStart(smTerminal.range[iSet.getIdxNext()].getStart()),
+  randomCuts(Frontier::randomCuts()),
+  sampleIndex(vector<IndexT>(iSet.getExtent())),
+  nObs(0),
+  codeLow(0),
+  codeHigh(0) {
+  copy_n(smTerminal.sampleIndex.begin() + termStart, sampleIndex.size(), sampleIndex.begin());
+  node.emplace_back(IndexRange(0, sampleIndex.size()), level, iSet.getMinInfo(), nCtg);
+  summarize(node.front());
+}
+
+
+void Finisher::grow(unsigned int tIdx,
+		    unsigned int totLevels) {
+  // Streams are keyed by subtree root, counting down from the top of
+  // the minor range so as not to collide with those of the levels.
+  PRNG::setStream(tIdx, numeric_limits<unsigned int>::max() - ptRoot);
+
+  // True successors are visited first, so leaves are encountered in
+  // buffer order.
+  vector<IndexT> pending{0};
+  while (!pending.empty()) {
+    IndexT nodeIdx = pending.back();
+    pending.pop_back();
+    if (split(nodeIdx, totLevels)) {
+      IndexT idxTrue = node[nodeIdx].idxTrue;
+      pending.push_back(idxTrue + 1);
+      pending.push_back(idxTrue);
+    }
+    else {
+      leafIdx.push_back(nodeIdx);
+    }
+  }
+}
+
+
+bool Finisher::split(IndexT nodeIdx,
+		     unsigned int totLevels) {
+  if (!splitable(node[nodeIdx], totLevels))
+    return false;
+
+  FinishCrit critMax = argMax(node[nodeIdx]);
+  if (critMax.info <= node[nodeIdx].minInfo)
+    return false;
+
+  branch(nodeIdx, std::move(critMax));
+  return true;
+}
+
+
+bool Finisher::splitable(const FinishNode& fn,
+			 unsigned int totLevels) const {
+  if (fn.range.getExtent() < IndexSet::getMinNode())
+    return false;
+  if (totLevels != 0 && fn.level + 1 >= totLevels)
+    return false;
+  if (ctgSplit) {
+    for (const SumCount& sc : fn.ctgSum) {
+      if (sc.getSCount() == fn.sCount)
+	return false;
+    }
+  }
+  return true;
+}
+
+
+FinishCrit Finisher::argMax(const FinishNode& fn) {
+  vector<double> ruMono;
+  if (!ctgSplit && !SFReg::mono.empty()) {
+    ruMono = PRNG::rUnif<double>(SFReg::mono.size(), 1.0, PRNG::Purpose::mono);
+  }
+
+  // Candidate variates are read as a window over the subspace, as by
+  // the frontier.
+  FinishCrit critMax;
+  PredictorT predFixed = CandRF::getPredFixed();
+  PredictorT nSpace = predSpace.size();
+  uint64_t ruCount = nSpace;
+  if (predFixed == 0) {
+    double probMax = CandRF::getProbMax();
+    if (probMax <= Cand::sparseProb) {
+      ruCount = 0;
+      Cand::sampleSkip(nSpace, spaceProb, probMax, ruCount,
+		       [&](PredictorT spaceIdx, double ru) {
+			 evaluate(fn, FinishCrit(predSpace[spaceIdx], Cand::getRandLow(ru)), ruMono, critMax);
+		       });
+    }
+    else {
+      vector<double> ruPred = PRNG::rUnifAt(0, nSpace, PRNG::Purpose::candidate);
+      for (PredictorT spaceIdx = 0; spaceIdx != nSpace; spaceIdx++) {
+	if (ruPred[spaceIdx] < spaceProb[spaceIdx]) {
+	  evaluate(fn, FinishCrit(predSpace[spaceIdx], Cand::getRandLow(ruPred[spaceIdx])), ruMono, critMax);
+	}
+      }
+    }
+  }
+  else {
+    PredShuffle predRand(nSpace);
+    uint64_t ruOff = 0;
+    PredictorT schedCount = 0;
+    while (!predRand.empty()) {
+      double ru = PRNG::unifAt(ruOff++, PRNG::Purpose::candidate);
+      PredictorT predIdx = predSpace[predRand.next(ru)];
+      if (evaluate(fn, FinishCrit(predIdx, Cand::getRandLow(ru)), ruMono, critMax)) {
+	if (++schedCount == predFixed) {
+	  break;
+	}
+      }
+    }
+  }
+  PRNG::skip(ruCount, PRNG::Purpose::candidate);
+
+  return critMax;
+}
+
+
+bool Finisher::evaluate(const FinishNode& fn,
+			FinishCrit crit,
+			const vector<double>& ruMono,
+			FinishCrit& critMax) {
+  if (!(randomCuts ? scan(fn, crit.predIdx) : gather(fn, crit.predIdx)))
+    return false;
+
+  if (frame->isFactor(crit.predIdx)) {
+    if (randomCuts)
+      runsRandom(crit);
+    else
+      splitRuns(crit);
+  }
+  else if (randomCuts) {
+    cutRandom(crit, ctgSplit ? 0 : getMonoMode(crit.predIdx, ruMono));
+  }
+  else if (ctgSplit) {
+    cutCtg(crit);
+  }
+  else {
+    cutReg(crit, getMonoMode(crit.predIdx, ruMono));
+  }
+
+  if (crit.maxInfo(critMax)) {
+    critMax = std::move(crit);
+  }
+  return true;
+}
+
+
+bool Finisher::gather(const FinishNode& fn,
+		      PredictorT predIdx) {
+  codeIdx.clear();
+  const vector<IndexT>& sampleRank = sampledObs->getRanks(predIdx);
+  for (IndexT idx = fn.range.getStart(); idx != fn.range.getEnd(); idx++) {
+    IndexT sIdx = sampleIndex[idx];
+    codeIdx.emplace_back(sampleRank[sIdx], sIdx);
+  }
+
+  // Missing codes are moved to the end and excluded from sorting.
+  IndexT rankMissing = frame->getMissingRank(predIdx);
+  auto missingStart = partition(codeIdx.begin(), codeIdx.end(), [rankMissing](const pair<IndexT, IndexT>& ci) {
+      return ci.first != rankMissing;
+    });
+  nObs = missingStart - codeIdx.begin();
+  sort(codeIdx.begin(), missingStart);
+
+  // Tie bits mark codes repeating their predecessor's, as staged.
+  obsCell.resize(codeIdx.size());
+  for (IndexT idx = 0; idx != codeIdx.size(); idx++) {
+    bool tie = idx != 0 && codeIdx[idx].first == codeIdx[idx - 1].first;
+    obsCell[idx].join(sampledObs->getSampleNux(codeIdx[idx].second), tie);
+  }
+
+  // A predictor is singleton if it has a single code, missing or not.
+  return nObs == 0 ? false : (nObs < codeIdx.size() || codeIdx.front().first != codeIdx[nObs - 1].first);
+}
+
+
+bool Finisher::scan(const FinishNode& fn,
+		    PredictorT predIdx) {
+  codeIdx.clear();
+  const vector<IndexT>& sampleRank = sampledObs->getRanks(predIdx);
+  IndexT rankMissing = frame->getMissingRank(predIdx);
+  codeLow = numeric_limits<IndexT>::max();
+  codeHigh = 0;
+  for (IndexT idx = fn.range.getStart(); idx != fn.range.getEnd(); idx++) {
+    IndexT sIdx = sampleIndex[idx];
+    IndexT code = sampleRank[sIdx];
+    codeIdx.emplace_back(code, sIdx);
+    if (code != rankMissing) {
+      codeLow = min(codeLow, code);
+      codeHigh = max(codeHigh, code);
+    }
+  }
+
+  auto missingStart = partition(codeIdx.begin(), codeIdx.end(), [rankMissing](const pair<IndexT, IndexT>& ci) {
+      return ci.first != rankMissing;
+    });
+  nObs = missingStart - codeIdx.begin();
+
+  return nObs == 0 ? false : (nObs < codeIdx.size() || codeLow != codeHigh);
+}
+
+
+int Finisher::getMonoMode(PredictorT predIdx,
+			  const vector<double>& ruMono) const {
+  if (ruMono.empty())
+    return 0;
+
+  PredictorT numIdx = frame->getTypedIdx(predIdx);
+  double monoProb = SFReg::mono[numIdx];
+  double prob = ruMono[numIdx];
+  if (monoProb > 0 && prob < monoProb) {
+    return 1;
+  }
+  else if (monoProb < 0 && prob < -monoProb) {
+    return -1;
+  }
+  else {
+    return 0;
+  }
+}
+
+
+SumCount Finisher::obsSumCount() const {
+  SumCount scObs;
+  for (IndexT idx = 0; idx != nObs; idx++) {
+    scObs += SumCount(obsCell[idx].getYSum(), obsCell[idx].getSCount());
+  }
+  return scObs;
+}
+
+
+CtgNux Finisher::obsCtgNux() const {
+  vector<double> ctgSum(nCtg);
+  for (IndexT idx = 0; idx != nObs; idx++) {
+    ctgSum[obsCell[idx].getCtg()] += obsCell[idx].getYSum();
+  }
+  double sumSquares = 0.0;
+  for (double sumCtg : ctgSum) {
+    sumSquares += sumCtg * sumCtg;
+  }
+  return CtgNux(ctgSum, sumSquares);
+}
+
+
+void Finisher::cutReg(FinishCrit& crit,
+		      int monoMode) {
+  IndexT obsLeft;
+  double gain = CutAccumRegCart::splitObs(&obsCell[0], nObs, obsSumCount(), monoMode, obsLeft);
+  setCut(crit, gain, obsLeft);
+}
+
+
+void Finisher::cutCtg(FinishCrit& crit) {
+  IndexT obsLeft;
+  double gain = CutAccumCtgCart::splitObs(&obsCell[0], nObs, obsSumCount(), obsCtgNux(), obsLeft);
+  setCut(crit, gain, obsLeft);
+}
+
+
+void Finisher::setCut(FinishCrit& crit,
+		      double gain,
+		      IndexT obsLeft) const {
+  if (obsLeft >= nObs)
+    return;
+
+  crit.info = gain;
+  crit.codeCut = codeIdx[obsLeft].first;
+  IndexRange rankRange = frame->getRankRange(crit.predIdx, codeIdx[obsLeft].first, codeIdx[obsLeft + 1].first);
+  crit.quantRank = rankRange.interpolate(SplitNux::splitQuant[crit.predIdx]);
+}
+
+
+void Finisher::cutRandom(FinishCrit& crit,
+			 int monoMode) {
+  if (codeLow == codeHigh)
+    return;
+
+  // The cut is drawn as a fractional code, so that the splitting rank
+  // is uniform over the node's span rather than over its samples.
+  double cutCode = codeLow + PRNG::rUnif<double>(1, 1.0, PRNG::Purpose::cut)[0] * (codeHigh - codeLow);
+  IndexT codeCut = min(static_cast<IndexT>(cutCode), codeHigh - 1);
+
+  double sumTot = 0.0;
+  IndexT sCountTot = 0;
+  double sumL = 0.0;
+  IndexT sCountL = 0;
+  vector<double> ctgTot(ctgSplit ? nCtg : 0);
+  vector<double> ctgL(ctgTot.size());
+  for (IndexT idx = 0; idx != nObs; idx++) {
+    IndexT sIdx = codeIdx[idx].second;
+    double ySum = sampledObs->getSum(sIdx);
+    IndexT sCount = sampledObs->getSCount(sIdx);
+    bool left = codeIdx[idx].first <= codeCut;
+    sumTot += ySum;
+    sCountTot += sCount;
+    if (left) {
+      sumL += ySum;
+      sCountL += sCount;
+    }
+    if (ctgSplit) {
+      PredictorT ctg = sampledObs->getCtg(sIdx);
+      ctgTot[ctg] += ySum;
+      if (left)
+	ctgL[ctg] += ySum;
+    }
+  }
+
+  double gain;
+  if (ctgSplit) {
+    gain = ctgGain(ctgTot, ctgL, sumTot);
+  }
+  else {
+    if (!Accum::senseMonotone(monoMode, sumL, sCountL, SumCount(sumTot, sCountTot)))
+      return;
+    gain = Accum::infoVar(sumL, sumTot - sumL, sCountL, sCountTot - sCountL) - (sumTot * sumTot) / sCountTot;
+  }
+  if (gain <= 0.0)
+    return;
+
+  crit.info = gain;
+  crit.codeCut = codeCut;
+  crit.quantRank = frame->getRankRange(crit.predIdx, codeCut, codeCut + 1).interpolate(cutCode - codeCut);
+}
+
+
+double Finisher::ctgGain(const vector<double>& ctgTot,
+			 const vector<double>& ctgL,
+			 double sumTot) {
+  double ssTot = 0.0;
+  for (double sumCtg : ctgTot) {
+    ssTot += sumCtg * sumCtg;
+  }
+  return Accum::subsetGini(ctgL, ctgTot, sumTot) - ssTot / sumTot;
+}
+
+
+void Finisher::runsRandom(FinishCrit& crit) {
+  vector<bool> codeSeen(1 + frame->getFactorExtent(crit.predIdx));
+  vector<IndexT> runCode;
+  for (IndexT idx = 0; idx != nObs; idx++) {
+    IndexT code = codeIdx[idx].first;
+    if (!codeSeen[code]) {
+      codeSeen[code] = true;
+      runCode.push_back(code);
+    }
+  }
+  PredictorT nRun = runCode.size();
+  if (nRun < 2)
+    return;
+  sort(runCode.begin(), runCode.end());
+
+  // Draws the size of the true subset, then its members.
+  vector<double> ruRun = PRNG::rUnif<double>(nRun, 1.0, PRNG::Purpose::cut);
+  PredictorT nTrue = 1 + min(static_cast<PredictorT>(ruRun[0] * (nRun - 1)), nRun - 2);
+  vector<PredictorT> slotOrder(nRun);
+  iota(slotOrder.begin(), slotOrder.end(), 0);
+  for (PredictorT slot = 0; slot != nTrue; slot++) {
+    PredictorT pick = slot + min(static_cast<PredictorT>(ruRun[slot + 1] * (nRun - slot)), nRun - slot - 1);
+    swap(slotOrder[slot], slotOrder[pick]);
+  }
+  vector<bool> slotTrue(nRun);
+  vector<bool> codeTrue(codeSeen.size());
+  for (PredictorT slot = 0; slot != nTrue; slot++) {
+    slotTrue[slot] = true;
+    codeTrue[runCode[slotOrder[slot]]] = true;
+  }
+
+  SumCount scTot;
+  SumCount scL;
+  vector<double> ctgTot(ctgSplit ? nCtg : 0);
+  vector<double> ctgL(ctgTot.size());
+  for (IndexT idx = 0; idx != nObs; idx++) {
+    IndexT sIdx = codeIdx[idx].second;
+    double ySum = sampledObs->getSum(sIdx);
+    SumCount sc(ySum, sampledObs->getSCount(sIdx));
+    bool left = codeTrue[codeIdx[idx].first];
+    scTot += sc;
+    if (left)
+      scL += sc;
+    if (ctgSplit) {
+      PredictorT ctg = sampledObs->getCtg(sIdx);
+      ctgTot[ctg] += ySum;
+      if (left)
+	ctgL[ctg] += ySum;
+    }
+  }
+
+  double gain;
+  if (ctgSplit) {
+    gain = ctgGain(ctgTot, ctgL, scTot.sum);
+  }
+  else {
+    gain = Accum::infoVar(scL, scTot) - (scTot.sum * scTot.sum) / scTot.sCount;
+  }
+  if (gain <= 0.0)
+    return;
+
+  crit.info = gain;
+  setRuns(crit, runCode, slotOrder, slotTrue);
+}
+
+
+void Finisher::splitRuns(FinishCrit& crit) {
+  // Workspace is sorted, so runs are contiguous.
+  vector<IndexT> runCode;
+  for (IndexT idx = 0; idx != nObs; idx++) {
+    if (!obsCell[idx].isTied())
+      runCode.push_back(codeIdx[idx].first);
+  }
+  PredictorT nRun = runCode.size();
+  if (nRun < 2)
+    return;
+
+  ArenaVec<RunNux> runNux(nRun);
+  vector<double> runSum(ctgSplit ? nRun * nCtg : 0); // run x ctg checkerboard.
+  PredictorT runIdx = 0;
+  for (IndexT idx = 0; idx != nObs; idx++) {
+    const Obs& obs = obsCell[idx];
+    if (idx != 0 && !obs.isTied())
+      runIdx++;
+    runNux[runIdx].sumCount += SumCount(obs.getYSum(), obs.getSCount());
+    if (ctgSplit)
+      runSum[runIdx * nCtg + obs.getCtg()] += obs.getYSum();
+  }
+
+  // Runs are ordered and searched as by the frontier's accumulators.
+  SumCount scTot = obsSumCount();
+  vector<PredictorT> slotOrder(nRun);
+  iota(slotOrder.begin(), slotOrder.end(), 0);
+  vector<bool> slotTrue(nRun);
+  vector<BHPair<PredictorT>> heap(nRun);
+  bool subsets = ctgSplit && nCtg > 2 && nRun <= RunAccum::maxWidth;
+  double infoCell;
+  double info;
+  PredictorT argMaxSlot = nRun - 1; // Rightmost slot of true prefix.
+  if (!ctgSplit) {
+    infoCell = (scTot.sum * scTot.sum) / scTot.sCount;
+    info = infoCell;
+    RunAccum::heapMean(&heap[0], runNux);
+    slotOrder = reorder(PQueue::depopulate<PredictorT>(&heap[0], nRun), runNux, runSum);
+    argMaxSlot = RunAccum::maxVar(runNux, scTot, info);
+  }
+  else {
+    CtgNux ctgNux = obsCtgNux();
+    infoCell = ctgNux.sumSquares / scTot.sum;
+    info = infoCell;
+    if (nCtg == 2) {
+      RunAccumCtg::heapBinary(&heap[0], runNux, runSum);
+      slotOrder = reorder(PQueue::depopulate<PredictorT>(&heap[0], nRun), runNux, runSum);
+      argMaxSlot = RunAccumCtg::binaryGini(runNux, runSum, ctgNux.ctgSum, scTot.sum, info);
+    }
+    else if (!subsets) {
+      RunAccumCtg::heapProjection(&heap[0], runNux, runSum, ctgNux.ctgSum, scTot.sum);
+      slotOrder = reorder(PQueue::depopulate<PredictorT>(&heap[0], nRun), runNux, runSum);
+      argMaxSlot = RunAccumCtg::orderedGini(nRun, runSum, ctgNux.ctgSum, scTot.sum, info);
+    }
+    else {
+      // Exhaustive search over subsets, up to complement.
+      PredictorT trueSlots = RunAccumCtg::ctgGini(nRun, runSum, ctgNux.ctgSum, scTot.sum, info);
+      for (PredictorT slot = 0; slot < nRun; slot++) {
+	slotTrue[slot] = (trueSlots & (1ul << slot)) != 0;
+      }
+    }
+  }
+  if (info <= infoCell)
+    return;
+
+  crit.info = info - infoCell;
+  for (PredictorT slot = 0; !subsets && slot <= argMaxSlot; slot++) {
+    slotTrue[slot] = true;
+  }
+  setRuns(crit, runCode, slotOrder, slotTrue);
+}
+
+
+vector<PredictorT> Finisher::reorder(const vector<PredictorT>& idxRank,
+				     ArenaVec<RunNux>& runNux,
+				     vector<double>& runSum) const {
+  PredictorT nRun = runNux.size();
+  PredictorT nCol = runSum.size() / nRun;
+  vector<PredictorT> slotOrder(nRun);
+  ArenaVec<RunNux> nuxOrdered(nRun);
+  vector<double> sumOrdered(runSum.size());
+  for (PredictorT slot = 0; slot < nRun; slot++) {
+    PredictorT outSlot = idxRank[slot];
+    slotOrder[outSlot] = slot;
+    nuxOrdered[outSlot] = runNux[slot];
+    for (PredictorT col = 0; col < nCol; col++) {
+      sumOrdered[outSlot * nCol + col] = runSum[slot * nCol + col];
+    }
+  }
+  runNux = std::move(nuxOrdered);
+  runSum = std::move(sumOrdered);
+
+  return slotOrder;
+}
+
+
+void Finisher::setRuns(FinishCrit& crit,
+		       const vector<IndexT>& runCode,
+		       const vector<PredictorT>& slotOrder,
+		       const vector<bool>& slotTrue) const {
+  // Inverted tests send the complementary runs along the true branch.
+  bool invert = crit.invertTest();
+  for (PredictorT slot = 0; slot < slotOrder.size(); slot++) {
+    IndexT code = runCode[slotOrder[slot]];
+    crit.codeObserved.push_back(code);
+    if (slotTrue[slot] != invert)
+      crit.codeTrue.push_back(code);
+  }
+}
+
+
+void Finisher::branch(IndexT nodeIdx,
+		      FinishCrit crit) {
+  IndexRange range = node[nodeIdx].range;
+  PredictorT predIdx = crit.predIdx;
+  IndexT rankMissing = frame->getMissingRank(predIdx);
+  bool isFactor = frame->isFactor(predIdx);
+  vector<bool> codeTrue(isFactor ? 1 + frame->getFactorExtent(predIdx) : 0);
+  for (IndexT code : crit.codeTrue) {
+    codeTrue[code] = true;
+  }
+
+  // Missing observations take the false branch.
+  const vector<IndexT>& sampleRank = sampledObs->getRanks(predIdx);
+  auto trueEnd = stable_partition(sampleIndex.begin() + range.getStart(), sampleIndex.begin() + range.getEnd(), [&](IndexT sIdx) {
+      IndexT code = sampleRank[sIdx];
+      if (code == rankMissing)
+	return false;
+      return isFactor ? bool(codeTrue[code]) : code <= crit.codeCut;
+    });
+  IndexT extentTrue = (trueEnd - sampleIndex.begin()) - range.getStart();
+
+  unsigned int levelSucc = node[nodeIdx].level + 1;
+  double minInfo = crit.info * SplitNux::getMinRatio();
+  node[nodeIdx].idxTrue = node.size();
+  node[nodeIdx].crit = std::move(crit);
+
+  node.emplace_back(IndexRange(range.getStart(), extentTrue), levelSucc, minInfo, nCtg);
+  node.emplace_back(IndexRange(range.getStart() + extentTrue, range.getExtent() - extentTrue), levelSucc, minInfo, nCtg);
+  for (IndexT idxSucc = node.size() - 2; idxSucc != node.size(); idxSucc++) {
+    summarize(node[idxSucc]);
+    node[idxSucc].score = score(node[idxSucc]);
+  }
+}
+
+
+void Finisher::summarize(FinishNode& fn) const {
+  for (IndexT idx = fn.range.getStart(); idx != fn.range.getEnd(); idx++) {
+    IndexT sIdx = sampleIndex[idx];
+    double ySum = sampledObs->getSum(sIdx);
+    IndexT sCount = sampledObs->getSCount(sIdx);
+    fn.sum += ySum;
+    fn.sCount += sCount;
+    if (nCtg > 0) {
+      fn.ctgSum[sampledObs->getCtg(sIdx)] += SumCount(ySum, sCount);
+    }
+  }
+}
+
+
+double Finisher::score(const FinishNode& fn) const {
+  vector<double> jitter = PRNG::rUnif<double>(nCtg, 0.5, PRNG::Purpose::jitter);
+  return scorer->score(ScoreNode{&sampleIndex[fn.range.getStart()],
+				 fn.range.getExtent(),
+				 fn.sum,
+				 fn.sCount,
+				 fn.ctgSum,
+				 jitter.empty() ? nullptr : &jitter[0]});
+}
+
+
+void Finisher::graft(PreTree* pretree,
+		     SampleMap& smTerminal) const {
+  copy(sampleIndex.begin(), sampleIndex.end(), smTerminal.sampleIndex.begin() + termStart);
+
+  vector<IndexT> ptLocal(node.size());
+  ptLocal[0] = ptRoot;
+  for (IndexT nodeIdx = 0; nodeIdx != node.size(); nodeIdx++) {
+    const FinishNode& fn = node[nodeIdx];
+    if (fn.idxTrue == 0)
+      continue;
+
+    const FinishCrit& crit = fn.crit;
+    IndexT ptId = ptLocal[nodeIdx];
+    if (frame->isFactor(crit.predIdx)) {
+      ptLocal[fn.idxTrue] = pretree->graftBits(ptId, crit.predIdx, 1 + frame->getFactorExtent(crit.predIdx), crit.codeTrue, crit.codeObserved, crit.invertTest(), crit.info);
+    }
+    else {
+      ptLocal[fn.idxTrue] = pretree->graftCut(ptId, crit.predIdx, crit.quantRank, crit.invertTest(), crit.info);
+    }
+    ptLocal[fn.idxTrue + 1] = pretree->getIdFalse(ptId);
+    pretree->setScore(ptLocal[fn.idxTrue], node[fn.idxTrue].score);
+    pretree->setScore(ptLocal[fn.idxTrue + 1], node[fn.idxTrue + 1].score);
+  }
+
+  for (IndexT leaf : leafIdx) {
+    smTerminal.addNode(node[leaf].range.getExtent(), ptLocal[leaf]);
+  }
+}
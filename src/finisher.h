@@ -0,0 +1,340 @@
+// This file is part of ArboristCore.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file finisher.h
+
+   @brief Completes small subtrees depth-first, off the frontier.
+
+   @author Mark Seligman
+ */
+
+#ifndef FRONTIER_FINISHER_H
+#define FRONTIER_FINISHER_H
+
+#include "typeparam.h"
+#include "sumcount.h"
+#include "obs.h"
+
+#include <vector>
+#include <utility>
+
+
+/**
+   @brief Splitting criterion found by a finisher.
+ */
+struct FinishCrit {
+  PredictorT predIdx;
+  uint32_t randVal; ///< Arbitrates ties and sense inversion.
+  double info; ///< Information gain.
+  IndexT codeCut; ///< Numeric only:  highest code taking true branch.
+  double quantRank; ///< Numeric only:  fractional rank of cut.
+  vector<IndexT> codeTrue; ///< Factor only:  codes taking true branch.
+  vector<IndexT> codeObserved; ///< Factor only:  codes observed at node.
+
+  FinishCrit(PredictorT predIdx_ = 0,
+	     uint32_t randVal_ = 0) :
+    predIdx(predIdx_),
+    randVal(randVal_),
+    info(0.0),
+    codeCut(0),
+    quantRank(0.0) {
+  }
+
+
+  /**
+     @brief As with SplitNux, ties are broken by random value.
+
+     @return true iff this criterion supersedes the argmax passed.
+   */
+  bool maxInfo(const FinishCrit& amn) const {
+    return (info > amn.info) || (info == amn.info && info > 0.0 && randVal > amn.randVal);
+  }
+
+
+  bool invertTest() const {
+    return (randVal & 0x80000000) != 0;
+  }
+};
+
+
+/**
+   @brief Node of a subtree grown by a finisher.
+ */
+struct FinishNode {
+  IndexRange range; ///< Position within the finisher's sample buffer.
+  double sum; ///< Sum of sampled responses.
+  IndexT sCount; ///< # samples, with multiplicity.
+  vector<SumCount> ctgSum; ///< Per-category sums:  empty iff regression.
+  double minInfo; ///< Splitting threshold.
+  unsigned int level; ///< Depth within the tree.
+  double score; ///< Score, as assigned by the tree's scorer.
+  IndexT idxTrue; ///< Local index of true successor, if nonterminal, else zero.
+  FinishCrit crit; ///< Defined iff nonterminal.
+
+  FinishNode(const IndexRange& range_,
+	     unsigned int level_,
+	     double minInfo_,
+	     PredictorT nCtg) :
+    range(range_),
+    sum(0.0),
+    sCount(0),
+    ctgSum(vector<SumCount>(nCtg)),
+    minInfo(minInfo_),
+    level(level_),
+    score(0.0),
+    idxTrue(0) {
+  }
+};
+
+
+/**
+   @brief Grows the subtree rooted at a small frontier node.
+
+   The node's sample indices are copied out of the terminal map and
+   partitioned in place by a single thread.  Candidate predictors are
+   sorted locally, node by node, rather than restaged level by level.
+   Candidate sampling, splitting and scoring otherwise follow the
+   frontier.  The subtree is grafted onto the pretree once grown.
+
+   Sorted candidates are packed as observations and split by the
+   frontier's own accumulators, so that a node yields the same
+   criterion whether split here or on the frontier.
+
+   When cuts are random, as for extremely randomized trees, codes are
+   left unsorted and a single cut is evaluated per candidate.
+ */
+class Finisher {
+  const class PredictorFrame* frame;
+  const class SampledObs* sampledObs;
+  const struct NodeScorer* scorer;
+  const vector<PredictorT>& predSpace; ///< Tree's eligible predictors.
+  const vector<double>& spaceProb; ///< Selection probabilities, by subspace position.
+  const PredictorT nCtg; ///< Response cardinality.
+  const bool ctgSplit; ///< Whether splitting is categorical.
+  const IndexT ptRoot; ///< Pretree index of subtree root.
+  const IndexT termStart; ///< Root's starting position in terminal map.
+  const bool randomCuts; ///< Whether each candidate is split at a random cut.
+
+  vector<IndexT> sampleIndex; ///< Local copy, partitioned by node.
+  vector<FinishNode> node; ///< Local nodes, in order of creation.
+  vector<IndexT> leafIdx; ///< Local terminals, in buffer order.
+
+  // Per-candidate workspace:
+  vector<pair<IndexT, IndexT>> codeIdx; ///< Codes and sample indices, sorted.
+  vector<Obs> obsCell; ///< Packed observations, in workspace order.
+  IndexT nObs; ///< # nonmissing codes, which lead the workspace.
+  IndexT codeLow; ///< Least nonmissing code.
+  IndexT codeHigh; ///< Greatest nonmissing code.
+
+
+  /**
+     @brief Attempts to split a node and, if successful, its successors.
+
+     @return true iff the node splits.
+   */
+  bool split(IndexT nodeIdx,
+	     unsigned int totLevels);
+
+
+  /**
+     @return true iff node meets the frontier's splitting conditions.
+   */
+  bool splitable(const FinishNode& fn,
+		 unsigned int totLevels) const;
+
+
+  /**
+     @brief Samples predictors as CandRF, evaluating each.
+
+     @return maximal- or zero-information criterion.
+   */
+  FinishCrit argMax(const FinishNode& fn);
+
+
+  /**
+     @brief Evaluates a candidate predictor and updates the argmax.
+
+     @return false iff the predictor is singleton over the node.
+   */
+  bool evaluate(const FinishNode& fn,
+		FinishCrit crit,
+		const vector<double>& ruMono,
+		FinishCrit& critMax);
+
+
+  /**
+     @brief Copies and sorts the node's codes into the workspace,
+     packing the corresponding observations.
+
+     @return false iff the node holds a single code.
+   */
+  bool gather(const FinishNode& fn,
+	      PredictorT predIdx);
+
+
+  /**
+     @brief As above, but unsorted, noting the extreme codes.
+
+     @return false iff the node holds a single code.
+   */
+  bool scan(const FinishNode& fn,
+	    PredictorT predIdx);
+
+
+  /**
+     @return monotonicity constraint drawn for predictor, if any.
+   */
+  int getMonoMode(PredictorT predIdx,
+		  const vector<double>& ruMono) const;
+
+
+  /**
+     @brief Summarizes the response of the nonmissing observations.
+
+     As with the frontier, splitting sees responses as packed.
+   */
+  SumCount obsSumCount() const;
+
+
+  /**
+     @brief As above, but by category.
+   */
+  struct CtgNux obsCtgNux() const;
+
+
+  /**
+     @brief Cut-based splitting by weighted variance.
+   */
+  void cutReg(FinishCrit& crit,
+	      int monoMode);
+
+
+  /**
+     @brief Cut-based splitting by Gini.
+   */
+  void cutCtg(FinishCrit& crit);
+
+
+  /**
+     @brief Evaluates a single cut, drawn uniformly between the
+     extreme codes.
+   */
+  void cutRandom(FinishCrit& crit,
+		 int monoMode);
+
+
+  /**
+     @brief Records the cut to the left of a workspace position.
+   */
+  void setCut(FinishCrit& crit,
+	      double gain,
+	      IndexT obsLeft) const;
+
+
+  /**
+     @brief Run-based splitting of a factor.
+   */
+  void splitRuns(FinishCrit& crit);
+
+
+  /**
+     @brief Reorders runs and their category sums by heap rank.
+
+     @param idxRank is the rank of each run, as depopulated.
+
+     @return run index at each ordered slot.
+   */
+  vector<PredictorT> reorder(const vector<PredictorT>& idxRank,
+			     ArenaVec<RunNux>& runNux,
+			     vector<double>& runSum) const;
+
+
+  /**
+     @brief Gini gain of a trial split, as evaluated by the random cuts.
+
+     @param ctgTot are the per-category response sums of the node.
+
+     @param ctgL are the per-category response sums of the true branch.
+
+     @param sumTot is the response sum of the node.
+
+     @return gain over the node's own Gini information.
+   */
+  static double ctgGain(const vector<double>& ctgTot,
+			const vector<double>& ctgL,
+			double sumTot);
+
+
+  /**
+     @brief Evaluates a single random subset of a factor's runs.
+   */
+  void runsRandom(FinishCrit& crit);
+
+
+  /**
+     @brief Converts runs to the left of the argmax slot into codes.
+
+     @param slotOrder orders the runs.
+   */
+  void setRuns(FinishCrit& crit,
+	       const vector<IndexT>& runCode,
+	       const vector<PredictorT>& slotOrder,
+	       const vector<bool>& slotTrue) const;
+
+
+  /**
+     @brief Partitions a node and appends its successors.
+   */
+  void branch(IndexT nodeIdx,
+	      FinishCrit crit);
+
+
+  /**
+     @brief Accumulates the node's response sums.
+   */
+  void summarize(FinishNode& fn) const;
+
+
+  /**
+     @return node's score, drawing jitter as needed.
+   */
+  double score(const FinishNode& fn) const;
+
+
+public:
+
+  /**
+     @param level is the depth of the subtree root.
+   */
+  Finisher(const class Frontier* frontier,
+	   const class IndexSet& iSet,
+	   const struct SampleMap& smTerminal,
+	   unsigned int level);
+
+
+  /**
+     @brief Grows the subtree depth-first.
+
+     @param tIdx selects the tree's PRNG stream.
+
+     @param totLevels is the maximum number of levels, if nonzero.
+   */
+  void grow(unsigned int tIdx,
+	    unsigned int totLevels);
+
+
+  /**
+     @brief Appends the subtree to the pretree and its leaves to the terminal map.
+
+     Assumes the terminal map has been truncated to the subtree root.
+   */
+  void graft(class PreTree* pretree,
+	     struct SampleMap& smTerminal) const;
+};
+
+#endif
@@ -26,11 +26,38 @@
 Forest::Forest(vector<DecTree>&& decTree_,
 	       const tuple<double, double, string>& scoreDesc_,
 	       Leaf&& leaf_) :
-  decTree(decTree_),
   scoreDesc(ScoreDesc(scoreDesc_)),
   leaf(leaf_),
-  noNode(maxHeight(decTree)),
-  nTree(decTree.size()) {
+  noNode(maxHeight(decTree_)),
+  nTree(decTree_.size()),
+  compactTree(compact(decTree_)),
+  decTree(retain(std::move(decTree_), compactTree)),
+  quickScored(false),
+  quickPredNum(0) {
+}
+
+
+vector<CompactTree> Forest::compact(const vector<DecTree>& decTree) {
+  vector<CompactTree> compactTree;
+  unsigned int predBits = CompactTree::predWidth(decTree);
+  for (const DecTree& tree : decTree) {
+    compactTree.emplace_back(tree, predBits);
+  }
+  return compactTree;
+}
+
+
+vector<DecTree> Forest::retain(vector<DecTree>&& decTree,
+			       const vector<CompactTree>& compactTree) {
+  vector<DecTree> retained;
+  for (unsigned int tIdx = 0; tIdx != decTree.size(); tIdx++) {
+    if (compactTree[tIdx].isEmpty())
+      retained.emplace_back(std::move(decTree[tIdx]));
+    else
+      retained.emplace_back(vector<DecNode>(), BV(size_t(0)), BV(size_t(0)), vector<double>());
+  }
+  decTree.clear();
+  return retained;
 }
 
 
@@ -43,6 +70,25 @@ size_t Forest::maxHeight(const vector<DecTree>& decTree) {
 }
 
 
+const QuickScorer* Forest::getQuickScorer(PredictorT nPredNum) const {
+  if (!quickScored || quickPredNum != nPredNum) {
+    quickScorer = QuickScorer::make(this, nPredNum);
+    quickPredNum = nPredNum;
+    quickScored = true;
+  }
+  return quickScorer.get();
+}
+
+
+size_t Forest::getNodeBytes() const {
+  size_t nodeBytes = 0;
+  for (unsigned int tIdx = 0; tIdx < nTree; tIdx++) {
+    nodeBytes += compactTree[tIdx].isEmpty() ? decTree[tIdx].nodeCount() * sizeof(DecNode) : compactTree[tIdx].getNodeBytes();
+  }
+  return nodeBytes;
+}
+
+
 unique_ptr<ForestPredictionReg> Forest::makePredictionReg(const Sampler* sampler,
 							  const class Predict* predict,
 							  bool reportAuxiliary) {
@@ -71,7 +117,7 @@ void Forest::dump(vector<vector<PredictorT> >& pred,
                   vector<vector<size_t> >& delIdx,
 		  vector<vector<double>>& score) const {
   for (unsigned int tIdx = 0; tIdx < nTree; tIdx++) {
-    const DecTree& tree = decTree[tIdx];
+    const DecTree tree = getDecTree(tIdx);
     for (IndexT nodeIdx = 0; nodeIdx < tree.nodeCount(); nodeIdx++) {
       pred[tIdx].push_back(tree.getPredIdx(nodeIdx));
       delIdx[tIdx].push_back(tree.getDelIdx(nodeIdx));
@@ -86,27 +132,53 @@ void Forest::dump(vector<vector<PredictorT> >& pred,
 vector<IndexT> Forest::getLeafNodes(unsigned int tIdx,
 				    IndexT extent) const {
   vector<IndexT> leafIndices(extent);
-  IndexT nodeIdx = 0;
-  for (auto node : decTree[tIdx].getNode()) {
+  for (IndexT nodeIdx = 0; nodeIdx != getNodeCount(tIdx); nodeIdx++) {
     IndexT leafIdx;
-    if (node.getLeafIdx(leafIdx)) {
+    if (getLeafIdx(tIdx, nodeIdx, leafIdx)) {
       leafIndices[leafIdx] = nodeIdx;
     }
-    nodeIdx++;
   }
 
   return leafIndices;
 }
 
 
-vector<vector<IndexRange>> Forest::leafDominators() const {
-  vector<vector<IndexRange>> leafDom(nTree);
-  
+vector<IndexT> Forest::pathHeads(unsigned int tIdx,
+				 PredictorT predIdx) const {
+  IndexT nNode = getNodeCount(tIdx);
+  vector<IndexT> head(nNode, noNode);
+  bool splits = false;
+  // Parents precede children, so heads propagate in a single pass.
+  for (IndexT idx = 0; idx != nNode; idx++) {
+    IndexT delIdx = getDelIdx(tIdx, idx);
+    if (delIdx == 0)
+      continue;
+    if (head[idx] == noNode && getPredIdx(tIdx, idx) == predIdx) {
+      head[idx] = idx;
+      splits = true;
+    }
+    head[idx + delIdx] = head[idx];
+    head[idx + delIdx + 1] = head[idx];
+  }
+
+  return splits ? head : vector<IndexT>(0);
+}
+
+
+const vector<vector<IndexRange>>& Forest::leafDominators() const {
+  if (leafDom.size() == nTree)
+    return leafDom;
+
+  leafDom = vector<vector<IndexRange>>(nTree);
 #pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
   {
 #pragma omp for schedule(dynamic, 1)
   for (unsigned int tIdx = 0; tIdx < nTree; tIdx++) {
-    leafDom[tIdx] = leafDominators(decTree[tIdx].getNode());
+    vector<IndexT> delIdx(getNodeCount(tIdx));
+    for (IndexT nodeIdx = 0; nodeIdx != delIdx.size(); nodeIdx++) {
+      delIdx[nodeIdx] = getDelIdx(tIdx, nodeIdx);
+    }
+    leafDom[tIdx] = leafDominators(delIdx);
   }
   }
   return leafDom;
@@ -114,21 +186,29 @@ vector<vector<IndexRange>> Forest::leafDominators() const {
   
 
 vector<IndexRange> Forest::leafDominators(const vector<DecNode>& tree) {
-  IndexT height = tree.size();
+  vector<IndexT> delIdx;
+  for (const DecNode& node : tree) {
+    delIdx.push_back(node.getDelIdx());
+  }
+  return leafDominators(delIdx);
+}
+
+
+vector<IndexRange> Forest::leafDominators(const vector<IndexT>& delIdx) {
+  IndexT height = delIdx.size();
   // Gives each node the offset of its predecessor.
   vector<IndexT> delPred(height);
   for (IndexT i = 0; i < height; i++) {
-    IndexT delIdx = tree[i].getDelIdx();
-    if (delIdx != 0) {
-      delPred[i + delIdx] = delIdx;
-      delPred[i + delIdx + 1] = delIdx + 1;
+    if (delIdx[i] != 0) {
+      delPred[i + delIdx[i]] = delIdx[i];
+      delPred[i + delIdx[i] + 1] = delIdx[i] + 1;
     }
   }
 
   // Pushes dominated leaf count up the tree.
   vector<IndexT> leavesBelow(height);
   for (IndexT i = height - 1; i > 0; i--) {
-    leavesBelow[i] += (tree[i].isNonterminal() ? 0: 1);
+    leavesBelow[i] += (delIdx[i] != 0 ? 0: 1);
     leavesBelow[i - delPred[i]] += leavesBelow[i];
   }
 
@@ -136,10 +216,9 @@ vector<IndexRange> Forest::leafDominators(const vector<DecNode>& tree) {
   vector<IndexRange> leafDom(height);
   leafDom[0] = IndexRange(0, leavesBelow[0]); // Root dominates all leaves.
   for (IndexT i = 0; i < height; i++) {
-    IndexT delIdx = tree[i].getDelIdx();
-    if (delIdx != 0) {
+    if (delIdx[i] != 0) {
       IndexRange leafRange = leafDom[i];
-      IndexT idxTrue = i + delIdx;
+      IndexT idxTrue = i + delIdx[i];
       IndexT trueStart = leafRange.getStart();
       leafDom[idxTrue] = IndexRange(trueStart, leavesBelow[idxTrue]);
       IndexT idxFalse = idxTrue + 1;
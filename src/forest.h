@@ -18,6 +18,8 @@
 #define FOREST_FOREST_H
 
 #include "dectree.h"
+#include "compacttree.h"
+#include "quickscorer.h"
 #include "leaf.h"
 #include "typeparam.h"
 #include "scoredesc.h"
@@ -34,11 +36,18 @@ class PredictFrame;
    @brief The decision forest as a read-only collection.
 */
 class Forest {
-  vector<DecTree> decTree; ///< New representation; ultimately constant.
   const ScoreDesc scoreDesc;
   const Leaf leaf;  //  const unique_ptr<class Leaf> leaf;
   const size_t noNode; ///< Inattainable node index.
   const unsigned int nTree;
+  const vector<CompactTree> compactTree; ///< Inference layout, per tree.
+  const vector<DecTree> decTree; ///< Empty unless compact layout empty.
+
+  // Derived on first use and retained across predictions:
+  mutable vector<vector<IndexRange>> leafDom; ///< Per-tree leaf dominators.
+  mutable bool quickScored; ///< Whether eligibility for bit scoring known.
+  mutable PredictorT quickPredNum; ///< # numeric predictors scored.
+  mutable unique_ptr<QuickScorer> quickScorer; ///< Nonnull iff eligible.
 
 
   void dump(vector<vector<PredictorT>>& predTree,
@@ -69,11 +78,61 @@ class Forest {
 	 Leaf&& leaf_);
 
 
+  /**
+     @brief Builds the compact layout of each tree.
+   */
+  static vector<CompactTree> compact(const vector<DecTree>& decTree);
+
+
+  /**
+     @brief Retains only those trees lacking a compact layout.
+
+     @return per-tree DecTree, empty where compact layout present.
+   */
+  static vector<DecTree> retain(vector<DecTree>&& decTree,
+				const vector<CompactTree>& compactTree);
+
+
   IndexT walkObs(const PredictFrame* frame,
 		 bool trapUnobserved,
 		 size_t obsIdx,
 		 unsigned int tIdx) const {
-    return decTree[tIdx].walkObs(frame, trapUnobserved, obsIdx);
+    if (compactTree[tIdx].isEmpty())
+      return decTree[tIdx].walkObs(frame, trapUnobserved, obsIdx);
+    else
+      return compactTree[tIdx].walkObs(frame, trapUnobserved, obsIdx);
+  }
+
+
+  /**
+     @brief Walks a group of observations through a single tree.
+   */
+  void walkLanes(const PredictFrame* frame,
+		 bool trapUnobserved,
+		 unsigned int tIdx,
+		 const size_t obsIdx[],
+		 unsigned int nLane,
+		 IndexT finalIdx[]) const {
+    if (compactTree[tIdx].isEmpty())
+      decTree[tIdx].walkLanes(frame, trapUnobserved, obsIdx, nLane, finalIdx);
+    else
+      compactTree[tIdx].walkLanes(frame, trapUnobserved, obsIdx, nLane, finalIdx);
+  }
+
+
+  /**
+     @brief Resumes a walk from a given node over a single row.
+   */
+  IndexT walkRow(unsigned int tIdx,
+		 const double num[],
+		 const CtgT fac[],
+		 PredictorT nPredNum,
+		 bool trapUnobserved,
+		 IndexT idx) const {
+    if (compactTree[tIdx].isEmpty())
+      return decTree[tIdx].walkRow(num, fac, nPredNum, trapUnobserved, idx);
+    else
+      return compactTree[tIdx].walkRow(num, fac, nPredNum, trapUnobserved, idx);
   }
 
 
@@ -94,10 +153,21 @@ class Forest {
   }
 
 
-  const vector<DecNode>& getNode(unsigned int tIdx) const {
-    return decTree[tIdx].getNode();
+  /**
+     @brief Recovers a tree from its compact layout, if not retained.
+
+     Intended for infrequent consumers, such as dumpers and encoders.
+   */
+  DecTree getDecTree(unsigned int tIdx) const {
+    return compactTree[tIdx].isEmpty() ? decTree[tIdx] : compactTree[tIdx].expand();
   }
 
+
+  /**
+     @return storage occupied by the nodes walked.
+   */
+  size_t getNodeBytes() const;
+
   
   size_t getNoNode() const {
     return noNode;
@@ -107,21 +177,59 @@ class Forest {
   bool getLeafIdx(unsigned int tIdx,
 		  IndexT nodeIdx,
 		  IndexT& leafIdx) const {
-    return decTree[tIdx].getLeafIdx(nodeIdx, leafIdx);
+    if (compactTree[tIdx].isEmpty())
+      return decTree[tIdx].getLeafIdx(nodeIdx, leafIdx);
+    else
+      return compactTree[tIdx].getLeafIdx(nodeIdx, leafIdx);
   }
   
 
   double getScore(unsigned int tIdx,
 		  IndexT nodeIdx) const {
-    return decTree[tIdx].getScore(nodeIdx);
+    return compactTree[tIdx].isEmpty() ? decTree[tIdx].getScore(nodeIdx) : compactTree[tIdx].getScore(nodeIdx);
   }
 
 
+  size_t getNodeCount(unsigned int tIdx) const {
+    return compactTree[tIdx].isEmpty() ? decTree[tIdx].nodeCount() : compactTree[tIdx].nodeCount();
+  }
+
+
+  /**
+     @return offset of a node's true branch, else zero iff terminal.
+   */
+  IndexT getDelIdx(unsigned int tIdx,
+		   IndexT nodeIdx) const {
+    return compactTree[tIdx].isEmpty() ? decTree[tIdx].getDelIdx(nodeIdx) : compactTree[tIdx].getDelIdx(nodeIdx);
+  }
+
+
+  PredictorT getPredIdx(unsigned int tIdx,
+			IndexT nodeIdx) const {
+    return compactTree[tIdx].isEmpty() ? decTree[tIdx].getPredIdx(nodeIdx) : compactTree[tIdx].getPredIdx(nodeIdx);
+  }
+
+
+  /**
+     @brief Maps each node to the first node on its path, inclusive,
+     splitting on a given predictor.
+
+     @return per-node map if the tree splits on the predictor, else empty.
+   */
+  vector<IndexT> pathHeads(unsigned int tIdx,
+			   PredictorT predIdx) const;
+
+
   //  const struct Leaf* getLeaf() const;
   const Leaf& getLeaf() const {
     return leaf;
   }
 
+
+  const ScoreDesc& getScoreDesc() const {
+    return scoreDesc;
+  }
+
   
   /**
      @return vector of domininated leaf ranges, per node.
@@ -129,10 +237,29 @@ class Forest {
   static vector<IndexRange> leafDominators(const vector<DecNode>& tree);
 
 
+  /**
+     @brief As above, but from the true-branch offset of each node.
+   */
+  static vector<IndexRange> leafDominators(const vector<IndexT>& delIdx);
+
+
   /**
      @brief Computes a vector of leaf dominators for every tree.
+
+     Computed once per forest, as a loaded forest may predict repeatedly.
    */  
-  vector<vector<IndexRange>> leafDominators() const;
+  const vector<vector<IndexRange>>& leafDominators() const;
+
+
+  /**
+     @brief Builds the bitvector scorer on first request.
+
+     Rebuilds should the numeric predictor count differ from that
+     of the cached scorer.
+
+     @return bitvector scorer iff forest eligible, else null.
+   */
+  const QuickScorer* getQuickScorer(PredictorT nPredNum) const;
 
 
   /**
@@ -37,6 +37,10 @@
 #include <algorithm>
 
 
+const string ForestWeightR::strSparse = "sparse";
+const string ForestWeightR::strTopK = "topK";
+
+
 // [[Rcpp::export]]
 RcppExport SEXP forestWeightRcpp(const SEXP sTrain,
 				 const SEXP sSampler,
@@ -48,7 +52,7 @@ RcppExport SEXP forestWeightRcpp(const SEXP sTrain,
     Rcout << "Entering weighting" << endl;
 
   List lPredict(sPredict);
-  NumericMatrix summary(ForestWeightR::forestWeight(List(sTrain), List(sSampler), as<NumericMatrix>(lPredict["indices"]), List(sArgs)));
+  RObject summary(ForestWeightR::forestWeight(List(sTrain), List(sSampler), as<NumericMatrix>(lPredict["indices"]), List(sArgs)));
 
   if (verbose)
     Rcout << "Weighting completed" << endl;
@@ -57,19 +61,61 @@ RcppExport SEXP forestWeightRcpp(const SEXP sTrain,
 }
 
 
-// [[Rcpp::export]]
-NumericMatrix ForestWeightR::forestWeight(const List& lTrain,
-					  const List& lSampler,
-					  const NumericMatrix& indices,
-					  const List& lArgs) {
+SEXP ForestWeightR::forestWeight(const List& lTrain,
+				 const List& lSampler,
+				 const NumericMatrix& indices,
+				 const List& lArgs) {
   CoreBridge::init(as<unsigned>(lArgs[PredictR::strNThread]));
   ForestBridge::init(TrainR::nPred(lTrain));
   SamplerBridge samplerBridge(SamplerR::unwrapGeneric(lSampler));
-  return transpose(NumericMatrix(SamplerR::countObservations(lSampler),
-				 indices.nrow(),
-				 PredictBridge::forestWeight(ForestR::unwrap(lTrain, samplerBridge),
-							     samplerBridge,
-							     indices.begin(),
-							     indices.nrow()).begin()));
+  vector<size_t> rowStart;
+  vector<unsigned int> obsIdx;
+  vector<double> weight;
+  PredictBridge::forestWeight(ForestR::unwrap(lTrain, samplerBridge),
+			      samplerBridge,
+			      indices.begin(),
+			      indices.nrow(),
+			      as<unsigned int>(lArgs[strTopK]),
+			      rowStart,
+			      obsIdx,
+			      weight);
   ForestBridge::deInit();
+
+  size_t nTrain = SamplerR::countObservations(lSampler);
+  if (as<bool>(lArgs[strSparse]))
+    return sparse(nTrain, rowStart, obsIdx, weight);
+  else
+    return dense(nTrain, rowStart, obsIdx, weight);
+}
+
+
+NumericMatrix ForestWeightR::dense(size_t nTrain,
+				   const vector<size_t>& rowStart,
+				   const vector<unsigned int>& obsIdx,
+				   const vector<double>& weight) {
+  size_t nPredict = rowStart.size() - 1;
+  NumericMatrix weightOut(nPredict, nTrain);
+  for (size_t row = 0; row != nPredict; row++) {
+    for (size_t idx = rowStart[row]; idx != rowStart[row + 1]; idx++) {
+      weightOut(row, obsIdx[idx]) = weight[idx];
+    }
+  }
+  return weightOut;
+}
+
+
+List ForestWeightR::sparse(size_t nTrain,
+			   const vector<size_t>& rowStart,
+			   const vector<unsigned int>& obsIdx,
+			   const vector<double>& weight) {
+  IntegerVector obsOne(obsIdx.size());
+  for (size_t idx = 0; idx != obsIdx.size(); idx++) {
+    obsOne[idx] = obsIdx[idx] + 1;
+  }
+  List weightOut = List::create(_["rowStart"] = NumericVector(rowStart.begin(), rowStart.end()),
+				_["obsIdx"] = obsOne,
+				_["weight"] = NumericVector(weight.begin(), weight.end()),
+				_["dim"] = NumericVector::create(rowStart.size() - 1, nTrain));
+  weightOut.attr("class") = "ForestWeight";
+  return weightOut;
 }
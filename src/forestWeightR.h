@@ -29,6 +29,10 @@
 #include <Rcpp.h>
 using namespace Rcpp;
 
+#include <string>
+#include <vector>
+using namespace std;
+
 /**
    @brief Entry from R.
  */
@@ -39,15 +43,37 @@ RcppExport SEXP forestWeightRcpp(const SEXP sTrain,
 
 
 struct ForestWeightR {
+  static const string strSparse;
+  static const string strTopK;
+
   /**
      @brief Meinshausen's forest weights for multiple predictions.
 
-     @return matrix with rows of per-observation weights.
+     @return matrix with rows of per-observation weights or, if sparse,
+     its compressed row representation.
+   */
+  static SEXP forestWeight(const List& lTrain,
+			   const List& lSampler,
+			   const NumericMatrix& indices,
+			   const List& lArgs);
+
+
+  /**
+     @brief Expands compressed rows into a dense matrix.
+   */
+  static NumericMatrix dense(size_t nTrain,
+			     const vector<size_t>& rowStart,
+			     const vector<unsigned int>& obsIdx,
+			     const vector<double>& weight);
+
+
+  /**
+     @brief Wraps compressed rows, with one-based column indices.
    */
-  static NumericMatrix forestWeight(const List& lTrain,
-				    const List& lSampler,
-				    const NumericMatrix& indices,
-				    const List& lArgs);
+  static List sparse(size_t nTrain,
+		     const vector<size_t>& rowStart,
+		     const vector<unsigned int>& obsIdx,
+		     const vector<double>& weight);
 };
 
 #endif
@@ -16,6 +16,7 @@
 #include "forest.h"
 #include "dectree.h"
 #include "forestbridge.h"
+#include "forestcode.h"
 #include "samplerbridge.h"
 #include "typeparam.h"
 #include "bv.h"
@@ -92,3 +93,11 @@ void ForestBridge::dump(vector<vector<unsigned int> >& predTree,
 }
 
     
+
+
+string ForestBridge::emitCode(unsigned int nPredNum,
+			      const vector<unsigned int>& facCard,
+			      const vector<string>& predName,
+			      const string& name) const {
+  return ForestCode::emit(forest.get(), nPredNum, facCard, predName, name);
+}
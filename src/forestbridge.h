@@ -20,6 +20,7 @@
 #include <vector>
 #include <memory>
 #include <complex>
+#include <string>
 
 using namespace std;
 
@@ -121,6 +122,25 @@ struct ForestBridge {
             vector<vector<size_t> >& lhDelTree,
             vector<vector<unsigned char> >& facSplitTree,
 	    vector<vector<double>>& scoreTree) const;
+
+
+  /**
+     @brief Renders the forest as specialized C++ source.
+
+     @param nPredNum is the number of numeric predictors.
+
+     @param facCard are the training cardinalities, per factor.
+
+     @param predName are the predictor names, in core order.
+
+     @param name is the namespace enclosing the generated code.
+
+     @return generated source text.
+   */
+  string emitCode(unsigned int nPredNum,
+		  const vector<unsigned int>& facCard,
+		  const vector<string>& predName,
+		  const string& name) const;
   
 private:
 
@@ -0,0 +1,257 @@
+// This file is part of ArboristCore.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file forestcode.cc
+
+   @brief Methods emitting a forest as specialized C++ source.
+
+   @author Mark Seligman
+ */
+
+#include "forestcode.h"
+#include "forest.h"
+#include "dectree.h"
+#include "bv.h"
+
+#include <cmath>
+#include <cstdio>
+
+
+ForestCode::ForestCode(const Forest* forest_,
+		       PredictorT nPredNum_,
+		       const vector<unsigned int>& facCard_,
+		       const vector<string>& predName_) :
+  forest(forest_),
+  nPredNum(nPredNum_),
+  facCard(facCard_),
+  predName(predName_),
+  nCtg(0) {
+}
+
+
+string ForestCode::emit(const Forest* forest,
+			PredictorT nPredNum,
+			const vector<unsigned int>& facCard,
+			const vector<string>& predName,
+			const string& name) {
+  ForestCode code(forest, nPredNum, facCard, predName);
+  code.emitHead(name);
+  for (unsigned int tIdx = 0; tIdx != forest->getNTree(); tIdx++) {
+    const DecTree tree = forest->getDecTree(tIdx); // Expanded once per tree.
+    code.emitBits(tree, tIdx);
+    code.emitTree(tree, tIdx);
+    code.nCtg = max(code.nCtg, code.ctgWidth(tree));
+  }
+  code.emitForest(name);
+
+  return code.out.str();
+}
+
+
+string ForestCode::literal(double val) {
+  if (isnan(val))
+    return "NAN";
+  else if (isinf(val))
+    return val > 0 ? "HUGE_VAL" : "-HUGE_VAL";
+
+  char buf[40];
+  snprintf(buf, sizeof(buf), "%a", val);
+  return string(buf);
+}
+
+
+void ForestCode::emitHead(const string& name) {
+  PredictorT nPredFac = facCard.size();
+  out << "// Generated from a trained Arborist forest:  do not edit.\n//\n";
+  out << "// Numeric predictors, num[]:\n";
+  for (PredictorT numIdx = 0; numIdx != nPredNum; numIdx++) {
+    out << "//   num[" << numIdx << "]" << nameString(numIdx) << "\n";
+  }
+  out << "// Factor predictors, fac[], as zero-based training codes:\n";
+  for (PredictorT facIdx = 0; facIdx != nPredFac; facIdx++) {
+    out << "//   fac[" << facIdx << "]" << nameString(nPredNum + facIdx) << ", " << facCard[facIdx] << " levels\n";
+  }
+
+  out << "\n#include <cmath>\n#include <cstddef>\n#include <cstdint>\n\n";
+  out << "namespace " << name << " {\n\n";
+  out << "constexpr unsigned int nTree = " << forest->getNTree() << ";\n";
+  out << "constexpr unsigned int nPredNum = " << nPredNum << ";\n";
+  out << "constexpr unsigned int nPredFac = " << nPredFac << ";\n";
+  if (nPredFac > 0) {
+    out << "constexpr unsigned int facCard[nPredFac] = {";
+    for (PredictorT facIdx = 0; facIdx != nPredFac; facIdx++) {
+      out << (facIdx == 0 ? "" : ", ") << facCard[facIdx];
+    }
+    out << "};\n";
+  }
+  out << "\ninline bool testBit(const std::uint64_t bits[], std::size_t pos) {\n";
+  out << "  return (bits[pos >> 6] >> (pos & 63)) & 1u;\n}\n\n";
+}
+
+
+string ForestCode::nameString(PredictorT predIdx) const {
+  return predIdx < predName.size() ? "  " + predName[predIdx] : "";
+}
+
+
+void ForestCode::emitBits(const DecTree& tree,
+			  unsigned int tIdx) {
+  const BV& facSplit = tree.getFacSplit();
+  size_t nBit = facSplit.getNSlot() * BV::getSlotElts();
+  if (nBit == 0)
+    return;
+
+  // Repacks as 64-bit words, independent of the native slot width.
+  vector<uint64_t> word((nBit + 63) / 64);
+  for (size_t bit = 0; bit != nBit; bit++) {
+    if (facSplit.testBit(bit))
+      word[bit / 64] |= uint64_t(1) << (bit % 64);
+  }
+
+  out << "static const std::uint64_t facSplit" << tIdx << "[] = {";
+  for (size_t wordIdx = 0; wordIdx != word.size(); wordIdx++) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "0x%016llxull", static_cast<unsigned long long>(word[wordIdx]));
+    out << (wordIdx == 0 ? "" : ",") << (wordIdx % 4 == 0 ? "\n  " : " ") << buf;
+  }
+  out << "\n};\n\n";
+}
+
+
+void ForestCode::emitTree(const DecTree& tree,
+			  unsigned int tIdx) {
+  out << "inline double tree" << tIdx << "(const double num[], const unsigned int fac[], unsigned int& nodeIdx) {\n";
+  out << "  (void) num; (void) fac;\n";
+  vector<IndexT> deferred;
+  emitNode(tree, tIdx, 0, 1, deferred);
+  for (size_t defIdx = 0; defIdx != deferred.size(); defIdx++) {
+    IndexT nodeIdx = deferred[defIdx];
+    out << " n" << nodeIdx << ":\n";
+    emitNode(tree, tIdx, nodeIdx, 1, deferred);
+  }
+  out << "}\n\n";
+}
+
+
+void ForestCode::emitNode(const DecTree& tree,
+			  unsigned int tIdx,
+			  IndexT nodeIdx,
+			  unsigned int depth,
+			  vector<IndexT>& deferred) {
+  // False branches continue at the same depth, as true branches return.
+  IndexT delIdx;
+  while ((delIdx = tree.getDelIdx(nodeIdx)) != 0) {
+    if (depth > nestMax) {
+      out << indent(depth) << "goto n" << nodeIdx << ";\n";
+      deferred.push_back(nodeIdx);
+      return;
+    }
+    out << indent(depth) << "if (" << testString(tree, tIdx, nodeIdx) << ") {\n";
+    emitNode(tree, tIdx, nodeIdx + delIdx, depth + 1, deferred);
+    out << indent(depth) << "}\n";
+    nodeIdx += delIdx + 1;
+  }
+  out << indent(depth) << "nodeIdx = " << nodeIdx << "; return " << literal(tree.getScore(nodeIdx)) << ";\n";
+}
+
+
+string ForestCode::testString(const DecTree& tree,
+			      unsigned int tIdx,
+			      IndexT nodeIdx) const {
+  const DecNode& node = tree.getNode()[nodeIdx];
+  PredictorT predIdx = node.getPredIdx();
+  ostringstream test;
+  if (predIdx < nPredNum) {
+    // Inverted tests route missing values to the true branch.
+    string val = "num[" + to_string(predIdx) + "]";
+    string split = literal(node.getSplitNum());
+    if (node.getInvert())
+      test << "!(" << val << " > " << split << ")";
+    else
+      test << val << " <= " << split;
+  }
+  else {
+    test << "testBit(facSplit" << tIdx << ", " << node.getBitOffset() << "u + fac[" << predIdx - nPredNum << "])";
+  }
+  return test.str();
+}
+
+
+unsigned int ForestCode::ctgWidth(const DecTree& tree) const {
+  unsigned int width = 0;
+  for (IndexT nodeIdx = 0; nodeIdx != tree.nodeCount(); nodeIdx++) {
+    if (tree.getDelIdx(nodeIdx) == 0)
+      width = max(width, static_cast<unsigned int>(floor(tree.getScore(nodeIdx))) + 1);
+  }
+  return width;
+}
+
+
+void ForestCode::emitForest(const string& name) {
+  unsigned int nTree = forest->getNTree();
+  out << "/**\n   Walks every tree, reporting terminal indices and scores.\n\n";
+  out << "   Factor codes exceeding the training cardinality map to the proxy.\n */\n";
+  out << "inline void walk(const double num[], const unsigned int fac[], unsigned int nodeIdx[], double score[]) {\n";
+  string facArg = "fac";
+  if (!facCard.empty()) {
+    out << "  unsigned int code[nPredFac];\n";
+    out << "  for (unsigned int k = 0; k != nPredFac; k++)\n";
+    out << "    code[k] = fac[k] < facCard[k] ? fac[k] : facCard[k];\n";
+    facArg = "code";
+  }
+  for (unsigned int tIdx = 0; tIdx != nTree; tIdx++) {
+    out << "  score[" << tIdx << "] = tree" << tIdx << "(num, " << facArg << ", nodeIdx[" << tIdx << "]);\n";
+  }
+  out << "}\n\n";
+
+  out << "/**\n   Scores a single observation:  categorical forests return the\n";
+  out << "   predicted category index.\n */\n";
+  out << "inline double predict(const double num[], const unsigned int fac[]) {\n";
+  out << "  unsigned int nodeIdx[nTree];\n  double score[nTree];\n";
+  out << "  walk(num, fac, nodeIdx, score);\n";
+  emitScorer();
+  out << "}\n\n} // namespace " << name << "\n";
+}
+
+
+void ForestCode::emitScorer() {
+  const ScoreDesc& scoreDesc = forest->getScoreDesc();
+  // Accumulation order and arithmetic follow ForestPrediction.
+  if (scoreDesc.scorer == "sum" || scoreDesc.scorer == "logistic") {
+    out << "  constexpr double nu = " << literal(scoreDesc.nu) << ";\n";
+    out << "  double sumScore = " << literal(scoreDesc.baseScore) << ";\n";
+    out << "  for (unsigned int t = 0; t != nTree; t++)\n";
+    out << "    sumScore += nu * score[t];\n";
+    if (scoreDesc.scorer == "sum") {
+      out << "  return sumScore;\n";
+    }
+    else {
+      out << "  double p1 = 1.0 / (1.0 + std::exp(-sumScore));\n";
+      out << "  return p1 > 0.5 ? 1 : 0;\n";
+    }
+  }
+  else if (scoreDesc.scorer == "plurality") {
+    out << "  constexpr unsigned int nCtg = " << nCtg << ";\n";
+    out << "  unsigned int census[nCtg] = {};\n  double ctgJitter[nCtg] = {};\n";
+    out << "  for (unsigned int t = 0; t != nTree; t++) {\n";
+    out << "    unsigned int ctg = std::floor(score[t]);\n";
+    out << "    census[ctg]++;\n    ctgJitter[ctg] += score[t] - ctg;\n  }\n";
+    out << "  double scale = 1.0 / (2 * nTree);\n";
+    out << "  unsigned int argMax = 0;\n  double valMax = 0.0;\n";
+    out << "  for (unsigned int ctg = 0; ctg != nCtg; ctg++) {\n";
+    out << "    double numVal = census[ctg] + ctgJitter[ctg] * scale;\n";
+    out << "    if (numVal > valMax) {\n      valMax = numVal;\n      argMax = ctg;\n    }\n  }\n";
+    out << "  return argMax;\n";
+  }
+  else { // "mean"
+    out << "  double sumScore = 0.0;\n";
+    out << "  for (unsigned int t = 0; t != nTree; t++)\n";
+    out << "    sumScore += score[t];\n";
+    out << "  return sumScore / nTree;\n";
+  }
+}
@@ -0,0 +1,165 @@
+// This file is part of ArboristCore.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file forestcode.h
+
+   @brief Emits a trained forest as specialized C++ source.
+
+   @author Mark Seligman
+ */
+
+#ifndef FOREST_FORESTCODE_H
+#define FOREST_FORESTCODE_H
+
+#include "typeparam.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class Forest;
+class DecTree;
+
+
+/**
+   @brief Renders each tree as straight-line nested comparisons.
+
+   Split values are emitted as exact hexadecimal literals and factor
+   splits as static bit arrays, so that the generated walk reproduces
+   the core walk node-for-node.  Unobserved values are not trapped:
+   missing numeric values follow the node's inversion sense and
+   unseen factor levels map to the proxy code, as in the untrapped
+   core walk.
+
+   The generated namespace exports walk(), reporting the terminal index
+   and score for each tree, and predict(), applying the forest scorer.
+   Numeric inputs are ordered as the core numeric predictors.  Factor
+   inputs are zero-based training codes, in core factor order.
+ */
+class ForestCode {
+  static constexpr unsigned int nestMax = 48; ///< Deeper subtrees are labelled.
+
+  const Forest* forest;
+  const PredictorT nPredNum; ///< # numeric predictors.
+  const vector<unsigned int> facCard; ///< Per-factor training cardinality.
+  const vector<string> predName; ///< Core-ordered names; possibly empty.
+  ostringstream out; ///< Accumulates source text.
+  unsigned int nCtg; ///< Largest category encoded by a leaf score, plus one.
+
+
+  ForestCode(const Forest* forest_,
+	     PredictorT nPredNum_,
+	     const vector<unsigned int>& facCard_,
+	     const vector<string>& predName_);
+
+
+  /**
+     @brief Emits the prologue:  predictor legend, counts and helpers.
+   */
+  void emitHead(const string& name);
+
+
+  /**
+     @return annotation naming a core predictor, if known.
+   */
+  string nameString(PredictorT predIdx) const;
+
+
+  /**
+     @brief Emits the factor bits of a tree, if any, as a static array.
+   */
+  void emitBits(const DecTree& tree,
+		unsigned int tIdx);
+
+
+  /**
+     @brief Emits the function walking a single tree.
+   */
+  void emitTree(const DecTree& tree,
+		unsigned int tIdx);
+
+
+  /**
+     @brief Emits a subtree, labelling descendants nested too deeply.
+
+     @param depth is the current nesting depth.
+
+     @param[in, out] deferred accumulates labelled subtree roots.
+   */
+  void emitNode(const DecTree& tree,
+		unsigned int tIdx,
+		IndexT nodeIdx,
+		unsigned int depth,
+		vector<IndexT>& deferred);
+
+
+  /**
+     @return source text of the test routing to the true branch.
+   */
+  string testString(const DecTree& tree,
+		    unsigned int tIdx,
+		    IndexT nodeIdx) const;
+
+
+  /**
+     @brief Emits the forest-wide walk and scoring functions.
+   */
+  void emitForest(const string& name);
+
+
+  /**
+     @brief Emits the scoring body appropriate to the forest scorer.
+   */
+  void emitScorer();
+
+
+  /**
+     @return largest category index encoded by a leaf score of a
+     tree, plus one.
+   */
+  unsigned int ctgWidth(const DecTree& tree) const;
+
+
+  /**
+     @return indentation string for a given depth.
+   */
+  static string indent(unsigned int depth) {
+    return string(2 * depth, ' ');
+  }
+
+public:
+
+  /**
+     @brief Renders the forest as a self-contained translation unit.
+
+     @param nPredNum_ is the number of numeric predictors.
+
+     @param facCard_ are the training cardinalities, per factor.
+
+     @param predName_ are core-ordered predictor names, for annotation.
+
+     @param name is the namespace enclosing the generated code.
+
+     @return generated source text.
+   */
+  static string emit(const Forest* forest,
+		     PredictorT nPredNum_,
+		     const vector<unsigned int>& facCard_,
+		     const vector<string>& predName_,
+		     const string& name);
+
+
+  /**
+     @return exact, round-trippable literal for a double.
+   */
+  static string literal(double val);
+};
+
+#endif
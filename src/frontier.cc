@@ -25,47 +25,65 @@
 #include "branchsense.h"
 #include "sampler.h"
 #include "grove.h"
+#include "prng.h"
+#include "finisher.h"
 
 
 unsigned int Frontier::totLevels = 0;
+IndexT Frontier::finishNode = 0;
+bool Frontier::extraTrees = false;
 
-void Frontier::immutables(unsigned int totLevels) {
+void Frontier::immutables(unsigned int totLevels,
+			  IndexT finishNode,
+			  bool extraTrees) {
   Frontier::totLevels = totLevels;
+  Frontier::finishNode = finishNode;
+  Frontier::extraTrees = extraTrees;
 }
 
 
 void Frontier::deInit() {
   totLevels = 0;
+  finishNode = 0;
+  extraTrees = false;
 }
 
 
 unique_ptr<PreTree> Frontier::oneTree(const PredictorFrame* frame,
-				      const Grove* train,
+				      Grove* grove,
 				      const Sampler* sampler,
 				      unsigned int tIdx) {
-  Frontier frontier(frame, train, sampler, tIdx);
+  Frontier frontier(frame, grove, sampler, tIdx);
   SampleMap smNonTerm = frontier.produceRoot(frame);
   return frontier.splitByLevel(smNonTerm);
 }
 
 
 Frontier::Frontier(const PredictorFrame* frame_,
-		   const Grove* grove,
+		   Grove* grove_,
 		   const Sampler* sampler,
-		   unsigned int tIdx) :
+		   unsigned int tIdx_) :
   frame(frame_),
-  scorer(grove->getNodeScorer()),
+  tIdx(tIdx_),
+  grove(grove_),
+  scorer(NodeScorer::makeScorer()),
   sampledObs(sampler->makeObs(tIdx)),
   bagCount(sampledObs->getBagCount()),
   nCtg(sampledObs->getNCtg()),
-  interLevel(make_unique<InterLevel>(frame, sampledObs.get(), this)),
+  obsPart(grove->acquireObsPart(frame, bagCount)),
+  interLevel(make_unique<InterLevel>(frame, sampledObs.get(), this, obsPart.get())),
   pretree(make_unique<PreTree>(frame, bagCount)),
   smTerminal(SampleMap(bagCount)) {
 }
 
 
+Frontier::~Frontier() {
+  grove->releaseObsPart(std::move(obsPart));
+}
+
+
 SampleMap Frontier::produceRoot(const PredictorFrame* frame) {
-  sampledObs->sampleRoot(frame, scorer);
+  sampledObs->sampleRoot(frame, scorer.get());
   pretree->offspring(0, true);
   frontierNodes.emplace_back(sampledObs.get());
 
@@ -73,30 +91,42 @@ SampleMap Frontier::produceRoot(const PredictorFrame* frame) {
   smNonterm.addNode(bagCount, 0);
   iota(smNonterm.sampleIndex.begin(), smNonterm.sampleIndex.end(), 0);
 
+  // The subspace is drawn from the tree's root stream.
+  PRNG::setStream(tIdx);
+  predSpace = CandType::treeSpace(frame->getNPred());
+  spaceProb = CandType::spaceProb(predSpace);
+
   return smNonterm;
 }
 
 
 unique_ptr<PreTree> Frontier::splitByLevel(SampleMap& smNonterm) {
   while (!frontierNodes.empty()) {
-    smNonterm = splitDispatch(smNonterm);
+    SampleMap smNext = splitDispatch(smNonterm);
+    indexSpare = std::move(smNonterm.sampleIndex);
+    smNonterm = std::move(smNext);
     vector<IndexSet> frontierNext = produceLevel();
     interLevel->overlap(frontierNodes, frontierNext, smNonterm.getEndIdx());
     frontierNodes = std::move(frontierNext);
   }
   pretree->setTerminals(sampledObs.get(), std::move(smTerminal));
+  pretree->setRestageVolume(interLevel->getRestageVolume());
 
   return std::move(pretree);
 }
 
 
 SampleMap Frontier::splitDispatch(const SampleMap& smNonterm) {
+  // Each level draws from its own stream.
+  PRNG::setStream(tIdx, interLevel->getLevel());
+
   // The current frontier can be scored as soon as its nodes are in
   // place.
   scorer->frontierPreamble(this);
 
   earlyExit(interLevel->getLevel());
-  CandType cand = interLevel->repartition(this);
+  vector<IndexT> finishIdx = scheduleFinish();
+  CandType cand = interLevel->repartition(this, smNonterm);
   splitFrontier = SplitFactoryT::factory(this);
 
   BranchSense branchSense(bagCount);
@@ -113,6 +143,7 @@ SampleMap Frontier::splitDispatch(const SampleMap& smNonterm) {
       pretree->setScore(iSet, scorer->score(smNonterm, iSet));
     }
   }
+  finish(finishIdx);
 
   return smNext;
 }
@@ -127,9 +158,68 @@ void Frontier::earlyExit(unsigned int level) {
 }
 
 
+vector<IndexT> Frontier::scheduleFinish() {
+  vector<IndexT> finishIdx;
+  if (finishNode == 0 && !extraTrees)
+    return finishIdx;
+
+  // Random cuts require no sorted cells, so all nodes finish.
+  for (IndexT splitIdx = 0; splitIdx != frontierNodes.size(); splitIdx++) {
+    IndexSet& iSet = frontierNodes[splitIdx];
+    if (!iSet.isUnsplitable() && (extraTrees || iSet.getExtent() < finishNode)) {
+      iSet.setUnsplitable();
+      finishIdx.push_back(splitIdx);
+    }
+  }
+
+  return finishIdx;
+}
+
+
+void Frontier::finish(const vector<IndexT>& finishIdx) {
+  if (finishIdx.empty())
+    return;
+
+  vector<Finisher> finisher;
+  for (IndexT splitIdx : finishIdx) {
+    finisher.emplace_back(this, frontierNodes[splitIdx], smTerminal, interLevel->getLevel());
+  }
+
+#pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
+  {
+#pragma omp for schedule(dynamic, 1)
+    for (OMPBound finIdx = 0; finIdx < finisher.size(); finIdx++) {
+      finisher[finIdx].grow(tIdx, totLevels);
+    }
+  }
+
+  // Terminals registered at this level trail the map, in frontier
+  // order.  Each finished node's range is replaced by its leaves'.
+  IndexT termStart = frontierNodes[finishIdx.front()].getIdxNext();
+  vector<IndexRange> rangeTail(smTerminal.range.begin() + termStart, smTerminal.range.end());
+  vector<IndexT> ptTail(smTerminal.ptIdx.begin() + termStart, smTerminal.ptIdx.end());
+  smTerminal.range.resize(termStart);
+  smTerminal.ptIdx.resize(termStart);
+  auto fin = finisher.begin();
+  auto finIdx = finishIdx.begin();
+  for (IndexT termIdx = termStart; termIdx != termStart + rangeTail.size(); termIdx++) {
+    if (finIdx != finishIdx.end() && frontierNodes[*finIdx].getIdxNext() == termIdx) {
+      (fin++)->graft(pretree.get(), smTerminal);
+      finIdx++;
+    }
+    else {
+      smTerminal.range.push_back(rangeTail[termIdx - termStart]);
+      smTerminal.ptIdx.push_back(ptTail[termIdx - termStart]);
+    }
+  }
+}
+
+
 vector<IndexSet> Frontier::produceLevel() {
   vector<IndexSet> frontierNext;
-  for (auto iSet : frontierNodes) {
+  frontierNext.reserve(2 * count_if(frontierNodes.begin(), frontierNodes.end(),
+				    [](const IndexSet& iSet) { return !iSet.isTerminal(); }));
+  for (const IndexSet& iSet : frontierNodes) {
     if (!iSet.isTerminal()) {
       frontierNext.emplace_back(this, iSet, true);
       frontierNext.emplace_back(this, iSet, false);
@@ -146,7 +236,10 @@ SampleMap Frontier::surveySplits() {
     registerSplit(iSet, smNext);
   }
 
-  smNext.sampleIndex = vector<IndexT>(smNext.getEndIdx());
+  // Nonterminal extents only shrink, so the previous level's storage
+  // suffices.  Contents are overwritten as the map is updated.
+  smNext.sampleIndex = std::move(indexSpare);
+  smNext.sampleIndex.resize(smNext.getEndIdx());
 
   return smNext;
 }
@@ -217,7 +310,7 @@ vector<double> Frontier::sumsAndSquares(vector<vector<double> >& ctgSum) {
 
 
 SplitNux Frontier::candMax(IndexT splitIdx,
-			   const vector<SplitNux>& candV) const {
+			   const ArenaVec<SplitNux>& candV) const {
   return frontierNodes[splitIdx].candMax(candV);
 }
 
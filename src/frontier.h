@@ -33,18 +33,26 @@
  */
 class Frontier {
   static unsigned int totLevels;
+  static IndexT finishNode; ///< Nodes below this extent finish depth-first.
+  static bool extraTrees; ///< Whether cuts are drawn at random, all nodes finishing depth-first.
   const class PredictorFrame* frame;
-  struct NodeScorer* scorer;
+  const unsigned int tIdx; ///< Selects the tree's PRNG stream.
+  class Grove* grove; ///< Owns the workspace pool.
+  const unique_ptr<struct NodeScorer> scorer; ///< Per-tree, as trees may train concurrently.
   unique_ptr<class SampledObs> sampledObs;
   const IndexT bagCount;
   const PredictorT nCtg;
+  vector<PredictorT> predSpace; ///< Predictors eligible for splitting.
+  vector<double> spaceProb; ///< Selection probabilities, by subspace position.
 
   vector<IndexSet> frontierNodes; ///< Splitable nodes within a level.
+  unique_ptr<class ObsPart> obsPart; ///< Pooled; returned on destruction.
   unique_ptr<class InterLevel> interLevel;
 
   unique_ptr<PreTree> pretree; // Augmented per frontier.
   
   SampleMap smTerminal; ///< Persistent terminal sample mapping:  crescent.
+  vector<IndexT> indexSpare; ///< Previous level's sample indices, recycled.
 
   unique_ptr<class SplitFrontier> splitFrontier; // Per-level.
 
@@ -92,6 +100,25 @@ class Frontier {
    */
   void earlyExit(unsigned int level);
 
+
+  /**
+     @brief Withdraws small nodes from level-wide splitting.
+
+     Withdrawn nodes are registered as terminal and subsequently
+     finished depth-first.  All nodes are withdrawn if cuts are random.
+
+     @return level-relative indices of the nodes withdrawn.
+   */
+  vector<IndexT> scheduleFinish();
+
+
+  /**
+     @brief Grows a subtree from each withdrawn node and grafts it onto the pretree.
+
+     @param finishIdx are the level-relative indices of the nodes.
+   */
+  void finish(const vector<IndexT>& finishIdx);
+
   
 public:
 
@@ -102,8 +129,22 @@ public:
      @param minNode_ is the minimum node size for splitting.
 
      @param totLevels_ is the maximum number of levels to evaluate.
+
+     @param finishNode is the node extent below which splitting proceeds depth-first, if nonzero.
+
+     @param extraTrees is true iff splitting evaluates a single random cut per candidate.
   */
-  static void immutables(unsigned int totLevels);
+  static void immutables(unsigned int totLevels,
+			 IndexT finishNode,
+			 bool extraTrees);
+
+
+  /**
+     @return true iff candidates are split at random cuts.
+   */
+  static bool randomCuts() {
+    return extraTrees;
+  }
 
 
   /**
@@ -116,10 +157,16 @@ public:
      @brief Per-tree constructor.  Sets up root node for level zero.
   */
   Frontier(const class PredictorFrame* frame,
-	   const class Grove* train,
+	   class Grove* grove,
 	   const class Sampler* sampler,
 	   unsigned int tIdx);
 
+
+  /**
+     @brief Returns the observation partition to the pool.
+   */
+  ~Frontier();
+
   
   /**
     @brief Groves one tree.
@@ -131,7 +178,7 @@ public:
     @return trained pretree object.
   */
   static unique_ptr<class PreTree> oneTree(const class PredictorFrame* frame,
-					   const class Grove* train,
+					   class Grove* grove,
 					   const class Sampler* sampler,
 					   unsigned int tIdx);
 
@@ -232,7 +279,7 @@ public:
      @return maximal- or zero-information candidate for split.
    */
   class SplitNux candMax(IndexT splitIdx,
-			 const vector<class SplitNux>& candV) const;
+			 const ArenaVec<class SplitNux>& candV) const;
 
 
   IndexRange getNodeRange(IndexT nodeIdx) const {
@@ -248,6 +295,32 @@ public:
   auto getFrame() const {
     return frame;
   }
+
+
+  const class SampledObs* getSampledObs() const {
+    return sampledObs.get();
+  }
+
+
+  /**
+     @return predictors eligible for splitting within the tree.
+   */
+  const vector<PredictorT>& getPredSpace() const {
+    return predSpace;
+  }
+
+
+  /**
+     @return Bernoulli selection probabilities, by subspace position.
+   */
+  const vector<double>& getSpaceProb() const {
+    return spaceProb;
+  }
+
+
+  const struct NodeScorer* getScorer() const {
+    return scorer.get();
+  }
   
 
   /**
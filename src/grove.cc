@@ -20,7 +20,9 @@
 #include "pretree.h"
 #include "leaf.h"
 #include "sampler.h"
-#include "nodescorer.h"
+#include "booster.h"
+#include "ompthread.h"
+#include "partition.h"
 
 #include <algorithm>
 
@@ -44,20 +46,55 @@ void Grove::deInit() {
 Grove::Grove(const PredictorFrame* frame,
 	     const IndexRange& range) :
   forestRange(range),
-  nodeScorer(NodeScorer::makeScorer()),
   predInfo(vector<double>(frame->getNPred())),
   nodeCresc(make_unique<NodeCresc>()),
   fbCresc(make_unique<FBCresc>()) {
 }
 
 
+Grove::~Grove() = default;
+
+
+unique_ptr<ObsPart> Grove::acquireObsPart(const PredictorFrame* frame,
+					  IndexT bagCount) {
+  unique_ptr<ObsPart> obsPart;
+#pragma omp critical(obsPool)
+  {
+    if (!obsPool.empty()) {
+      obsPart = std::move(obsPool.back());
+      obsPool.pop_back();
+    }
+  }
+
+  if (obsPart == nullptr) {
+    return make_unique<ObsPart>(frame, bagCount);
+  }
+  else {
+    obsPart->reset(frame, bagCount);
+    return obsPart;
+  }
+}
+
+
+void Grove::releaseObsPart(unique_ptr<ObsPart> obsPart) {
+#pragma omp critical(obsPool)
+  {
+    obsPool.push_back(std::move(obsPart));
+  }
+}
+
+
 void Grove::train(const PredictorFrame* frame,
 		  const Sampler * sampler,
 		  Leaf* leaf) {
-  for (unsigned treeStart = forestRange.getStart(); treeStart < forestRange.getEnd(); treeStart += trainBlock) {
-    auto treeBlock = blockProduce(frame, sampler, treeStart, min(treeStart + trainBlock, static_cast<unsigned int>(forestRange.getEnd())));
+  // Random-cut trees grow depth-first from the root, on a single
+  // thread apiece, so are blocked at least as widely as the threads.
+  unsigned int blockSize = Frontier::randomCuts() ? max(trainBlock, OmpThread::getNThread()) : trainBlock;
+  for (unsigned treeStart = forestRange.getStart(); treeStart < forestRange.getEnd(); treeStart += blockSize) {
+    auto treeBlock = blockProduce(frame, sampler, treeStart, min(treeStart + blockSize, static_cast<unsigned int>(forestRange.getEnd())));
     blockConsume(treeBlock, leaf);
   }
+  obsPool.clear(); // Workspace not needed beyond training.
   splitUpdate(frame);
 }
 
@@ -75,10 +112,29 @@ vector<unique_ptr<PreTree>> Grove::blockProduce(const PredictorFrame* frame,
 						const Sampler* sampler,
 						unsigned int treeStart,
 						unsigned int treeEnd) {
-  vector<unique_ptr<PreTree>> block;
-  for (unsigned int tIdx = treeStart; tIdx < treeEnd; tIdx++) {
-    block.emplace_back(Frontier::oneTree(frame, this, sampler, tIdx));
+  vector<unique_ptr<PreTree>> block(treeEnd - treeStart);
+  // Boosted trees depend upon their predecessors' estimates.
+  unsigned int nConcurrent = Booster::boosting() ? 1 : min(OmpThread::getNThread(), treeEnd - treeStart);
+  if (nConcurrent <= 1) {
+    for (unsigned int tIdx = treeStart; tIdx < treeEnd; tIdx++) {
+      block[tIdx - treeStart] = Frontier::oneTree(frame, this, sampler, tIdx);
+    }
+    return block;
+  }
+
+  // Each tree trains over its own workspace, with level-wide regions
+  // confined to a team of the partitioned threads.
+  unsigned int nTeam = OmpThread::partition(nConcurrent);
+#pragma omp parallel default(shared) num_threads(nConcurrent)
+  {
+    OmpThread::setTeam(nTeam);
+#pragma omp for schedule(dynamic, 1)
+  for (OMPBound tIdx = treeStart; tIdx < treeEnd; tIdx++) {
+    block[tIdx - treeStart] = Frontier::oneTree(frame, this, sampler, tIdx);
+  }
+    OmpThread::setTeam(0);
   }
+  OmpThread::unpartition();
 
   return block;
 }
@@ -101,6 +157,16 @@ void Grove::consumeInfo(const vector<double>& info) {
 }
 
 
+void Grove::consumeRestage(const vector<size_t>& volume) {
+  if (restageVolume.empty()) {
+    restageVolume = vector<size_t>(volume.size());
+  }
+  for (unsigned int cause = 0; cause < volume.size(); cause++) {
+    restageVolume[cause] += volume[cause];
+  }
+}
+
+
 size_t Grove::getNodeCount() const {
   return scoresCresc.size();
 }
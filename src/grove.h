@@ -142,10 +142,11 @@ public:
 */
 class Grove {
   static bool thinLeaves; ///< True iff leaves not cached.
-  static unsigned int trainBlock; ///< Front-end defined buffer size. Unused.
+  static unsigned int trainBlock; ///< # trees trained concurrently.
   const IndexRange forestRange; ///< Coordinates within forest.
-  const unique_ptr<struct NodeScorer> nodeScorer; ///< Belongs elsewhere.
   vector<double> predInfo; ///< E.g., Gini gain:  nPred.
+  vector<size_t> restageVolume; ///< # observations restaged, by cause.
+  vector<unique_ptr<class ObsPart>> obsPool; ///< Idle partitions, retained across trees.
   
   unique_ptr<NodeCresc> nodeCresc; ///< Crescent node block.
   unique_ptr<FBCresc> fbCresc; ///< Crescent factor-summary block.
@@ -160,6 +161,27 @@ public:
 	const IndexRange& range);
 
 
+  ~Grove();
+
+
+  /**
+     @brief Lends an observation partition sized for a bag.
+
+     Partitions are pooled, so that at most one is allocated per
+     concurrently-trained tree.
+
+     @return idle partition, if any, else a new one.
+   */
+  unique_ptr<class ObsPart> acquireObsPart(const class PredictorFrame* frame,
+					   IndexT bagCount);
+
+
+  /**
+     @brief Returns a partition to the pool.
+   */
+  void releaseObsPart(unique_ptr<class ObsPart> obsPart);
+
+
   void train(const class PredictorFrame* frame,
 	     const class Sampler* sampler,
 	     struct Leaf* leaf);
@@ -216,6 +238,16 @@ public:
   }
 
 
+  /**
+     @brief Getter for restaging tally, ordered as RestageCause.
+
+     @return reference to per-cause observation counts.
+   */
+  const vector<size_t>& getRestageVolume() const {
+    return restageVolume;
+  }
+
+
   static void init(bool thinLeaves_,
 		   unsigned int trainBlock_);
 
@@ -238,7 +270,10 @@ public:
   /**
      @brief  Creates a block of root samples and trains each one.
 
-     @return Wrapped collection of Sample, PreTree pairs.
+     Trees train concurrently unless boosting, as each owns its
+     workspace and PRNG stream.
+
+     @return Wrapped collection of Sample, PreTree pairs, in tree order.
   */
   vector<unique_ptr<class PreTree>> blockProduce(const class PredictorFrame* frame,
 					   const class Sampler* sampler,
@@ -251,9 +286,12 @@ public:
   void consumeInfo(const vector<double>& info);
 
 
-  struct NodeScorer* getNodeScorer() const {
-    return nodeScorer.get();
-  }
+  /**
+     @brief Accumulates restaging tally from trained tree.
+   */
+  void consumeRestage(const vector<size_t>& volume);
+
+
   
   /**
      @brief Getter for raw forest pointer.
@@ -49,6 +49,11 @@ const vector<double>& GroveBridge::getPredInfo() const {
 }
 
 
+const vector<size_t>& GroveBridge::getRestageVolume() const {
+  return grove->getRestageVolume();
+}
+
+
 const vector<size_t>& GroveBridge::getNodeExtents() const {
   return grove->getNodeExtents();
 }
@@ -36,6 +36,14 @@ struct GroveBridge {
      @return reference to per-predictor information vector.
    */
   const vector<double>& getPredInfo() const;
+
+
+  /**
+     @brief Getter for observations restaged by the grove.
+
+     @return counts restaged on demand, for efficiency and at the path limit.
+   */
+  const vector<size_t>& getRestageVolume() const;
   
   /**
      @brief Main entry for training.
@@ -0,0 +1,105 @@
+// Copyright (C)  2012-2025  Mark Seligman
+//
+// This file is part of RboristBase.
+//
+// RboristBase is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// RboristBase is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RboristBase.  If not, see <http://www.gnu.org/licenses/>.
+
+
+/**
+   @file handleR.cc
+
+   @brief C++ interface to R entry for loaded forests.
+
+   @author Mark Seligman
+ */
+
+#include "handleR.h"
+#include "predictR.h"
+#include "samplerR.h"
+#include "forestR.h"
+#include "trainR.h"
+
+
+// [[Rcpp::export]]
+RcppExport SEXP forestHandleRcpp(const SEXP sTrain,
+				 const SEXP sSampler) {
+  return HandleR::wrap(List(sTrain), List(sSampler));
+}
+
+
+// [[Rcpp::export]]
+RcppExport SEXP predictHandleRcpp(const SEXP sDeframe,
+				  const SEXP sHandle,
+				  const SEXP sTrain,
+				  const SEXP sSampler,
+				  const SEXP sYTest,
+				  const SEXP sArgs) {
+  HandleR* handle = HandleR::unwrap(sHandle);
+  if (handle == nullptr)
+    return PredictR::predict(List(sDeframe), List(sTrain), List(sSampler), List(sArgs), sYTest);
+  else
+    return handle->predict(List(sDeframe), List(sSampler), List(sArgs), sYTest);
+}
+
+
+HandleR::HandleR(const List& lTrain,
+		 const List& lSampler) :
+  nPred(TrainR::nPred(lTrain)),
+  samplerBridge(SamplerR::unwrapGeneric(lSampler)),
+  forestBridge(ForestR::unwrap(lTrain, samplerBridge)) {
+}
+
+
+SEXP HandleR::wrap(const List& lTrain,
+		   const List& lSampler) {
+  // Node fields are decoded, and compact layouts built, while loading.
+  ForestBridge::init(TrainR::nPred(lTrain));
+  XPtr<HandleR> handle(new HandleR(lTrain, lSampler), true);
+  ForestBridge::deInit();
+
+  handle.attr("class") = "ForestHandle";
+  return handle;
+}
+
+
+HandleR* HandleR::unwrap(SEXP sHandle) {
+  if (TYPEOF(sHandle) != EXTPTRSXP)
+    return nullptr;
+
+  return static_cast<HandleR*>(R_ExternalPtrAddr(sHandle));
+}
+
+
+List HandleR::predict(const List& lDeframe,
+		      const List& lSampler,
+		      const List& lArgs,
+		      const SEXP sYTest) {
+  bool verbose = as<bool>(lArgs["verbose"]);
+  if (verbose)
+    Rcout << "Entering prediction, loaded forest" << endl;
+
+  PredictR::initPerInvocation(lArgs);
+  ForestBridge::init(nPred);
+
+  SamplerR::attachFrame(samplerBridge, lSampler, lDeframe, as<bool>(lArgs[PredictR::strBagging]));
+  List prediction = PredictR::predictBridged(lDeframe, lSampler, lArgs, samplerBridge, forestBridge, sYTest);
+  samplerBridge.clearFrame();
+
+  ForestBridge::deInit();
+
+  if (verbose)
+    Rcout << "Prediction completed" << endl;
+
+  return prediction;
+}
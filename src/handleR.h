@@ -0,0 +1,105 @@
+// Copyright (C)  2012-2024  Mark Seligman
+//
+// This file is part of RboristBase.
+//
+// RboristBase is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// RboristBase is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RboristBase.  If not, see <http://www.gnu.org/licenses/>.
+
+
+/**
+   @file handleR.h
+
+   @brief C++ interface to R entry for loaded forests.
+
+   @author Mark Seligman
+ */
+
+#ifndef RBORIST_BASE_HANDLE_R_H
+#define RBORIST_BASE_HANDLE_R_H
+
+#include <Rcpp.h>
+using namespace Rcpp;
+
+#include "samplerbridge.h"
+#include "forestbridge.h"
+
+
+/**
+   @brief Unpacks a trained forest for repeated prediction.
+
+   @param sTrain is the trained object.
+
+   @param sSampler is the sampler associated with training.
+
+   @return external pointer to the unpacked state.
+ */
+RcppExport SEXP forestHandleRcpp(const SEXP sTrain,
+				 const SEXP sSampler);
+
+
+/**
+   @brief Prediction through a loaded forest.
+
+   Falls back to unpacking if the handle is no longer live, as
+   following deserialization.
+
+   @param sHandle is the external pointer returned by forestHandleRcpp.
+
+   Remaining parameters as with predictRcpp.
+ */
+RcppExport SEXP predictHandleRcpp(const SEXP sDeframe,
+				  const SEXP sHandle,
+				  const SEXP sTrain,
+				  const SEXP sSampler,
+				  const SEXP sYTest,
+				  const SEXP sArgs);
+
+
+/**
+   @brief Retains the unpacked forest, sampler and derived caches
+   across prediction calls.
+ */
+struct HandleR {
+  const unsigned int nPred; ///< # training predictors.
+  SamplerBridge samplerBridge; ///< Response and bag; frame per call.
+  ForestBridge forestBridge; ///< Trees, leaves and derived caches.
+
+  HandleR(const List& lTrain,
+	  const List& lSampler);
+
+
+  /**
+     @brief Wraps a newly-loaded forest as an external pointer.
+   */
+  static SEXP wrap(const List& lTrain,
+		   const List& lSampler);
+
+
+  /**
+     @return loaded forest iff handle live, else null.
+   */
+  static HandleR* unwrap(SEXP sHandle);
+
+
+  /**
+     @brief Predicts a new frame, reusing the unpacked state.
+
+     @return wrapped prediction.
+   */
+  List predict(const List& lDeframe,
+	       const List& lSampler,
+	       const List& lArgs,
+	       const SEXP sYTest);
+};
+
+#endif
@@ -103,7 +103,7 @@ vector<double> IndexSet::sumsAndSquares(double& sumSquares) {
 }
 
 
-SplitNux IndexSet::candMax(const vector<SplitNux>& candVec) const {
+SplitNux IndexSet::candMax(const ArenaVec<SplitNux>& candVec) const {
   SplitNux argMaxNux;
   for (auto cand : candVec) {
     if (cand.maxInfo(argMaxNux))
@@ -21,6 +21,7 @@
 #include "splitcoord.h"
 #include "sumcount.h"
 #include "branchsense.h"
+#include "arena.h"
 
 
 /**
@@ -90,6 +91,11 @@ public:
   static void deImmutables();
 
 
+  static IndexT getMinNode() {
+    return minNode;
+  }
+
+
   /**
      @brief Updates branch state from criterion encoding.
 
@@ -103,7 +109,7 @@ public:
 
      @return maximal- or zero=information candidate for node.
    */
-  class SplitNux candMax(const vector<class SplitNux>& cand) const;
+  class SplitNux candMax(const ArenaVec<class SplitNux>& cand) const;
 
 
   /**
@@ -22,27 +22,43 @@
 #include "splitnux.h"
 #include "predictorframe.h"
 #include "indexset.h"
+#include "samplemap.h"
 
 #include <algorithm>
 
 
 InterLevel::InterLevel(const PredictorFrame* frame_,
 		       const SampledObs* sampledObs_,
-		       const Frontier* frontier) :
+		       const Frontier* frontier,
+		       ObsPart* obsPart_) :
   frame(frame_),
   nPred(frame->getNPred()),
   positionMask(getPositionMask(nPred)),
   levelShift(getLevelShift(nPred)),
   bagCount(frontier->getBagCount()),
+  historyMax(getHistoryMax(bagCount)),
   noRank(frame->getNoRank()),
   sampledObs(sampledObs_),
   rootPath(make_unique<IdxPath>(bagCount)),
-  pathIdx(vector<PathT>(frame->getSafeSize(bagCount))),
   level(0),
   splitCount(1),
-  obsPart(make_unique<ObsPart>(frame, bagCount)),
-  stageMap(vector<vector<PredictorT>>(1)) {
-  stageMap[0] = vector<PredictorT>(nPred);
+  obsPart(obsPart_),
+  stageMap(vector<vector<PredictorT>>(1)),
+  predStaged(vector<bool>(nPred)),
+  restageVolume(vector<size_t>(static_cast<unsigned int>(RestageCause::nCause))) {
+  stageMap[0] = vector<PredictorT>(nPred, nPred); // Unstaged until drawn.
+}
+
+
+unsigned int InterLevel::getHistoryMax(IndexT bagCount) {
+  // Each layer of history doubles the paths scattered by a restaged
+  // cell.  A deeper layer is admitted only while the path count
+  // remains within the square root of the bag.
+  unsigned int depth = historyNarrow;
+  while (NodePath::isRepresentable(depth + 1) && (size_t(1) << (2 * (depth + 1))) <= bagCount) {
+    depth++;
+  }
+  return depth;
 }
 
 
@@ -81,11 +97,11 @@ StagedCell*  InterLevel::getFrontCellAddr(const SplitCoord& coord) {
 
 
 ObsPart* InterLevel::getObsPart() const {
-  return obsPart.get();
+  return obsPart;
 }
 
 PathT* InterLevel::getPathBlock(PredictorT predIdx) {
-  return &pathIdx[obsPart->getStageOffset(predIdx)];
+  return obsPart->getPathBlock(predIdx);
 }
 
 
@@ -104,25 +120,27 @@ ObsFrontier* InterLevel::getFront() {
 }
 
 
-CandType InterLevel::repartition(const Frontier* frontier) {
+CandType InterLevel::repartition(const Frontier* frontier,
+				 const SampleMap& smNonterm) {
   ofFront = make_unique<ObsFrontier>(frontier, this);
   CandType cand(this);
   cand.precandidates(frontier, this);
-  // Precandidates precipitate restaging ancestors at this level,
-  // as do all history flushes.
-  vector<unsigned int> nExtinct;
-  if (level == 0) {
-    nExtinct = stage();
-  }
-  else {
-    nExtinct = restage();
-  }
+  // Precandidates precipitate staging of newly-drawn predictors and
+  // restaging of ancestors at this level, as do all history flushes.
+  vector<unsigned int> nExtinct = restage(smNonterm);
   ofFront->prune(nExtinct);
   return cand;
 }
 
 
 bool InterLevel::preschedule(const SplitCoord& coord) {
+  if (!predStaged[coord.predIdx]) {
+    predStaged[coord.predIdx] = true;
+    ofFront->prestageFront(coord.predIdx);
+    stagePending.push_back(coord.predIdx);
+    return true;
+  }
+
   unsigned int stageLevel;
   PredictorT stagePos;
   if (isStaged(coord, stageLevel, stagePos)) {
@@ -135,44 +153,55 @@ bool InterLevel::preschedule(const SplitCoord& coord) {
 }
 
 
-void InterLevel::appendAncestor(StagedCell& scAnc, unsigned int historyIdx) {
+void InterLevel::appendAncestor(StagedCell& scAnc,
+				unsigned int historyIdx,
+				RestageCause cause) {
+  restageVolume[static_cast<unsigned int>(cause)] += scAnc.obsRange.getExtent();
   history[historyIdx]->delist(scAnc);
   ancestor.emplace_back(scAnc, historyIdx);
 }
 
 
-vector<unsigned int> InterLevel::stage() {
-  ofFront->prestageRoot(frame, sampledObs);
-
-  OMPBound predTop = nPred;
-  vector<unsigned int> nExtinct(predTop);
-
-#pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
-  {
-#pragma omp for schedule(dynamic, 1)
-    for (OMPBound predIdx = 0; predIdx < predTop; predIdx++) {
-      nExtinct[predIdx] = ofFront->stage(predIdx, obsPart.get(), frame, sampledObs);
+vector<IndexT> InterLevel::mapFront(const SampleMap& smNonterm) const {
+  vector<IndexT> sample2Node(bagCount, splitCount);
+  for (IndexT nodeIdx = 0; nodeIdx != splitCount; nodeIdx++) {
+    IndexRange range = smNonterm.range[nodeIdx];
+    for (IndexT idx = range.getStart(); idx != range.getEnd(); idx++) {
+      sample2Node[smNonterm.sampleIndex[idx]] = nodeIdx;
     }
   }
-  return nExtinct;
+  return sample2Node;
 }
 
 
-vector<unsigned int> InterLevel::restage() {
+vector<unsigned int> InterLevel::restage(const SampleMap& smNonterm) {
   unsigned int backPop = prestageRear(); // Popable layers persist.
   ofFront->runValues();
 
-  OMPBound idxTop = ancestor.size();
+  vector<IndexT> sample2Node;
+  if (!stagePending.empty()) {
+    sample2Node = mapFront(smNonterm);
+  }
+
+  // Staging and restaging tasks are scheduled together.
+  OMPBound ancTop = ancestor.size();
+  OMPBound idxTop = ancTop + stagePending.size();
   vector<unsigned int> nExtinct(idxTop);
 #pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
   {
 #pragma omp for schedule(dynamic, 1)
     for (OMPBound idx = 0; idx < idxTop; idx++) {
-      nExtinct[idx] = restage(ancestor[idx]);
+      if (idx < ancTop) {
+	nExtinct[idx] = restage(ancestor[idx]);
+      }
+      else {
+	nExtinct[idx] = ofFront->stage(stagePending[idx - ancTop], obsPart, frame, sampledObs, smNonterm, sample2Node);
+      }
     }
   }
 
   ancestor.clear();
+  stagePending.clear();
   while (backPop--) { // Rear layers may now pop.
     history.pop_back();
   }
@@ -181,18 +210,26 @@ vector<unsigned int> InterLevel::restage() {
 }
 
 
+bool InterLevel::historyExhausted() const {
+  if (history.size() >= historyMax) {
+    return true;
+  }
+
+  // Beyond the narrow limit, the rear path table is bounded by the bag.
+  return history.size() > historyNarrow && history.back()->getPathExtent() > bagCount;
+}
+
+
 unsigned int InterLevel::prestageRear() {
-  // TODO:  replace constant.
-  // 8-bit paths cannot represent beyond a 7-layer history.
   unsigned int backPop = 0;
-  if (history.size() == 7) {//!NodePath::isRepresentable(history.size()))
-    history.back()->prestageLayer(ofFront.get());
+  if (historyExhausted()) {
+    history.back()->prestageLayer(ofFront.get(), RestageCause::pathLimit);
     backPop++;
   }
 
   for (int backLayer = history.size() - backPop - 1; backLayer >= 0; backLayer--) {
     if ((history[backLayer])->stageOccupancy() < stageEfficiency) {
-      history[backLayer]->prestageLayer(ofFront.get());
+      history[backLayer]->prestageLayer(ofFront.get(), RestageCause::efficiency);
       backPop++;
     }
     else {
@@ -205,7 +242,7 @@ unsigned int InterLevel::prestageRear() {
 
 
 unsigned int InterLevel::restage(Ancestor& ancestor) {
-  return history[ancestor.historyIdx]->restage(obsPart.get(), ancestor.cell, ofFront.get());
+  return history[ancestor.historyIdx]->restage(obsPart, ancestor.cell, ofFront.get());
 }
 
 
@@ -267,7 +304,7 @@ double InterLevel::interpolateRank(const SplitNux& cand,
   IndexT rankLeft = sampledObs->getRank(cand.getPredIdx(), sIdx);
   sIdx = obsPart->getSampleIndex(cand, obsRight);
   IndexT rankRight = sampledObs->getRank(cand.getPredIdx(), sIdx);
-  IndexRange rankRange(rankLeft, rankRight - rankLeft);
+  IndexRange rankRange = frame->getRankRange(cand.getPredIdx(), rankLeft, rankRight);
 
   return rankRange.interpolate(cand.getSplitQuant());
 }
@@ -281,7 +318,7 @@ double InterLevel::interpolateRank(const SplitNux& cand,
   IndexT rank = sampledObs->getRank(cand.getPredIdx(), sIdx);
   IndexT rankLeft = residualLeft ? residualRank : rank;
   IndexT rankRight = residualLeft ? rank : residualRank;
-  IndexRange rankRange(rankLeft, rankRight - rankLeft);
+  IndexRange rankRange = frame->getRankRange(cand.getPredIdx(), rankLeft, rankRight);
 
   return rankRange.interpolate(cand.getSplitQuant());
 }
@@ -53,23 +53,27 @@ class InterLevel {
   const PredictorT positionMask;
   const unsigned int levelShift;
   const IndexT bagCount;
+  const unsigned int historyMax; ///< Maximal # layers deferring restaging.
   
   static constexpr double stageEfficiency = 0.15; // Work efficiency threshold.
+  static constexpr unsigned int historyNarrow = 7; ///< Limit under 8-bit paths.
 
   const class PredictorFrame* layout;
   const IndexT noRank; ///< inachievable rank value:  (re)staging.
   const class SampledObs* sampledObs;
   unique_ptr<class IdxPath> rootPath; // Root-relative IdxPath.
-  vector<PathT> pathIdx;
   unsigned int level; // Zero-based tree depth.
   IndexT splitCount; // # nodes in the layer about to split.
   vector<Ancestor> ancestor; // Collection of ancestors to restage.
-  unique_ptr<class ObsPart> obsPart;
+  class ObsPart* obsPart; ///< Borrowed from the grove's pool.
 
   vector<vector<PredictorT>> stageMap; // Packed level, position.
+  vector<bool> predStaged; ///< Whether predictor staged within tree.
+  vector<PredictorT> stagePending; ///< Predictors first drawn at level.
   deque<unique_ptr<class ObsFrontier>> history; // Caches previous frontier layers.
 
   unique_ptr<class ObsFrontier> ofFront; ///< Current frontier, not in deque.
+  vector<size_t> restageVolume; ///< # observations restaged, by cause.
 
   
   /**
@@ -113,6 +117,32 @@ class InterLevel {
   }
 
 
+  /**
+     @brief Maps each live sample to its front node.
+
+     @return front node indices, by sample:  'splitCount' if extinct.
+   */
+  vector<IndexT> mapFront(const struct SampleMap& smNonterm) const;
+
+
+  /**
+     @brief Derives the history limit from path width and bag size.
+
+     Layers beyond the narrow limit are retained only when the bag is
+     large enough to amortize their wider path tables.
+
+     @return maximal history depth for the tree.
+   */
+  static unsigned int getHistoryMax(IndexT bagCount);
+
+
+  /**
+     @return true iff the rear layer must be flushed before the
+     frontier is pushed onto the history.
+   */
+  bool historyExhausted() const;
+
+
 public:
 
   /**
@@ -121,10 +151,13 @@ public:
      @param frame_ is the training frame.
 
      @param frontier_ tracks the frontier nodes.
+
+     @param obsPart_ is a partition reset to the tree's bag.
   */
   InterLevel(const class PredictorFrame* frame,
 	     const class SampledObs* sampledObs,
-	     const class Frontier* frontier);
+	     const class Frontier* frontier,
+	     class ObsPart* obsPart_);
 
   
   /**
@@ -225,6 +258,15 @@ public:
   ObsPart* getObsPart() const;
 
 
+  /**
+     @brief Determines whether a coordinate is a viable candidate,
+     arranging for it to be staged or restaged.
+
+     A predictor not yet drawn within the tree is staged directly
+     onto the front, so columns never drawn are never staged.
+
+     @return true iff coordinate not known to be delisted.
+   */
   bool preschedule(const SplitCoord& splitCoord);
 
   
@@ -233,9 +275,20 @@ public:
 
   /**
      @brief Appends a source cell to the restaging ancestor set.
+
+     @param cause is tallied against the cell's observation count.
    */
   void appendAncestor(StagedCell& scAnc,
-		      unsigned int historyIdx);
+		      unsigned int historyIdx,
+		      RestageCause cause = RestageCause::demand);
+
+
+  /**
+     @return # observations restaged over the tree, by cause.
+   */
+  const vector<size_t>& getRestageVolume() const {
+    return restageVolume;
+  }
 
 
   IndexT getNoRank() const {
@@ -315,15 +368,14 @@ public:
 
 
   /**
-     @brief Intializes observations cells.
-   */
-  vector<unsigned int> stage();
+     @brief Updates the data (observation) partition.
 
+     Stages newly-drawn predictors and restages ancestors of the
+     remainder.
 
-  /**
-     @brief Updates the data (observation) partition.
+     @return count of cells delisted, per task.
    */
-  vector<unsigned int> restage();
+  vector<unsigned int> restage(const struct SampleMap& smNonterm);
 
 
   /**
@@ -338,8 +390,11 @@ public:
      @brief Partitions or repartitions observations.
 
      @param frontier is the invoking Frontier.
+
+     @param smNonterm maps the front's samples.
    */
-  CandType repartition(const class Frontier* frontier);
+  CandType repartition(const class Frontier* frontier,
+		       const struct SampleMap& smNonterm);
 
 
   /**
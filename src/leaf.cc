@@ -13,6 +13,8 @@
 #include "leaf.h"
 #include "ompthread.h"
 
+#include <algorithm>
+
 
 PackedT RankCount::rankMask = 0;
 unsigned int RankCount::rightBits = 0;
@@ -172,31 +174,108 @@ vector<vector<vector<size_t>>> Leaf::countLeafCtg(const Sampler* sampler,
 }
 
 
-vector<vector<vector<RankCount>>> Leaf::alignRanks(const class Sampler* sampler,
-						   const vector<IndexT>& obs2Rank) const {
+void Leaf::alignRanks(const Sampler* sampler) const {
   unsigned int nTree = sampler->getNRep();
-  vector<vector<vector<RankCount>>> rankCount(nTree);
-  if (!sampler->hasSamples())
-    return rankCount;
+  if (!sampler->hasSamples() || rankStart.size() == nTree)
+    return;
+
+  const vector<double>& yTrain = reinterpret_cast<const ResponseReg*>(sampler->getResponse())->getYTrain();
+  RankedObs<double> valRank(&yTrain[0], yTrain.size());
+  rankMean = rankMeans(valRank);
+  vector<IndexT> obs2Rank = valRank.rank();
 
+  // Tree offsets precomputed for unordered writes.
+  vector<size_t> treeStart(nTree + 1);
   for (unsigned int tIdx = 0; tIdx < nTree; tIdx++) {
+    treeStart[tIdx + 1] = treeStart[tIdx] + sampler->getBagCount(tIdx);
+  }
+  rankStart = vector<vector<size_t>>(nTree);
+  rankLeaf = vector<IndexT>(treeStart[nTree]);
+  sCountCum = vector<IndexT>(treeStart[nTree]);
+
+#pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
+  {
+#pragma omp for schedule(dynamic, 1)
+  for (OMPBound tIdx = 0; tIdx < nTree; tIdx++) {
     IndexT obsIdx = 0;
-    vector<size_t> sIdx2Rank(sampler->getBagCount(tIdx));
+    vector<IndexT> sIdx2Rank(sampler->getBagCount(tIdx));
     for (IndexT sIdx = 0 ; sIdx != sIdx2Rank.size(); sIdx++) {
       obsIdx += sampler->getDelRow(tIdx, sIdx);
       sIdx2Rank[sIdx] = obs2Rank[obsIdx];
     }
-    size_t leafIdx = 0;
-    rankCount[tIdx] = vector<vector<RankCount>>(getLeafCount(tIdx));
-    for (vector<size_t> sIdxVec : getIndices(tIdx)) {
-      rankCount[tIdx][leafIdx] = vector<RankCount>(sIdxVec.size());
-      size_t idx = 0;
+    rankStart[tIdx] = vector<size_t>(getLeafCount(tIdx) + 1);
+    size_t idx = treeStart[tIdx];
+    IndexT leafIdx = 0;
+    vector<RankCount> rcLeaf;
+    for (const vector<size_t>& sIdxVec : getIndices(tIdx)) {
+      rankStart[tIdx][leafIdx] = idx;
+      rcLeaf = vector<RankCount>(sIdxVec.size());
+      size_t rcIdx = 0;
       for (size_t sIdx : sIdxVec) {
-	rankCount[tIdx][leafIdx][idx++].init(sIdx2Rank[sIdx], sampler->getSCount(tIdx, sIdx));
+	rcLeaf[rcIdx++].init(sIdx2Rank[sIdx], sampler->getSCount(tIdx, sIdx));
+      }
+      sort(rcLeaf.begin(), rcLeaf.end(),
+	   [](const RankCount& a, const RankCount& b) {
+	     return a.getRank() < b.getRank();
+	   });
+      IndexT sCountTot = 0;
+      for (RankCount rc : rcLeaf) {
+	rankLeaf[idx] = rc.getRank();
+	sCountTot += rc.getSCount();
+	sCountCum[idx++] = sCountTot;
       }
       leafIdx++;
     }
+    rankStart[tIdx][leafIdx] = idx;
+  }
+  }
+}
+
+
+vector<double> Leaf::rankMeans(const RankedObs<double>& valRank) {
+  vector<double> rankMean(valRank.getRankCount());
+  vector<size_t> rankCount(rankMean.size());
+  for (IndexT idx = 0; idx < valRank.getNRow(); idx++) {
+    IndexT rank = valRank.getRank(idx);
+    rankMean[rank] += valRank.getVal(idx);
+    rankCount[rank]++;
+  }
+  for (IndexT rank = 0; rank != rankMean.size(); rank++) {
+    rankMean[rank] /= rankCount[rank];
   }
 
-  return rankCount;
+  return rankMean;
+}
+
+
+void Leaf::alignObs(const Sampler* sampler) const {
+  unsigned int nTree = sampler->getNRep();
+  if (!sampler->hasSamples() || obsStart.size() == nTree)
+    return;
+
+  // Tree offsets precomputed for unordered writes.
+  vector<size_t> treeStart(nTree + 1);
+  for (unsigned int tIdx = 0; tIdx < nTree; tIdx++) {
+    treeStart[tIdx + 1] = treeStart[tIdx] + sampler->getBagCount(tIdx);
+  }
+  obsStart = vector<vector<size_t>>(nTree);
+  obsCount = vector<IdCount>(treeStart[nTree]);
+
+#pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
+  {
+#pragma omp for schedule(dynamic, 1)
+  for (OMPBound tIdx = 0; tIdx < nTree; tIdx++) {
+    vector<IdCount> idCount = sampler->unpack(tIdx);
+    obsStart[tIdx] = vector<size_t>(getLeafCount(tIdx) + 1);
+    size_t idx = treeStart[tIdx];
+    IndexT leafIdx = 0;
+    for (const vector<size_t>& sIdxVec : getIndices(tIdx)) {
+      obsStart[tIdx][leafIdx++] = idx;
+      for (size_t sIdx : sIdxVec) {
+	obsCount[idx++] = idCount[sIdx];
+      }
+    }
+    obsStart[tIdx][leafIdx] = idx;
+  }
+  }
 }
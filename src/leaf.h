@@ -17,7 +17,9 @@
 #define FOREST_LEAF_H
 
 #include "typeparam.h"
+#include "idcount.h"
 #include "util.h"
+#include "valrank.h"
 
 #include <vector>
 
@@ -97,6 +99,14 @@ struct Leaf {
   const vector<vector<size_t>> extent; ///< # sample index entries per leaf, per tree.
   const vector<vector<vector<size_t>>> index; ///< sample indices per leaf, per tree.
 
+  // Derived on first use and retained across predictions:
+  mutable vector<vector<size_t>> rankStart; ///< Per tree, per leaf, plus one:  offset into rankLeaf.
+  mutable vector<IndexT> rankLeaf; ///< Sample ranks, ascending within leaf.
+  mutable vector<IndexT> sCountCum; ///< Inclusive sample count, accumulated within leaf.
+  mutable vector<double> rankMean; ///< Mean training response, by rank.
+  mutable vector<vector<size_t>> obsStart; ///< Per tree, per leaf, plus one:  offset into obsCount.
+  mutable vector<IdCount> obsCount; ///< Observation index and sample count, by leaf.
+
   /**
      @brief Training factory.
 
@@ -184,14 +194,72 @@ struct Leaf {
 
 
   /**
-     @brief Count samples at each rank, per leaf, per tree:  regression.
+     @brief Builds the per-leaf rank tables on first request:  regression.
+
+     Computed once per forest, as a loaded forest may predict repeatedly.
+     The training response is ranked here, as are its means by rank.
+   */
+  void alignRanks(const Sampler* sampler) const;
+
+
+  /**
+     @brief Averages the response over each rank.
+
+     Ranks absorb near-equal values, hence the averaging.
+
+     @param valRank contains the ranked response/row pairs.
+
+     @return vector of response means, by rank.
+   */
+  static vector<double> rankMeans(const RankedObs<double>& valRank);
+
+
+  /**
+     @return offset of a leaf's first rank.  The rank following the
+     leaf's last is at the offset for leafIdx + 1.
+   */
+  size_t getRankStart(unsigned int tIdx,
+		      IndexT leafIdx) const {
+    return rankStart[tIdx][leafIdx];
+  }
+
+
+  const vector<IndexT>& getRankLeaf() const {
+    return rankLeaf;
+  }
+
+
+  const vector<IndexT>& getSCountCum() const {
+    return sCountCum;
+  }
+
+
+  const vector<double>& getRankMean() const {
+    return rankMean;
+  }
+
+
+  /**
+     @brief Builds the per-leaf observation tables on first request.
+
+     Computed once per forest, as a loaded forest may weigh repeatedly.
+   */
+  void alignObs(const Sampler* sampler) const;
 
-     @param obs2Rank is the ranked training outcome.
 
-     @return 3-d mapping as described.
+  /**
+     @return offset of a leaf's first observation.  The observation
+     following the leaf's last is at the offset for leafIdx + 1.
    */
-  vector<vector<vector<RankCount>>> alignRanks(const Sampler* sampler,
-					       const vector<IndexT>& obs2Rank) const;
+  size_t getObsStart(unsigned int tIdx,
+		     IndexT leafIdx) const {
+    return obsStart[tIdx][leafIdx];
+  }
+
+
+  const vector<IdCount>& getObsCount() const {
+    return obsCount;
+  }
 
 
   /**
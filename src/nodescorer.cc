@@ -35,41 +35,49 @@ unique_ptr<NodeScorer> NodeScorer::makeScorer() {
 
 
 void NodeScorer::frontierPreamble(const Frontier* frontier) {
-  ctgJitter = PRNG::rUnif<double>(frontier->getNCtg() * frontier->getNSplit(), 0.5);
+  ctgJitter = PRNG::rUnif<double>(frontier->getNCtg() * frontier->getNSplit(), 0.5, PRNG::Purpose::jitter);
 }
 
 
-NodeScorer::NodeScorer(double (NodeScorer::* scorer_)(const SampleMap&,
-						      const IndexSet&) const) :
+NodeScorer::NodeScorer(double (NodeScorer::* scorer_)(const ScoreNode&) const) :
   scorer(scorer_) {
 }
 
 
-double NodeScorer::scoreZero(const SampleMap& smNonterm,
-			     const IndexSet& iSet) const {
+double NodeScorer::score(const SampleMap& smNonterm,
+			 const IndexSet& iSet) const {
+  IndexRange range = smNonterm.range[iSet.getSplitIdx()];
+  const vector<SumCount>& ctgSum = iSet.getCtgSumCount();
+  return score(ScoreNode{&smNonterm.sampleIndex[range.getStart()],
+			 range.getExtent(),
+			 iSet.getSum(),
+			 iSet.getSCount(),
+			 ctgSum,
+			 ctgSum.empty() ? nullptr : &ctgJitter[ctgSum.size() * iSet.getSplitIdx()]});
+}
+
+
+double NodeScorer::scoreZero(const ScoreNode& node) const {
   return 0.0;
 }
 
 
-double NodeScorer::scoreMean(const SampleMap& smNonterm,
-			     const IndexSet& iSet) const {
-  IndexRange range = smNonterm.range[iSet.getSplitIdx()];
+double NodeScorer::scoreMean(const ScoreNode& node) const {
   double nodeSum = 0.0;
-  for (IndexT idx = range.getStart(); idx != range.getEnd(); idx++) {
-    IndexT sIdx = smNonterm.sampleIndex[idx];
+  for (IndexT idx = 0; idx != node.extent; idx++) {
+    IndexT sIdx = node.sampleIndex[idx];
     nodeSum += sampleScore[sIdx];
   }
-  return nodeSum / iSet.getSCount();
+  return nodeSum / node.sCount;
 }
 
 
-double NodeScorer::scorePlurality(const SampleMap& smNonterm,
-				  const IndexSet& iSet)  const {
-  const double* nodeJitter = &ctgJitter[iSet.getCtgSumCount().size() * iSet.getSplitIdx()];
+double NodeScorer::scorePlurality(const ScoreNode& node)  const {
+  const double* nodeJitter = node.jitter;
   PredictorT argMax = 0;// TODO:  set to nCtg and error if no count.
   IndexT countMax = 0;
   PredictorT ctg = 0;
-  for (const SumCount& sc : iSet.getCtgSumCount()) {
+  for (const SumCount& sc : node.ctgSum) {
     IndexT sCount = sc.getSCount();
     if (sCount > countMax) {
       countMax = sCount;
@@ -88,21 +96,19 @@ double NodeScorer::scorePlurality(const SampleMap& smNonterm,
 }
 
 
-double NodeScorer::scoreLogOdds(const SampleMap& smNonterm,
-				const IndexSet& iSet) const {
+double NodeScorer::scoreLogOdds(const ScoreNode& node) const {
   // Walks the sample indices associated with the node index,
   // accumulating a sum of pq-values.
   //
   double pqSum = 0.0;
-  IndexRange range = smNonterm.range[iSet.getSplitIdx()];
-  for (IndexT idx = range.getStart(); idx != range.getEnd(); idx++) {
-    IndexT sIdx = smNonterm.sampleIndex[idx];
+  for (IndexT idx = 0; idx != node.extent; idx++) {
+    IndexT sIdx = node.sampleIndex[idx];
     pqSum += gamma[sIdx];
   }
 
   // Replace with sum(multiplicity * observation value)/pqSum when
   // obsCount is implemented:
-  return iSet.getSum() / pqSum;
+  return node.sum / pqSum;
 }
 
 
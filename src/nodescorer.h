@@ -18,6 +18,7 @@
 
 
 #include "typeparam.h"
+#include "sumcount.h"
 
 
 #include <vector>
@@ -25,6 +26,19 @@
 #include <algorithm>
 
 
+/**
+   @brief Node contents consulted for scoring.
+ */
+struct ScoreNode {
+  const IndexT* sampleIndex; ///< Sample indices subsumed by the node.
+  IndexT extent; ///< # sample indices.
+  double sum; ///< Sum of sampled responses.
+  IndexT sCount; ///< # samples, with multiplicity.
+  const vector<SumCount>& ctgSum; ///< Per-category sums:  empty iff regression.
+  const double* jitter; ///< Per-category tie breakers:  classification only.
+};
+
+
 struct NodeScorer {
   static string scoreStr; ///< Initialized per training session.
 
@@ -33,11 +47,9 @@ struct NodeScorer {
   vector<double> gamma; ///< Per-sample weight, with multiplicity.
 
   
-  double (NodeScorer::* scorer)(const struct SampleMap&,
-				const class IndexSet&) const;
+  double (NodeScorer::* scorer)(const ScoreNode&) const;
 
-  NodeScorer(double (NodeScorer::* scorer_)(const struct SampleMap&,
-					    const class IndexSet&) const);
+  NodeScorer(double (NodeScorer::* scorer_)(const ScoreNode&) const);
 
 
   /**
@@ -68,9 +80,18 @@ struct NodeScorer {
   static unique_ptr<NodeScorer> makeScorer();
 
 
+  /**
+     @brief Scores a frontier node.
+   */
   double score(const struct SampleMap& smNonterm,
-	       const class IndexSet& iSet) const {
-    return (this->*scorer)(smNonterm, iSet);
+	       const class IndexSet& iSet) const;
+
+
+  /**
+     @brief Scores a node summarized outside of the frontier.
+   */
+  double score(const ScoreNode& node) const {
+    return (this->*scorer)(node);
   }
 
 
@@ -82,29 +103,25 @@ struct NodeScorer {
   /**
      @brief Placeholder scorer.  Should never be used.
    */
-  double scoreZero(const struct SampleMap& smNonterm,
-		   const class IndexSet& iSet) const;
+  double scoreZero(const ScoreNode& node) const;
 
   
   /**
      @return mean reponse over node.
    */
-  double scoreMean(const struct SampleMap& smNonterm,
-		   const class IndexSet& iSet) const;
+  double scoreMean(const ScoreNode& node) const;
 
 
   /**
      @return category with jittered plurality, plus jitter.
    */
-  double scorePlurality(const struct SampleMap& smNonterm,
-			const class IndexSet& iSet) const;
+  double scorePlurality(const ScoreNode& node) const;
 
 
   /**
      @return mean score weighted by per-sample p-q probabilities.
    */
-  double scoreLogOdds(const struct SampleMap& smNonterm,
-		      const class IndexSet& iSet) const;
+  double scoreLogOdds(const ScoreNode& node) const;
 };
 
 #endif
@@ -33,27 +33,23 @@ ObsFrontier::ObsFrontier(const Frontier* frontier_,
   nPred(interLevel->getNPred()),
   nSplit(interLevel->getNSplit()),
   node2Front(vector<IndexRange>(nSplit)), // Initialized to empty.
-  stagedCell(vector<vector<StagedCell>>(nSplit)),
+  stagedCell(vector<ArenaVec<StagedCell>>(nSplit)),
   stageCount(0),
   runCount(0),
   layerIdx(0), // Not on layer yet, however.
   nodePath(backScale(nSplit)) {
-  NodePath::setNoSplit(frontier->getBagCount());
   // Coprocessor only.
   // LiveBits df;
   //  fill(mrra.begin(), mrra.end(), df);
 }
 
 
-void ObsFrontier::prestageRoot(const PredictorFrame* frame,
-			       const SampledObs* sampledObs) {
-  for (PredictorT predIdx = 0; predIdx != nPred; predIdx++) {
-    interLevel->setStaged(0, predIdx, predIdx);
-    stagedCell[0].emplace_back(predIdx, runCount, frontier->getBagCount(), sampledObs->getRunCount(predIdx));
-    runCount += stagedCell[0].back().trackRuns ? sampledObs->getRunCount(predIdx) : 0;
+void ObsFrontier::prestageFront(PredictorT predIdx) {
+  for (IndexT nodeIdx = 0; nodeIdx != nSplit; nodeIdx++) {
+    interLevel->setStaged(nodeIdx, predIdx, stagedCell[nodeIdx].size());
+    stagedCell[nodeIdx].emplace_back(SplitCoord(nodeIdx, predIdx), frontier->getNodeRange(nodeIdx));
   }
-  stageCount = nPred;
-  runValues();
+  stageCount += nSplit;
 }
 
 
@@ -82,13 +78,14 @@ void ObsFrontier::prestageRange(const StagedCell& cell,
 }
 
 
-void ObsFrontier::prestageLayer(ObsFrontier* ofFront) {
+void ObsFrontier::prestageLayer(ObsFrontier* ofFront,
+				RestageCause cause) {
   IndexT nodeIdx = 0;
-  for (vector<StagedCell>& nodeCells : stagedCell) {
+  for (ArenaVec<StagedCell>& nodeCells : stagedCell) {
     for (StagedCell& cell : nodeCells) {
       if (cell.isLive()) { // Otherwise already delisted.
 	ofFront->prestageRange(cell, node2Front[nodeIdx]);
-	interLevel->appendAncestor(cell, layerIdx);
+	interLevel->appendAncestor(cell, layerIdx, cause);
       }
     }
     nodeIdx++;
@@ -98,8 +95,8 @@ void ObsFrontier::prestageLayer(ObsFrontier* ofFront) {
 
 IndexT ObsFrontier::countLive() const {
   IndexT liveCount = 0;
-  for (vector<StagedCell> nodeCells : stagedCell) {
-    for (StagedCell& cell : nodeCells) {
+  for (const ArenaVec<StagedCell>& nodeCells : stagedCell) {
+    for (const StagedCell& cell : nodeCells) {
       if (cell.isLive()) { // Otherwise already delisted.
 	liveCount++;
       }
@@ -186,52 +183,165 @@ void ObsFrontier::delistNode(IndexT nodeIdx) {
 unsigned int ObsFrontier::stage(PredictorT predIdx,
 				ObsPart* obsPart,
 				const PredictorFrame* frame,
-				const SampledObs* sampledObs) {
+				const SampledObs* sampledObs,
+				const SampleMap& smNonterm,
+				const vector<IndexT>& sample2Node) {
   obsPart->setStageRange(predIdx, frame->getSafeRange(predIdx, frontier->getBagCount()));
-  StagedCell& cell = stagedCell[0][predIdx];
   const IndexT rankImplicit = frame->getImplicitRank(predIdx);
   const IndexT rankMissing = frame->getMissingRank(predIdx);
-  IndexT obsMissing = 0;
+
+  // Binned ranks are excluded, as the frame orders ties within a bin
+  // by underlying rank.
+  const bool bagDriven = !frame->isBinned(predIdx) && bagScale * frontier->getBagCount() < frame->getExplicitCount(predIdx);
+  vector<IndexT> smpOrder;
+  if (bagDriven) {
+    smpOrder = rankSamples(sampledObs->getRanks(predIdx), sample2Node, rankImplicit);
+  }
+
+  // Explicit observations are packed in node order, as by restaging.
+  // Absent implicit observations, the sample map's packing suffices.
+  // Otherwise a first pass counts them.
+  vector<IndexT> obsStart(nSplit);
+  if (rankImplicit == interLevel->getNoRank()) {
+    for (IndexT nodeIdx = 0; nodeIdx != nSplit; nodeIdx++) {
+      obsStart[nodeIdx] = smNonterm.range[nodeIdx].getStart();
+    }
+  }
+  else {
+    if (bagDriven) {
+      for (IndexT smpIdx : smpOrder) {
+	obsStart[sample2Node[smpIdx]]++;
+      }
+    }
+    else {
+      for (auto rle : frame->getRLE(predIdx)) {
+	if (frame->getCode(predIdx, rle.val) != rankImplicit) {
+	  for (IndexT row = rle.row; row != rle.row + rle.extent; row++) {
+	    IndexT smpIdx;
+	    if (sampledObs->isSampled(row, smpIdx) && sample2Node[smpIdx] != nSplit) {
+	      obsStart[sample2Node[smpIdx]]++;
+	    }
+	  }
+	}
+      }
+    }
+    IndexT idxStart = 0;
+    for (IndexT& start : obsStart) {
+      IndexT extent = start;
+      start = idxStart;
+      idxStart += extent;
+    }
+  }
+
+  vector<IndexT> obsScatter(obsStart);
+  vector<IndexT> rankPrev(nSplit, interLevel->getNoRank());
+  vector<IndexT> nodeRuns(nSplit);
+  vector<IndexT> obsMissing(nSplit);
+  vector<IndexT> preResidual(nSplit);
+  bool residualSeen = false;
   IndexT* sIdx;
   Obs* srStart = obsPart->buffers(predIdx, 0, sIdx);
-  Obs* spn = srStart;
-  IndexT rankPrev = interLevel->getNoRank();
-  IndexT valIdx = cell.valIdx;
-  for (auto rle : frame->getRLE(predIdx)) {
-    IndexT rank = rle.val;
-    if (rank != rankImplicit) {
-      for (IndexT row = rle.row; row != rle.row + rle.extent; row++) {
-	IndexT smpIdx;
-	SampleNux sampleNux;
-	if (sampledObs->isSampled(row, smpIdx, sampleNux)) {
-	  bool tie = rank == rankPrev;
-	  spn++->join(sampleNux, tie);
-	  *sIdx++ = smpIdx;
-	  if (!tie) {
-	    rankPrev = rank;
-	    runCount++;
-	    if (cell.trackRuns)
-	      runValue[valIdx++] = rank;
+  auto scatter = [&](IndexT rank, IndexT smpIdx, const SampleNux& sampleNux) {
+    IndexT nodeIdx = sample2Node[smpIdx];
+    bool tie = rank == rankPrev[nodeIdx];
+    IndexT obsIdx = obsScatter[nodeIdx]++;
+    srStart[obsIdx].join(sampleNux, tie);
+    sIdx[obsIdx] = smpIdx;
+    if (!tie) {
+      rankPrev[nodeIdx] = rank;
+      nodeRuns[nodeIdx]++;
+    }
+    if (rank == rankMissing)
+      obsMissing[nodeIdx]++;
+  };
+  auto markResidual = [&]() {
+    residualSeen = true;
+    for (IndexT nodeIdx = 0; nodeIdx != nSplit; nodeIdx++) {
+      preResidual[nodeIdx] = obsScatter[nodeIdx] - obsStart[nodeIdx];
+    }
+  };
+
+  if (bagDriven) {
+    const vector<IndexT>& sample2Rank = sampledObs->getRanks(predIdx);
+    for (IndexT smpIdx : smpOrder) {
+      IndexT rank = sample2Rank[smpIdx];
+      if (!residualSeen && rankImplicit != interLevel->getNoRank() && rank > rankImplicit) {
+	markResidual();
+      }
+      scatter(rank, smpIdx, sampledObs->getSampleNux(smpIdx));
+    }
+    if (!residualSeen && rankImplicit != interLevel->getNoRank()) {
+      markResidual();
+    }
+  }
+  else {
+    for (auto rle : frame->getRLE(predIdx)) {
+      IndexT rank = frame->getCode(predIdx, rle.val);
+      if (rank != rankImplicit) {
+	for (IndexT row = rle.row; row != rle.row + rle.extent; row++) {
+	  IndexT smpIdx;
+	  SampleNux sampleNux;
+	  if (sampledObs->isSampled(row, smpIdx, sampleNux) && sample2Node[smpIdx] != nSplit) {
+	    scatter(rank, smpIdx, sampleNux);
 	  }
-	  if (rank == rankMissing)
-	    obsMissing++;
 	}
       }
+      else if (!residualSeen) { // Implicit runs are contiguous in rank.
+	markResidual();
+      }
     }
-    else {
-      cell.preResidual = spn - srStart;
+  }
+
+  unsigned int nExtinct = 0;
+  for (IndexT nodeIdx = 0; nodeIdx != nSplit; nodeIdx++) {
+    StagedCell& cell = stagedCell[nodeIdx][interLevel->getStagedPosition(SplitCoord(nodeIdx, predIdx))];
+    cell.updatePath(obsStart[nodeIdx], obsScatter[nodeIdx] - obsStart[nodeIdx], preResidual[nodeIdx], obsMissing[nodeIdx]);
+    cell.setRunCount(nodeRuns[nodeIdx]);
+    if (!cell.splitable()) {
+      interLevel->delist(cell.coord);
+      cell.delist();
+      nExtinct++;
     }
   }
-  //  cout << "Predictor " << predIdx << ":  " << obsMissing << " missing " << ", " << spn - srStart << " observed" << endl;
-  cell.updateCounts(frontier->getBagCount() - (spn - srStart), obsMissing);
 
-  if (!cell.splitable()) {
-    interLevel->delist(cell.coord);
-    cell.delist();
-    return 1;
+  return nExtinct;
+}
+
+
+vector<IndexT> ObsFrontier::rankSamples(const vector<IndexT>& sample2Rank,
+					const vector<IndexT>& sample2Node,
+					IndexT rankImplicit) const {
+  vector<IndexT> smpOrder;
+  IndexT rankMax = 0;
+  for (IndexT smpIdx = 0; smpIdx != sample2Rank.size(); smpIdx++) {
+    IndexT rank = sample2Rank[smpIdx];
+    if (sample2Node[smpIdx] != nSplit && rank != rankImplicit) {
+      smpOrder.push_back(smpIdx);
+      rankMax = max(rankMax, rank);
+    }
+  }
+
+  constexpr IndexT digitMask = (1ul << radixBits) - 1;
+  vector<IndexT> smpSorted(smpOrder.size());
+  vector<IndexT> digitStart(digitMask + 1);
+  for (unsigned int shift = 0; shift < 8 * sizeof(IndexT) && (rankMax >> shift) != 0; shift += radixBits) {
+    fill(digitStart.begin(), digitStart.end(), 0);
+    for (IndexT smpIdx : smpOrder) {
+      digitStart[(sample2Rank[smpIdx] >> shift) & digitMask]++;
+    }
+    IndexT idxStart = 0;
+    for (IndexT& start : digitStart) {
+      IndexT extent = start;
+      start = idxStart;
+      idxStart += extent;
+    }
+    for (IndexT smpIdx : smpOrder) {
+      smpSorted[digitStart[(sample2Rank[smpIdx] >> shift) & digitMask]++] = smpIdx;
+    }
+    smpOrder.swap(smpSorted);
   }
-  else
-    return 0;
+
+  return smpOrder;
 }
 
 
@@ -268,7 +378,7 @@ unsigned int ObsFrontier::restage(ObsPart* obsPart,
   unsigned int nExtinct = 0;
 
   // Speculatively assumes mrra has residual:
-  for (PathT path = 0; path != backScale(1); path++) {
+  for (unsigned int path = 0; path != backScale(1); path++) {
     StagedCell* cell = tcp[path];
     if (cell != nullptr) {
       cell->setRunCount(runCount[path]);
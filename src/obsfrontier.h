@@ -26,6 +26,7 @@
 #include "stagedcell.h"
 #include "splitcoord.h"
 #include "typeparam.h"
+#include "arena.h"
 
 #include <vector>
 #include <numeric>
@@ -34,6 +35,9 @@
    @brief Caches previous frontier definitiions by layer.
  */
 class ObsFrontier {
+  static constexpr unsigned int bagScale = 4; ///< Per-sample cost of bag-driven staging, relative to a row probe.
+  static constexpr unsigned int radixBits = 11; ///< Digit width for sorting sampled ranks.
+
   const class Frontier* frontier;
   class InterLevel* interLevel;
   const PredictorT nPred; ///< Predictor count.
@@ -42,7 +46,7 @@ class ObsFrontier {
   vector<IndexRange> node2Front;
   vector<IndexT> front2Node;
 
-  vector<vector<StagedCell>> stagedCell; ///< Cell, node x predictor.
+  vector<ArenaVec<StagedCell>> stagedCell; ///< Cell, node x predictor.
   IndexT stageCount; ///< # staged items.
   IndexT stageMax; ///< High watermark of stage count.
   IndexT runCount; ///< Total runs tracked.
@@ -54,6 +58,22 @@ class ObsFrontier {
   // Recomputed:
   vector<class NodePath> nodePath; ///< Indexed by <node, predictor> pair.
 
+  /**
+     @brief Collects the live samples not ranked implicitly, sorting
+     them by rank.
+
+     The radix sort is stable, so ties remain in sample, hence row,
+     order, as when walking the frame.
+
+     @param sample2Rank maps sample indices to predictor ranks.
+
+     @return sample indices, in rank order.
+   */
+  vector<IndexT> rankSamples(const vector<IndexT>& sample2Rank,
+			     const vector<IndexT>& sample2Node,
+			     IndexT rankImplicit) const;
+
+
   /**
      @brief Initializes a path from ancestor to front.
    */
@@ -100,14 +120,15 @@ public:
 
      @param ofCurrent is the current layer.
    */
-  void prestageLayer(class ObsFrontier* ofCurrent);
+  void prestageLayer(class ObsFrontier* ofCurrent,
+		     RestageCause cause);
 
   
   /**
-     @brief Allocates all 'nPred' StagedCells for staging.
+     @brief Allocates a cell at each front node for a predictor
+     staged directly from the frame.
    */
-  void prestageRoot(const class PredictorFrame* layout,
-		    const class SampledObs* sampledObs);
+  void prestageFront(PredictorT predIdx);
 
 
   /**
@@ -130,6 +151,14 @@ public:
   }
 
 
+  /**
+     @return number of entries in the node path table.
+   */
+  IndexT getPathExtent() const {
+    return nodePath.size();
+  }
+
+
   /**
      @brief Computes percentage of full occupancy.
 
@@ -194,12 +223,26 @@ public:
 
   
   /**
-     @return number of staged cells (0 or 1).
+     @brief Stages a predictor's observations directly onto the front.
+
+     Observations are walked in rank order and scattered to their
+     nodes, so each front cell is sorted as if restaged from the root.
+     Small bags are ordered by sorting their own ranks rather than by
+     probing every row of the frame.
+
+     @param smNonterm maps the front's samples.
+
+     @param sample2Node maps sample indices to front nodes, extinct
+     samples mapping to 'nSplit'.
+
+     @return count of delisted cells.
    */
   unsigned int stage(PredictorT predIdx,
 		     class ObsPart* obsPart,
 		     const class PredictorFrame* layout,
-		     const class SampledObs* sampledObs);
+		     const class SampledObs* sampledObs,
+		     const struct SampleMap& smNonterm,
+		     const vector<IndexT>& sample2Node);
 
 
   /**
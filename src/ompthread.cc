@@ -29,9 +29,18 @@ constexpr int omp_get_max_threads() {
 constexpr int omp_get_thread_limit() {
   return 1;
 }
+
+constexpr int omp_get_max_active_levels() {
+  return 1;
+}
+
+inline void omp_set_max_active_levels(int) {
+}
 #endif
 
 unsigned int OmpThread::nThread = OmpThread::nThreadDefault;
+thread_local unsigned int OmpThread::nThreadTeam = 0;
+int OmpThread::activeLevelsPrev = 1;
 
 const unsigned int OmpThread::maxThreads = 1024; // Cribbed from above.
 
@@ -45,6 +54,18 @@ void OmpThread::setNThread(unsigned int nThread_) {
 }
 
 
+unsigned int OmpThread::partition(unsigned int nTask) {
+  activeLevelsPrev = omp_get_max_active_levels();
+  omp_set_max_active_levels(std::max(activeLevelsPrev, 2));
+  return std::max(1u, nThread / std::max(1u, nTask));
+}
+
+
+void OmpThread::unpartition() {
+  omp_set_max_active_levels(activeLevelsPrev);
+}
+
+
 void OmpThread::deInit() {
   nThread = nThreadDefault;
 }
@@ -30,6 +30,8 @@ class OmpThread {
   static constexpr unsigned int nThreadDefault = 0; // Static initialization.
   static const unsigned int maxThreads;
   static unsigned int nThread;
+  static thread_local unsigned int nThreadTeam; ///< Nonzero iff within a partitioned team.
+  static int activeLevelsPrev; ///< Nesting depth in effect before partitioning.
 
 public:
 
@@ -40,10 +42,40 @@ public:
 
 
   /**
-     @return count of available threads.
+     @return count of threads available to the caller.
    */
   static unsigned int getNThread() {
-    return nThread;
+    return nThreadTeam != 0 ? nThreadTeam : nThread;
+  }
+
+
+  /**
+     @brief Divides the available threads among concurrent tasks.
+
+     Enables one level of nesting, so that each task's parallel
+     regions run over a team of its own.
+
+     @param nTask is the number of tasks to run concurrently.
+
+     @return size of each task's team.
+   */
+  static unsigned int partition(unsigned int nTask);
+
+
+  /**
+     @brief Restores the nesting depth in effect before partitioning.
+   */
+  static void unpartition();
+
+
+  /**
+     @brief Sets the calling thread's team size.
+
+     @param nThreadTeam_ is the team size, or zero to restore the
+     session-wide count.
+   */
+  static void setTeam(unsigned int nThreadTeam_) {
+    nThreadTeam = nThreadTeam_;
   }
 
   
@@ -27,9 +27,9 @@ ObsPart::ObsPart(const PredictorFrame* layout,
 		 IndexT bagCount_) :
   bagCount(bagCount_),
   bufferSize(layout->getSafeSize(bagCount)),
+  capacity(bufferSize),
   stageRange(layout->getNPred()) {
-  indexBase = new IndexT[2* bufferSize];
-  obsCell = new Obs[2 * bufferSize];
+  allocate();
 
   // Coprocessor variants:
   //  vector<unsigned int> destRestage(bufferSize);
@@ -41,8 +41,33 @@ ObsPart::ObsPart(const PredictorFrame* layout,
   @brief Base class destructor.
  */
 ObsPart::~ObsPart() {
+  release();
+}
+
+
+void ObsPart::allocate() {
+  indexBase = new IndexT[2 * capacity];
+  obsCell = new Obs[2 * capacity];
+  pathBase = new PathT[capacity];
+}
+
+
+void ObsPart::release() {
   delete [] obsCell;
   delete [] indexBase;
+  delete [] pathBase;
+}
+
+
+void ObsPart::reset(const PredictorFrame* layout,
+		    IndexT bagCount) {
+  this->bagCount = bagCount;
+  bufferSize = layout->getSafeSize(bagCount);
+  if (bufferSize > capacity) {
+    release();
+    capacity = bufferSize;
+    allocate();
+  }
 }
 
 
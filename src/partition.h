@@ -37,8 +37,9 @@ class ObsPart {
 
   // Predictor-based sample orderings, double-buffered by level value.
   //
-  const IndexT bagCount;
-  const IndexT bufferSize; // <= nRow * nPred.
+  IndexT bagCount;
+  IndexT bufferSize; // <= nRow * nPred.
+  IndexT capacity; ///< Allocated extent of each buffer half.
 
   Obs* obsCell;
 
@@ -49,6 +50,19 @@ class ObsPart {
   // traffic incurred by transposition on the coprocessor.
   //
   IndexT* indexBase;
+  PathT* pathBase; ///< Reaching paths, by staged position:  single-buffered.
+
+
+  /**
+     @brief Allocates buffers of the current capacity.
+   */
+  void allocate();
+
+
+  /**
+     @brief Frees buffers.
+   */
+  void release();
 
  protected:
   //  vector<unsigned int> destRestage;
@@ -63,6 +77,16 @@ class ObsPart {
   virtual ~ObsPart();
 
 
+  /**
+     @brief Readies the buffers for a new bag, retaining storage.
+
+     Buffers are reallocated only if the bag has outgrown them.
+     Contents are undefined until staged.
+   */
+  void reset(const class PredictorFrame* frame,
+	     IndexT bagCount);
+
+
   /**
      @brief Passes through to bufferOff() using definition coordinate.
    */
@@ -100,6 +124,14 @@ class ObsPart {
     return stageRange[predIdx].idxStart;
   }
 
+
+  /**
+     @return base of reaching paths for a given predictor.
+   */
+  PathT* getPathBlock(PredictorT predIdx) const {
+    return pathBase + getStageOffset(predIdx);
+  }
+
   // The category could, alternatively, be recorded in an object subclassed
   // under class ObsPart.  This would require that the value be restaged,
   // which happens for all predictors at all splits.  It would also require
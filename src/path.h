@@ -18,6 +18,7 @@
 #define PARTITION_PATH_H
 
 #include <vector>
+#include <limits>
 
 #include "typeparam.h"
 #include "splitcoord.h"
@@ -30,7 +31,8 @@ class NodePath {
   // Maximal path length is also an inattainable path index.
   static constexpr unsigned int noPath = 1 << logPathMax;
 
-  static IndexT noSplit;
+  // Inattainable split index, invariant across concurrent trees.
+  static constexpr IndexT noSplit = numeric_limits<IndexT>::max();
   
   IndexT frontIdx; // < noIndex iff path extinct.
   IndexRange bufRange; // buffer target range for path.
@@ -61,12 +63,6 @@ public:
   }
 
 
-  /**
-     @brief Sets noSplit to inattainable split index.
-   */
-  static void setNoSplit(IndexT bagCount);
-
-  
   /**
      @brief Determines whether a path size is representable within
      container.
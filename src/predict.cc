@@ -22,12 +22,15 @@
 #include "quant.h"
 #include "ompthread.h"
 #include "rleframe.h"
+#include "colframe.h"
 #include "sample.h"
+#include "prng.h"
 
 #include <cmath>
 
 const size_t Predict::obsChunk = 0x2000;
 const unsigned int Predict::seqChunk = 0x20;
+const size_t Predict::treeMajorBytes = 0x100000;
 
 
 bool Predict::bagging = false;
@@ -56,36 +59,70 @@ Predict::Predict(const Sampler* sampler,
   bag(sampler->makeBag(bagging)),
   rleFrame(std::move(rleFrame_)),
   nObs(rleFrame == nullptr ? 0 : rleFrame->getNRow()),
-  trFrame(make_unique<PredictFrame>(rleFrame.get())) {
+  trFrame(make_unique<PredictFrame>(rleFrame.get())),
+  quickScorer(nullptr) {
   if (rleFrame != nullptr) { // TEMPORARY
     rleFrame->reorderRow(); // For now, all frames pre-ranked.
   }
 }
 
 
+Predict::Predict(const Sampler* sampler,
+		 unique_ptr<ColFrame> colFrame_) :
+  bag(sampler->makeBag(bagging)),
+  colFrame(std::move(colFrame_)),
+  nObs(colFrame->getNRow()),
+  trFrame(make_unique<PredictFrame>(colFrame.get())),
+  quickScorer(nullptr) {
+}
+
+
 PredictReg::PredictReg(const Sampler* sampler,
 		       unique_ptr<RLEFrame> rleFrame_) :
   Predict(sampler, std::move(rleFrame_)) {
 }
 
 
+PredictReg::PredictReg(const Sampler* sampler,
+		       unique_ptr<ColFrame> colFrame_) :
+  Predict(sampler, std::move(colFrame_)) {
+}
+
+
 unique_ptr<PredictReg> Predict::makeReg(const Sampler* sampler,
 					unique_ptr<RLEFrame> rleFrame) {
   return make_unique<PredictReg>(sampler, std::move(rleFrame));
 }
 
 
+unique_ptr<PredictReg> Predict::makeRegDirect(const Sampler* sampler,
+					      unique_ptr<ColFrame> colFrame) {
+  return make_unique<PredictReg>(sampler, std::move(colFrame));
+}
+
+
 unique_ptr<PredictCtg> Predict::makeCtg(const Sampler* sampler,
 					unique_ptr<RLEFrame> rleFrame) {
   return make_unique<PredictCtg>(sampler, std::move(rleFrame));
 }
 
 
+unique_ptr<PredictCtg> Predict::makeCtgDirect(const Sampler* sampler,
+					      unique_ptr<ColFrame> colFrame) {
+  return make_unique<PredictCtg>(sampler, std::move(colFrame));
+}
+
+
 PredictCtg::PredictCtg(const Sampler* sampler, unique_ptr<RLEFrame> rleFrame_) :
   Predict(sampler, std::move(rleFrame_)) {
 }
 
 
+PredictCtg::PredictCtg(const Sampler* sampler, unique_ptr<ColFrame> colFrame_) :
+  Predict(sampler, std::move(colFrame_)) {
+}
+
+
 unique_ptr<SummaryReg> PredictReg::predictReg(const Sampler* sampler,
 					      Forest* forest,
 					      const vector<double>& yTest) {
@@ -120,6 +157,10 @@ void SummaryReg::build(Predict* predictObj,
 		       const Sampler* sampler,
 		       const vector<double>& yTest) {
   predictObj->predict(prediction.get());
+  if (ForestPrediction::streams()) { // Scores not retained for testing.
+    test = prediction->test(vector<double>());
+    return;
+  }
   test = prediction->test(yTest);
   permutationTest = permute(predictObj, sampler, yTest);
 }
@@ -137,6 +178,10 @@ void SummaryCtg::build(Predict* predictObj,
 		       const Sampler* sampler,
 		       const vector<unsigned int>& yTest) {
   predictObj->predict(prediction.get());
+  if (ForestPrediction::streams()) { // Scores not retained for testing.
+    test = prediction->test(vector<unsigned int>());
+    return;
+  }
   test = prediction->test(yTest);
   permutationTest = permute(predictObj, sampler, yTest);
 }
@@ -146,7 +191,12 @@ void Predict::predict(ForestPrediction* prediction) {
   blockStart = 0;
   idxFinal = vector<IndexT>(nTree * obsChunk);
   noNode = forest->getNoNode();
-  
+  // Trapping requires the nonterminal at which a walk exits.
+  quickScorer = trapUnobserved ? nullptr : forest->getQuickScorer(trFrame->getNPredNum());
+  treeMajor = quickScorer == nullptr && forest->getNodeBytes() > treeMajorBytes;
+  // Permutation resumes from the unpermuted walks.
+  idxCache = vector<IndexT>((permutes() && rleFrame != nullptr && !ForestPrediction::streams()) ? nTree * nObs : 0);
+
   predictBlock(prediction);
   // Remainder rows handled in custom-fitted block.
   if (nObs > blockStart) {
@@ -166,21 +216,143 @@ void Predict::predictBlock(ForestPrediction* prediction) {
 void Predict::predictObs(ForestPrediction* prediction,
 			 size_t span) {
   resetIndices();
-  trFrame->transpose(rleFrame.get(), blockStart, span);
+  prediction->beginBlock(blockStart);
+  if (colFrame != nullptr)
+    trFrame->transpose(colFrame.get(), blockStart, span);
+  else
+    trFrame->transpose(rleFrame.get(), blockStart, span);
 
   OMPBound rowEnd = static_cast<OMPBound>(blockStart + span);
   OMPBound rowStart = static_cast<OMPBound>(blockStart);
 
+  if (treeMajor) {
+    walkBlock(rowStart, rowEnd);
+  }
+
 #pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
   {
 #pragma omp for schedule(dynamic, 1)
   for (OMPBound row = rowStart; row < rowEnd; row += seqChunk) {
     size_t chunkEnd = min(rowEnd, row + seqChunk);
-    walkTrees(row, chunkEnd);
+    if (quickScorer != nullptr) {
+      walkBits(row, chunkEnd);
+    }
+    else if (!treeMajor) {
+      walkTrees(row, chunkEnd);
+    }
     prediction->callScorer(this, row, chunkEnd);
   }
   }
-  prediction->cacheIndices(idxFinal, span * nTree, blockStart * nTree);
+  if (!idxCache.empty())
+    copy(idxFinal.begin(), idxFinal.begin() + span * nTree, &idxCache[blockStart * nTree]);
+  prediction->finishBlock(this, idxFinal, span, blockStart);
+}
+
+
+PermutePred::PermutePred(const Forest* forest,
+			 const RLEFrame* rleFrame,
+			 PredictorT nPredNum_,
+			 PredictorT predIdx) :
+  nPredNum(nPredNum_),
+  corePred((rleFrame->getFactorTop(predIdx) > 0 ? nPredNum : 0) + rleFrame->getBlockIdx(predIdx)),
+  isFactor(corePred >= nPredNum),
+  colNum(isFactor ? vector<double>(0) : rleFrame->decodeNum(predIdx)),
+  colFac(isFactor ? rleFrame->decodeFac(predIdx) : vector<CtgT>(0)),
+  head(vector<vector<IndexT>>(forest->getNTree())) {
+  for (unsigned int tIdx = 0; tIdx != forest->getNTree(); tIdx++) {
+    head[tIdx] = forest->pathHeads(tIdx, corePred);
+    if (!head[tIdx].empty())
+      treeSplit.push_back(tIdx);
+  }
+}
+
+
+void PermutePred::substitute(const vector<size_t>& idxPerm,
+			     size_t obsStart,
+			     size_t span,
+			     vector<double>& numPerm,
+			     vector<CtgT>& facPerm) const {
+  if (isFactor) {
+    PredictorT nPredFac = facPerm.size() / span;
+    PredictorT facIdx = corePred - nPredNum;
+    for (size_t row = 0; row != span; row++) {
+      facPerm[row * nPredFac + facIdx] = colFac[idxPerm[obsStart + row]];
+    }
+  }
+  else {
+    for (size_t row = 0; row != span; row++) {
+      numPerm[row * nPredNum + corePred] = colNum[idxPerm[obsStart + row]];
+    }
+  }
+}
+
+
+vector<vector<size_t>> Predict::drawPermutations(PredictorT predIdx,
+						 size_t nRow) {
+  vector<vector<size_t>> idxPerm(nPermute);
+#pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
+  {
+#pragma omp for schedule(dynamic, 1)
+  for (OMPBound rep = 0; rep < nPermute; rep++) {
+    PRNG::setStream(predIdx, rep);
+    idxPerm[rep] = Sample<size_t>::permute(nRow);
+  }
+  }
+  return idxPerm;
+}
+
+
+void Predict::predictPermute(PredictorT predIdx,
+			     const vector<vector<size_t>>& idxPerm,
+			     const vector<ForestPrediction*>& prediction) {
+  PermutePred permute(forest, rleFrame.get(), trFrame->getNPredNum(), predIdx);
+  trFrame = make_unique<PredictFrame>(rleFrame.get()); // Rewinds transposition.
+  for (blockStart = 0; blockStart < nObs; blockStart += obsChunk) {
+    size_t span = min(obsChunk, nObs - blockStart);
+    trFrame->transpose(rleFrame.get(), blockStart, span);
+    for (unsigned int rep = 0; rep != idxPerm.size(); rep++) {
+      vector<double> numPerm(trFrame->num);
+      vector<CtgT> facPerm(trFrame->fac);
+      permute.substitute(idxPerm[rep], blockStart, span, numPerm, facPerm);
+      copy(&idxCache[blockStart * nTree], &idxCache[blockStart * nTree] + span * nTree, idxFinal.begin());
+
+      OMPBound splitEnd = static_cast<OMPBound>(permute.treeSplit.size());
+#pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
+      {
+#pragma omp for schedule(dynamic, 1)
+      for (OMPBound splitIdx = 0; splitIdx < splitEnd; splitIdx++) {
+	resumeWalks(permute, permute.treeSplit[splitIdx], span, numPerm, facPerm);
+      }
+      }
+
+      OMPBound rowStart = static_cast<OMPBound>(blockStart);
+      OMPBound rowEnd = static_cast<OMPBound>(blockStart + span);
+#pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
+      {
+#pragma omp for schedule(dynamic, 1)
+      for (OMPBound row = rowStart; row < rowEnd; row += seqChunk) {
+	prediction[rep]->callScorer(this, row, min(rowEnd, row + seqChunk));
+      }
+      }
+    }
+  }
+}
+
+
+void Predict::resumeWalks(const PermutePred& permute,
+			  unsigned int tIdx,
+			  size_t span,
+			  const vector<double>& numPerm,
+			  const vector<CtgT>& facPerm) {
+  const vector<IndexT>& head = permute.head[tIdx];
+  PredictorT nPredNum = permute.nPredNum;
+  PredictorT nPredFac = facPerm.size() / span;
+  for (size_t row = 0; row != span; row++) {
+    IndexT nodeIdx;
+    if (getFinalIdx(blockStart + row, tIdx, nodeIdx) && head[nodeIdx] != noNode) {
+      setFinalIdx(blockStart + row, tIdx, forest->walkRow(tIdx, numPerm.data() + row * nPredNum, facPerm.data() + row * nPredFac, nPredNum, trapUnobserved, head[nodeIdx]));
+    }
+  }
 }
 
 
@@ -201,6 +373,69 @@ void Predict::walkTrees(size_t obsStart,
 }
 
 
+void Predict::walkBits(size_t obsStart,
+		       size_t obsEnd) {
+  vector<PackedT> leafBits(nTree);
+  vector<IndexT> finalIdx(nTree);
+  for (size_t obsIdx = obsStart; obsIdx != obsEnd; obsIdx++) {
+    quickScorer->walkObs(trFrame->baseNum(obsIdx), leafBits, &finalIdx[0]);
+    for (unsigned int tIdx = 0; tIdx < nTree; tIdx++) {
+      if (!isBagged(tIdx, obsIdx)) {
+	setFinalIdx(obsIdx, tIdx, finalIdx[tIdx]);
+      }
+    }
+  }
+}
+
+
+void Predict::walkBlock(size_t obsStart,
+			size_t obsEnd) {
+  OMPBound treeEnd = static_cast<OMPBound>(nTree);
+#pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
+  {
+#pragma omp for schedule(dynamic, 1)
+  for (OMPBound tIdx = 0; tIdx < treeEnd; tIdx++) {
+    walkTree(tIdx, obsStart, obsEnd);
+  }
+  }
+}
+
+
+void Predict::walkTree(unsigned int tIdx,
+		       size_t obsStart,
+		       size_t obsEnd) {
+  size_t obsLane[DecTree::nLaneMax];
+  IndexT finalLane[DecTree::nLaneMax];
+  unsigned int nLane = 0;
+
+  size_t slotElts = BV::getSlotElts();
+  for (size_t slotStart = obsStart - obsStart % slotElts; slotStart < obsEnd; slotStart += slotElts) {
+    BVSlotT unbagged = bagging ? ~bag->getSlot(tIdx, slotStart) : BV::allOnes;
+    if (unbagged == 0)
+      continue;
+    size_t obsIdx = max(slotStart, obsStart);
+    size_t slotEnd = min(slotStart + slotElts, obsEnd);
+    for (unbagged >>= (obsIdx - slotStart); obsIdx != slotEnd && unbagged != 0; obsIdx++, unbagged >>= 1) {
+      if ((unbagged & 1) != 0) {
+	obsLane[nLane++] = obsIdx;
+	if (nLane == DecTree::nLaneMax) {
+	  forest->walkLanes(trFrame.get(), trapUnobserved, tIdx, obsLane, nLane, finalLane);
+	  for (unsigned int lane = 0; lane != nLane; lane++) {
+	    setFinalIdx(obsLane[lane], tIdx, finalLane[lane]);
+	  }
+	  nLane = 0;
+	}
+      }
+    }
+  }
+
+  forest->walkLanes(trFrame.get(), trapUnobserved, tIdx, obsLane, nLane, finalLane);
+  for (unsigned int lane = 0; lane != nLane; lane++) {
+    setFinalIdx(obsLane[lane], tIdx, finalLane[lane]);
+  }
+}
+
+
 bool Predict::isLeafIdx(size_t obsIdx,
 			unsigned int tIdx,
 			IndexT& leafIdx) const {
@@ -226,44 +461,54 @@ bool Predict::isNodeIdx(size_t obsIdx,
 }
 
 
-vector<vector<unique_ptr<TestReg>>> SummaryReg::permute(const Predict* predict,
+vector<vector<unique_ptr<TestReg>>> SummaryReg::permute(Predict* predict,
 							const Sampler* sampler,
 							const vector<double>& yTest) {
-  if (yTest.empty() || Predict::nPermute == 0)
+  // Permutation operates on the ranked encoding only.
+  if (yTest.empty() || Predict::nPermute == 0 || predict->getRLEFrame() == nullptr)
     return vector<vector<unique_ptr<TestReg>>>(0);
 
-  RLEFrame* rleFrame = predict->getRLEFrame();
+  const RLEFrame* rleFrame = predict->getRLEFrame();
   vector<vector<unique_ptr<TestReg>>> testPermute(rleFrame->getNPred());
   for (PredictorT predIdx = 0; predIdx < rleFrame->getNPred(); predIdx++) {
-    vector<RLEVal<szType>> rleTemp = std::move(rleFrame->rlePred[predIdx]);
+    vector<vector<size_t>> idxPerm = Predict::drawPermutations(predIdx, rleFrame->getNRow());
+    vector<unique_ptr<ForestPredictionReg>> repReg;
+    vector<ForestPrediction*> repPrediction;
     for (unsigned int rep = 0; rep != Predict::nPermute; rep++) {
-      rleFrame->rlePred[predIdx] = rleFrame->permute(predIdx, Sample<size_t>::permute(rleFrame->getNRow()));
-      unique_ptr<ForestPredictionReg> repReg = predict->forest->makePredictionReg(sampler, predict, false);
-      testPermute[predIdx].emplace_back(repReg->test(yTest));
+      repReg.emplace_back(predict->forest->makePredictionReg(sampler, predict, false));
+      repPrediction.push_back(repReg.back().get());
+    }
+    predict->predictPermute(predIdx, idxPerm, repPrediction);
+    for (auto & rep : repReg) {
+      testPermute[predIdx].emplace_back(rep->test(yTest));
     }
-    rleFrame->rlePred[predIdx] = std::move(rleTemp);
   }
 
   return testPermute;
 }
 
 
-vector<vector<unique_ptr<TestCtg>>> SummaryCtg::permute(const Predict* predict,
+vector<vector<unique_ptr<TestCtg>>> SummaryCtg::permute(Predict* predict,
 							const Sampler* sampler,
 							const vector<unsigned int>& yTest) {
-  if (yTest.empty() || Predict::nPermute == 0)
+  // Permutation operates on the ranked encoding only.
+  if (yTest.empty() || Predict::nPermute == 0 || predict->getRLEFrame() == nullptr)
     return vector<vector<unique_ptr<TestCtg>>>(0);
 
-  RLEFrame* rleFrame = predict->getRLEFrame();
+  const RLEFrame* rleFrame = predict->getRLEFrame();
   vector<vector<unique_ptr<TestCtg>>> testPermute(rleFrame->getNPred());
   for (PredictorT predIdx = 0; predIdx < rleFrame->getNPred(); predIdx++) {
-    vector<RLEVal<szType>> rleTemp = std::move(rleFrame->rlePred[predIdx]);
+    vector<vector<size_t>> idxPerm = Predict::drawPermutations(predIdx, rleFrame->getNRow());
+    vector<unique_ptr<ForestPredictionCtg>> repCtg;
+    vector<ForestPrediction*> repPrediction;
     for (unsigned int rep = 0; rep != Predict::nPermute; rep++) {
-      rleFrame->rlePred[predIdx] = rleFrame->permute(predIdx, Sample<size_t>::permute(rleFrame->getNRow()));
-      unique_ptr<ForestPredictionCtg> repCtg = predict->forest->makePredictionCtg(sampler, predict, false);
-      testPermute[predIdx].emplace_back(repCtg->test(yTest));
+      repCtg.emplace_back(predict->forest->makePredictionCtg(sampler, predict, false));
+      repPrediction.push_back(repCtg.back().get());
+    }
+    predict->predictPermute(predIdx, idxPerm, repPrediction);
+    for (auto & rep : repCtg) {
+      testPermute[predIdx].emplace_back(rep->test(yTest));
     }
-    rleFrame->rlePred[predIdx] = std::move(rleTemp);
   }
 
   return testPermute;
@@ -345,85 +590,107 @@ vector<vector<double>> SummaryCtg::getOOBErrorPermuted() const {
 }
 
 
-vector<double> Predict::forestWeight(const Forest* forest,
-				     const Sampler* sampler,
-				     size_t nPredict,
-				     const double finalIdx[]) {
-  vector<vector<double>> obsWeight(nPredict);
-  for (size_t idxPredict = 0; idxPredict != nPredict; idxPredict++) {
-    obsWeight[idxPredict] = vector<double>(sampler->getNObs());
-  }
+ForestWeight Predict::forestWeight(const Forest* forest,
+				   const Sampler* sampler,
+				   size_t nPredict,
+				   const double finalIdx[],
+				   IndexT topK) {
+  const Leaf& leaf = forest->getLeaf();
+  leaf.alignObs(sampler);
+  // Dominators needed only if some final indices are nonterminal, as
+  // with trap-and-bail, but are cached by the forest.
+  const vector<vector<IndexRange>>& leafDom = forest->leafDominators();
+  IndexT noNode = forest->getNoNode(); // Excludes bagged observations.
+  unsigned int nTree = forest->getNTree();
 
-  for (unsigned int tIdx = 0; tIdx < forest->getNTree(); tIdx++) {
-    vector<vector<IdCount>> node2Idc = obsCounts(forest, sampler, tIdx);
-    weighNode(forest, &finalIdx[tIdx], node2Idc, obsWeight);
+  vector<vector<pair<IndexT, double>>> rowWeight(nPredict);
+#pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
+  {
+    vector<double> obsWeight(sampler->getNObs());
+    vector<IndexT> touched;
+#pragma omp for schedule(dynamic, 1)
+  for (OMPBound row = 0; row < nPredict; row++) {
+    for (unsigned int tIdx = 0; tIdx < nTree; tIdx++) {
+      IndexT nodeIdx = finalIdx[row * nTree + tIdx];
+      if (nodeIdx != noNode) {
+	weighNode(leaf, tIdx, leafDom[tIdx][nodeIdx], obsWeight, touched);
+      }
+    }
+    rowWeight[row] = normalizeWeight(obsWeight, touched, topK);
+  }
   }
 
-  return normalizeWeight(sampler, obsWeight);
-}
-
-
-vector<vector<IdCount>> Predict::obsCounts(const Forest* forest,
-					   const Sampler* sampler,
-					   unsigned int tIdx) {
-  const Leaf& leaf = forest->getLeaf();
-  const vector<DecNode>& decNode = forest->getNode(tIdx);
-  const vector<IdCount> idCount = sampler->unpack(tIdx);
-  const vector<vector<size_t>>& indices = leaf.getIndices(tIdx);
-
-  // Dominators need not be computed if it is known in advance
-  // that all final indices are terminal.  This will be the case
-  // if prediction does not employ trap-and-bail.
-  vector<IndexRange> leafDom = forest->leafDominators(decNode);
-  vector<vector<IdCount>> node2Idc(decNode.size());
-  for (IndexT nodeIdx = 0; nodeIdx != decNode.size(); nodeIdx++) {
-    IndexRange leafRange = leafDom[nodeIdx];
-    for (IndexT leafIdx = leafRange.getStart(); leafIdx != leafRange.getEnd(); leafIdx++) {
-      for (size_t sIdx : indices[leafIdx]) {
-	node2Idc[nodeIdx].emplace_back(idCount[sIdx]);
-      }
+  ForestWeight forestWeight;
+  forestWeight.rowStart = vector<size_t>(nPredict + 1);
+  for (size_t row = 0; row != nPredict; row++) {
+    forestWeight.rowStart[row + 1] = forestWeight.rowStart[row] + rowWeight[row].size();
+  }
+  forestWeight.obsIdx = vector<IndexT>(forestWeight.rowStart[nPredict]);
+  forestWeight.weight = vector<double>(forestWeight.rowStart[nPredict]);
+  for (size_t row = 0; row != nPredict; row++) {
+    size_t idx = forestWeight.rowStart[row];
+    for (auto obsW : rowWeight[row]) {
+      forestWeight.obsIdx[idx] = obsW.first;
+      forestWeight.weight[idx++] = obsW.second;
     }
+    rowWeight[row].clear();
+    rowWeight[row].shrink_to_fit();
   }
 
-  return node2Idc;
+  return forestWeight;
 }
 
 
-void Predict::weighNode(const Forest* forest,
-			const double treeIdx[],
-			const vector<vector<IdCount>>& nodeCount,
-			vector<vector<double>>& obsWeight) {
-  IndexT noNode = forest->getNoNode(); // Excludes bagged observations.
-  size_t finalPosition = 0; // Position of final indices for tree.
-  for (vector<double>& nodeWeight : obsWeight) {
-    IndexT nodeIdx = treeIdx[finalPosition];
-    if (nodeIdx != noNode) {
-      IndexT sampleCount = 0;
-      for (const IdCount &idc : nodeCount[nodeIdx]) {
-	sampleCount += idc.sCount;
-      }
+void Predict::weighNode(const Leaf& leaf,
+			unsigned int tIdx,
+			const IndexRange& leafRange,
+			vector<double>& obsWeight,
+			vector<IndexT>& touched) {
+  const vector<IdCount>& obsCount = leaf.getObsCount();
+  size_t idxStart = leaf.getObsStart(tIdx, leafRange.getStart());
+  size_t idxEnd = leaf.getObsStart(tIdx, leafRange.getEnd());
+  IndexT sampleCount = 0;
+  for (size_t idx = idxStart; idx != idxEnd; idx++) {
+    sampleCount += obsCount[idx].sCount;
+  }
 
-      double recipSCount = 1.0 / sampleCount;
-      for (const IdCount& idc : nodeCount[nodeIdx]) {
-	nodeWeight[idc.id] += idc.sCount * recipSCount;
-      }
-    }
-    finalPosition += forest->getNTree();
+  double recipSCount = 1.0 / sampleCount;
+  for (size_t idx = idxStart; idx != idxEnd; idx++) {
+    const IdCount& idc = obsCount[idx];
+    if (obsWeight[idc.id] == 0.0)
+      touched.push_back(idc.id);
+    obsWeight[idc.id] += idc.sCount * recipSCount;
   }
 }
 
 
-vector<double> Predict::normalizeWeight(const Sampler* sampler,
-					const vector<vector<double>>& obsWeight) {
-  size_t nObs = sampler->getNObs();
-  vector<double> weight(obsWeight.size() * nObs);
-  size_t idxPredict = 0;
-  for (const vector<double>& obsW : obsWeight) {
-    double weightRecip = 1.0 / accumulate(obsW.begin(), obsW.end(), 0.0);
-    transform(obsW.begin(), obsW.end(), &weight[idxPredict * nObs],
-                   [&weightRecip](double element) { return element * weightRecip; });
-    idxPredict++;
+vector<pair<IndexT, double>> Predict::normalizeWeight(vector<double>& obsWeight,
+						      vector<IndexT>& touched,
+						      IndexT topK) {
+  // Ascending order also reproduces the dense summation.
+  sort(touched.begin(), touched.end());
+  double weightSum = 0.0;
+  for (IndexT obsIdx : touched) {
+    weightSum += obsWeight[obsIdx];
   }
-  return weight;
-}
+  double weightRecip = 1.0 / weightSum;
 
+  vector<pair<IndexT, double>> obsW;
+  obsW.reserve(touched.size());
+  for (IndexT obsIdx : touched) {
+    obsW.emplace_back(obsIdx, obsWeight[obsIdx] * weightRecip);
+    obsWeight[obsIdx] = 0.0;
+  }
+  touched.clear();
+
+  if (topK > 0 && obsW.size() > topK) {
+    // Ties broken by observation index, for reproducibility.
+    nth_element(obsW.begin(), obsW.begin() + topK, obsW.end(),
+		[](const pair<IndexT, double>& a, const pair<IndexT, double>& b) {
+		  return a.second > b.second || (a.second == b.second && a.first < b.first);
+		});
+    obsW.resize(topK);
+    sort(obsW.begin(), obsW.end());
+  }
+  return obsW;
+}
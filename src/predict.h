@@ -18,6 +18,7 @@
 
 #include "prediction.h"
 #include "predictframe.h"
+#include "quickscorer.h"
 #include "block.h"
 #include "typeparam.h"
 #include "bv.h"
@@ -28,11 +29,12 @@
 class Sampler;
 class PredictFrame;
 struct RLEFrame;
+struct ColFrame;
 class Forest;
 class Predict;
 struct PredictReg;
 struct PredictCtg;
-struct IdCount;
+struct Leaf;
 
 /**
    @brief Regression-specific prediction summary.
@@ -52,7 +54,7 @@ struct SummaryReg {
 	     const vector<double>& yTest);
 
 
-  static vector<vector<unique_ptr<TestReg>>> permute(const Predict* predict,
+  static vector<vector<unique_ptr<TestReg>>> permute(Predict* predict,
 						     const Sampler* sampler,
 						     const vector<double>& yTest);
 
@@ -126,7 +128,7 @@ struct SummaryCtg {
 	     const vector<unsigned int>& yTest);
 
 
-  static vector<vector<unique_ptr<TestCtg>>> permute(const Predict* predict,
+  static vector<vector<unique_ptr<TestCtg>>> permute(Predict* predict,
 						     const Sampler* sampler,
 						     const vector<unsigned int>& yTest);
 
@@ -188,6 +190,49 @@ struct SummaryCtg {
 };
 
 
+/**
+   @brief Forest weights in compressed sparse row form.
+ */
+struct ForestWeight {
+  vector<size_t> rowStart; ///< Per prediction, plus one:  offset of first entry.
+  vector<IndexT> obsIdx; ///< Training observations, ascending within prediction.
+  vector<double> weight; ///< Normalized weight, per entry.
+};
+
+
+/**
+   @brief Frame-wide state for permuting a single predictor.
+ */
+struct PermutePred {
+  const PredictorT nPredNum; ///< # numeric predictors.
+  const PredictorT corePred; ///< Core index of permuted predictor.
+  const bool isFactor; ///< Whether predictor is factor-valued.
+  const vector<double> colNum; ///< Row-ordered values iff numeric.
+  const vector<CtgT> colFac; ///< Row-ordered codes iff factor.
+  vector<unsigned int> treeSplit; ///< Trees splitting on the predictor.
+  vector<vector<IndexT>> head; ///< Per tree, per node:  first path node splitting; empty iff no split.
+
+  PermutePred(const Forest* forest,
+	      const RLEFrame* rleFrame,
+	      PredictorT nPredNum,
+	      PredictorT predIdx);
+
+
+  /**
+     @brief Substitutes permuted values into a block of transposed rows.
+
+     @param idxPerm maps each frame row to its permuted source row.
+
+     @param[in, out] numPerm, facPerm are the block's numeric and factor rows.
+   */
+  void substitute(const vector<size_t>& idxPerm,
+		  size_t obsStart,
+		  size_t span,
+		  vector<double>& numPerm,
+		  vector<CtgT>& facPerm) const;
+};
+
+
 /**
    @brief Invokes virtual prediction methods.
  */
@@ -195,17 +240,22 @@ class Predict {
 protected:
   static const size_t obsChunk; ///< Observation block dimension.
   static const unsigned int seqChunk;  ///< Effort to minimize false sharing.
+  static const size_t treeMajorBytes; ///< Forest size favoring tree-major walk.
 
 const unique_ptr<BitMatrix> bag; ///< Nonnull iff bagging.
   unique_ptr<RLEFrame> rleFrame;
+  unique_ptr<ColFrame> colFrame; ///< Nonnull iff direct prediction.
   const size_t nObs; ///< # observations under prediction.
 
   // Prediction state:
   unsigned int nTree; ///< Initialized by Forest under prediction.
   IndexT noNode; ///< Initialized by Forest under prediction.
   unique_ptr<PredictFrame> trFrame; ///< Initialized by RLEFrame, reset per block.
+  bool treeMajor; ///< Whether to walk blocks tree-major.
+  const QuickScorer* quickScorer; ///< Nonnull iff scoring by bitvector.
   size_t blockStart; ///< Index of observation heading current block.
   vector<IndexT> idxFinal; ///< Final walk index, typically terminal.
+  vector<IndexT> idxCache; ///< Frame-wide final indices iff permuting.
 
   void predictBlock(ForestPrediction* prediction);
 
@@ -217,6 +267,22 @@ const unique_ptr<BitMatrix> bag; ///< Nonnull iff bagging.
   void resetIndices();
 
 
+  /**
+     @brief Resumes the walks of a single tree affected by a permutation.
+
+     Walks never reaching a node splitting on the permuted predictor
+     retain their cached final index.  Rows are visited tree-major, so
+     that the tree's nodes remain cached across the block.
+
+     @param numPerm, facPerm are the block's rows, with substitution.
+   */
+  void resumeWalks(const PermutePred& permute,
+		   unsigned int tIdx,
+		   size_t span,
+		   const vector<double>& numPerm,
+		   const vector<CtgT>& facPerm);
+
+
   /**
      @brief Walks trees for a block of observations.
    */
@@ -224,6 +290,34 @@ const unique_ptr<BitMatrix> bag; ///< Nonnull iff bagging.
 		 size_t obsEnd);
 
 
+  /**
+     @brief Obtains final indices for a block by bitvector scoring.
+   */
+  void walkBits(size_t obsStart,
+		size_t obsEnd);
+
+
+  /**
+     @brief Walks all trees over a block, tree-major.
+
+     Favored when the node arrays overwhelm the cache, as each tree's
+     nodes are then fetched once per block rather than once per row.
+   */
+  void walkBlock(size_t obsStart,
+		 size_t obsEnd);
+
+
+  /**
+     @brief Walks a single tree over a block of observations.
+
+     Unbagged observations are gathered by scanning bag slots and
+     walked in lockstep groups.
+   */
+  void walkTree(unsigned int tIdx,
+		size_t obsStart,
+		size_t obsEnd);
+
+
   void setFinalIdx(size_t obsIdx, unsigned int tIdx, IndexT finalIdx) {
     idxFinal[nTree * (obsIdx - blockStart) + tIdx] = finalIdx;
   }
@@ -259,6 +353,13 @@ public:
 	  unique_ptr<RLEFrame> rleFrame_);
 
 
+  /**
+     @brief Direct constructor:  bypasses presorting.
+   */
+  Predict(const Sampler* sampler,
+	  unique_ptr<ColFrame> colFrame_);
+
+
   virtual ~Predict() = default;
 
 
@@ -270,6 +371,14 @@ public:
 					      unique_ptr<RLEFrame>);
 
 
+  static unique_ptr<PredictCtg> makeCtgDirect(const Sampler* sampler,
+						    unique_ptr<ColFrame>);
+
+
+  static unique_ptr<PredictReg> makeRegDirect(const Sampler* sampler,
+						    unique_ptr<ColFrame>);
+
+
   virtual unique_ptr<SummaryReg> predictReg(const Sampler* sampler,
 					    Forest* forest,
 					    const vector<double>& yTest) {
@@ -304,6 +413,14 @@ public:
   }
 
 
+  /**
+     @return # observations whose scores are held at once.
+   */
+  size_t getNStore() const {
+    return ForestPrediction::streams() ? min(nObs, obsChunk) : nObs;
+  }
+
+
   bool isNodeIdx(size_t obsIdx,
 		 unsigned int tIdx,
 		 double& score) const;
@@ -346,40 +463,84 @@ public:
 
   void predict(ForestPrediction* prediction);
 
+
+  /**
+     @brief Predicts under permutations of a single predictor.
+
+     Reuses the final indices cached by the unpermuted prediction.
+     Frame blocks are transposed once, for all repetitions.
+
+     @param predIdx is the frame index of the predictor to permute.
+
+     @param idxPerm are the row permutations, per repetition.
+
+     @param[out] prediction are the predictions, per repetition.
+   */
+  void predictPermute(PredictorT predIdx,
+		      const vector<vector<size_t>>& idxPerm,
+		      const vector<ForestPrediction*>& prediction);
+
+
+  /**
+     @brief Draws the row permutations of a predictor, in parallel.
+
+     Each repetition draws from a stream keyed by predictor and
+     repetition, so permutations do not depend upon thread count.
+
+     @return row permutation, per repetition.
+   */
+  static vector<vector<size_t>> drawPermutations(PredictorT predIdx,
+						 size_t nRow);
+
   
   /**
      @brief Computes Meinshausen's weight vectors for a block of predictions.
 
+     Parallelized over predictions, each accumulating sparsely.
+
      @param nPredict is tne number of predictions to weight.
 
      @param finalIdx is a block of nPredict x nTree prediction indices.
+
+     @param topK is the number of greatest weights retained per
+     prediction; zero retains all.
      
-     @return prediction-wide vector of response weights.
+     @return prediction-wide weights, in compressed sparse row form.
    */
-  static vector<double> forestWeight(const Forest* forest,
-				     const Sampler* sampler,
-				     size_t nPredict,
-				     const double finalIdx[]);
+  static ForestWeight forestWeight(const Forest* forest,
+				   const Sampler* sampler,
+				   size_t nPredict,
+				   const double finalIdx[],
+				   IndexT topK);
 
 
-  static vector<vector<struct IdCount>> obsCounts(const Forest* forest,
-						  const Sampler* sampler,
-						  unsigned int tIdx);
+  /**
+     @brief Accumulates the weights of samples subsumed by a node.
 
+     @param leafRange are the leaves dominated by the node.
 
-  static void weighNode(const Forest* forest,
-			const double treeIdx[],
-			const vector<vector<IdCount>>& nodeCount,
-			vector<vector<double>>& obsWeight);
+     @param[in, out] obsWeight accumulates unnormalized weights, per observation.
+
+     @param[in, out] touched accumulates the observations weighted.
+   */
+  static void weighNode(const Leaf& leaf,
+			unsigned int tIdx,
+			const IndexRange& leafRange,
+			vector<double>& obsWeight,
+			vector<IndexT>& touched);
 
 
   /**
-     @brief Normalizes each weight vector passed.
+     @brief Normalizes the weights accumulated by a prediction.
+
+     Weights are normalized before truncation to the greatest topK, so
+     truncated rows need not sum to unity.  Resets the accumulators.
 
-     @return vector of normalized weight vectors.
+     @return observation/weight pairs, ascending by observation.
    */
-  static vector<double> normalizeWeight(const Sampler* sampler,
-					const vector<vector<double>>& obsWeight);
+  static vector<pair<IndexT, double>> normalizeWeight(vector<double>& obsWeight,
+						     vector<IndexT>& touched,
+						     IndexT topK);
 };
 
 
@@ -389,6 +550,10 @@ struct PredictReg : public Predict {
 	     unique_ptr<RLEFrame> rleFrame_);
 
 
+  PredictReg(const Sampler* sampler,
+	     unique_ptr<ColFrame> colFrame_);
+
+
   ~PredictReg() = default;
 
   unique_ptr<SummaryReg> predictReg(const Sampler* sampler,
@@ -402,6 +567,10 @@ struct PredictCtg : public Predict {
   PredictCtg(const Sampler* sampler,
 	     unique_ptr<RLEFrame> rleFrame_);
 
+
+  PredictCtg(const Sampler* sampler,
+	     unique_ptr<ColFrame> colFrame_);
+
   
   ~PredictCtg() = default;
 
@@ -32,6 +32,7 @@
 #include "trainR.h"
 #include "samplerbridge.h"
 #include "signatureR.h"
+#include "streamR.h"
 
 #include <memory>
 #include <algorithm>
@@ -78,13 +79,9 @@ List PredictR::predict(const List& lDeframe,
   initPerInvocation(lArgs);
   ForestBridge::init(TrainR::nPred(lTrain));
 
-  List prediction;
   SamplerBridge samplerBridge(SamplerR::unwrapPredict(lSampler, lDeframe, as<bool>(lArgs[PredictR::strBagging])));
   ForestBridge forestBridge(ForestR::unwrap(lTrain, samplerBridge));
-  if (Rf_isFactor((SEXP) lSampler[SamplerR::strYTrain]))
-    prediction = predictCtg(lDeframe, lSampler, samplerBridge, forestBridge, sYTest);
-  else
-    prediction = predictReg(lDeframe, samplerBridge, forestBridge, sYTest);
+  List prediction = predictBridged(lDeframe, lSampler, lArgs, samplerBridge, forestBridge, sYTest);
 
   ForestBridge::deInit();
 
@@ -95,6 +92,21 @@ List PredictR::predict(const List& lDeframe,
 }
 
 
+List PredictR::predictBridged(const List& lDeframe,
+			      const List& lSampler,
+			      const List& lArgs,
+			      const SamplerBridge& samplerBridge,
+			      ForestBridge& forestBridge,
+			      const SEXP sYTest) {
+  if (lArgs.containsElementNamed(StreamR::strStream.c_str()) && !Rf_isNull(lArgs[StreamR::strStream]))
+    return StreamR::predict(lArgs[StreamR::strStream], lSampler, samplerBridge, forestBridge);
+  else if (Rf_isFactor((SEXP) lSampler[SamplerR::strYTrain]))
+    return predictCtg(lDeframe, lSampler, samplerBridge, forestBridge, sYTest);
+  else
+    return predictReg(lDeframe, samplerBridge, forestBridge, sYTest);
+}
+
+
 // [[Rcpp::export]]
 List PredictR::predictReg(const List& lDeframe,
 			  const SamplerBridge& samplerBridge,
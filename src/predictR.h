@@ -91,6 +91,21 @@ struct PredictR {
 		      const SEXP sYTest);
 
 
+  /**
+     @brief Dispatches by response type, given unwrapped bridges.
+
+     Streams to the sink named by lArgs, if any, in place of retaining.
+
+     @return wrapped prediction.
+   */
+  static List predictBridged(const List& lDeframe,
+			     const List& lSampler,
+			     const List& lArgs,
+			     const SamplerBridge& samplerBridge,
+			     struct ForestBridge& forestBridge,
+			     const SEXP sYTest);
+
+
   /**
      @brief Instantiates core classification object and summarizes.
 
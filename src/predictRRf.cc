@@ -30,11 +30,17 @@
 
 // [[Rcpp::export]]
 void PredictR::initPerInvocation(const List& lArgs) {
+  unsigned int impPermute = as<unsigned int>(lArgs[strImpPermute]);
   PredictBridge::initPredict(as<bool>(lArgs[strIndexing]),
 			     as<bool>(lArgs[strBagging]),
-			     as<unsigned int>(lArgs[strImpPermute]),
+			     impPermute,
 			     as<bool>(lArgs[strTrapUnobserved]));
   PredictBridge::initQuant(quantVec(lArgs));
   PredictBridge::initCtgProb(as<bool>(lArgs[strCtgProb]));
   CoreBridge::init(as<unsigned int>(lArgs[strNThread]));
+
+  // Only permutation draws variates, so the session's RNG state is
+  // otherwise left undisturbed.
+  if (impPermute > 0)
+    CoreBridge::seed();
 }
@@ -86,11 +86,23 @@ void PredictBridge::initCtgProb(bool doProb) {
 }
 
 
-vector<double> PredictBridge::forestWeight(const ForestBridge& forestBridge,
-					   const SamplerBridge& samplerBridge,
-					   const double indices[],
-					   size_t nObs) {
-  return Predict::forestWeight(forestBridge.getForest(), samplerBridge.getSampler(), nObs, indices);
+void PredictBridge::initSink(PredictSink* sink) {
+  FEPredict::initSink(sink);
+}
+
+
+void PredictBridge::forestWeight(const ForestBridge& forestBridge,
+				 const SamplerBridge& samplerBridge,
+				 const double indices[],
+				 size_t nObs,
+				 unsigned int topK,
+				 vector<size_t>& rowStart,
+				 vector<unsigned int>& obsIdx,
+				 vector<double>& weight) {
+  ForestWeight forestWeight = Predict::forestWeight(forestBridge.getForest(), samplerBridge.getSampler(), nObs, indices, topK);
+  rowStart = std::move(forestWeight.rowStart);
+  obsIdx = std::move(forestWeight.obsIdx);
+  weight = std::move(forestWeight.weight);
 }
 
 
@@ -58,18 +58,38 @@ struct PredictBridge {
   static void initCtgProb(bool doProb);
 
 
+  /**
+     @brief Installs a block-wise output sink, or null to retain output.
+
+     Must follow initPredict(), which resets the sink.
+   */
+  static void initSink(struct PredictSink* sink);
+
+
   size_t getNObs() const;
 
 
   /**
-     @brief Computes Meinshausen-style weight vectors over a set of observations.
-     
-     @return vector of normalized weight vectors.
+     @brief Computes Meinshausen-style weights over a set of observations.
+
+     @param topK is the number of greatest weights retained per
+     observation; zero retains all.
+
+     @param[out] rowStart outputs the offset of each observation's first
+     entry, followed by the entry count.
+
+     @param[out] obsIdx outputs the training observation of each entry.
+
+     @param[out] weight outputs the normalized weight of each entry.
    */
-  static vector<double> forestWeight(const struct ForestBridge& forestBridge,
-				     const struct SamplerBridge& samplerBridge,
-				     const double indices[],
-				     size_t nObs);
+  static void forestWeight(const struct ForestBridge& forestBridge,
+			   const struct SamplerBridge& samplerBridge,
+			   const double indices[],
+			   size_t nObs,
+			   unsigned int topK,
+			   vector<size_t>& rowStart,
+			   vector<unsigned int>& obsIdx,
+			   vector<double>& weight);
 };
 
 
@@ -14,6 +14,7 @@
  */
 
 #include "rleframe.h"
+#include "colframe.h"
 #include "predictframe.h"
 
 // Inclusion only:
@@ -27,6 +28,12 @@ PredictFrame::PredictFrame(const RLEFrame* frame) :
 }
 
 
+PredictFrame::PredictFrame(const ColFrame* frame) :
+  nPredNum(frame->getNPredNum()),
+  nPredFac(frame->getNPredFac()) {
+}
+
+
 void PredictFrame::transpose(const RLEFrame* frame,
 			     size_t obsStart,
 			     size_t extent) {
@@ -36,3 +43,11 @@ void PredictFrame::transpose(const RLEFrame* frame,
   frame->transpose(idxTr, obsStart, extent, num, fac);
 }
 
+
+
+void PredictFrame::transpose(const ColFrame* frame,
+			     size_t obsStart,
+			     size_t extent) {
+  baseObs = obsStart;
+  frame->transpose(obsStart, extent, num, fac);
+}
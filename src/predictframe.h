@@ -23,6 +23,7 @@
 using namespace std;
 
 struct RLEFrame;
+struct ColFrame;
 
 /**
    @brief Transposed section of an RLEFrame.
@@ -40,11 +41,22 @@ public:
   PredictFrame(const RLEFrame* frame);
 
 
+  PredictFrame(const ColFrame* frame);
+
+
   void transpose(const RLEFrame* frame,
 		 size_t obsStart,
 		 size_t obsExtent);
 
 
+  /**
+     @brief As above, but gathers directly from unsorted columns.
+   */
+  void transpose(const ColFrame* frame,
+		 size_t obsStart,
+		 size_t obsExtent);
+
+
   /**
      @return # numeric predictors.
 
@@ -7,8 +7,10 @@
 #include "prediction.h"
 #include "quant.h"
 #include "response.h"
+#include "predictsink.h"
 
 bool ForestPrediction::reportIndices = false;
+PredictSink* ForestPrediction::sink = nullptr;
 bool CtgProb::reportProbabilities = false;
 
 
@@ -28,7 +30,34 @@ ForestPrediction::ForestPrediction(const Predict* predict,
 				   const struct ScoreDesc* scoreDesc) :
   baseScore(scoreDesc->baseScore),
   nu(scoreDesc->nu),
-  idxFinal(vector<size_t>(reportIndices ? predict->getNTree() * predict->getNObs() : 0)) {
+  idxFinal(vector<size_t>((reportIndices && !streams()) ? predict->getNTree() * predict->getNObs() : 0)),
+  storeBase(0) {
+}
+
+
+void ForestPrediction::finishBlock(const Predict* predict,
+				   vector<IndexT>& indices,
+				   size_t span,
+				   size_t obsStart) {
+  unsigned int nTree = predict->getNTree();
+  if (!streams()) {
+    cacheIndices(indices, span * nTree, obsStart * nTree);
+    return;
+  }
+
+  if (reportIndices) {
+    // Node indices are block-local, so are resolved to leaves here.
+    vector<IndexT> leafIdx(span * nTree);
+    for (size_t row = 0; row != span; row++) {
+      for (unsigned int tIdx = 0; tIdx != nTree; tIdx++) {
+	IndexT& leaf = leafIdx[row * nTree + tIdx];
+	if (!predict->isLeafIdx(obsStart + row, tIdx, leaf))
+	  leaf = PredictSink::noLeaf;
+      }
+    }
+    sink->indices(obsStart, span, nTree, &leafIdx[0]);
+  }
+  streamScores(obsStart, span);
 }
 
 
@@ -47,10 +76,10 @@ ForestPredictionCtg::ForestPredictionCtg(const ScoreDesc* scoreDesc,
   ForestPrediction(predict, scoreDesc),
   scorer(scorerTable[scoreDesc->scorer]),
   nCtg(sampler->getNCtg()),
-  prediction(Prediction<CtgT>(predict->getNObs())),
+  prediction(Prediction<CtgT>(predict->getNStore())),
   defaultPrediction(reinterpret_cast<const ResponseCtg*>(sampler->getResponse())->getDefaultPrediction()),
-  census(predict->getNObs() * nCtg),
-  ctgProb(make_unique<CtgProb>(sampler, predict->getNObs(), reportAuxiliary)) {
+  census(predict->getNStore() * nCtg),
+  ctgProb(make_unique<CtgProb>(sampler, predict->getNStore(), reportAuxiliary)) {
 }
 
 
@@ -60,7 +89,7 @@ ForestPredictionReg::ForestPredictionReg(const ScoreDesc* scoreDesc,
 					 bool reportAuxiliary) :
   ForestPrediction(predict, scoreDesc),
   scorer(scorerTable[scoreDesc->scorer]),
-  prediction(Prediction<double>(predict->getNObs())),
+  prediction(Prediction<double>(predict->getNStore())),
   defaultPrediction(reinterpret_cast<const ResponseReg*>(sampler->getResponse())->getDefaultPrediction()),
   quant(make_unique<Quant>(sampler, predict, reportAuxiliary)) {
 }
@@ -111,9 +140,9 @@ ScoreCount ForestPredictionCtg::predictLogOdds(const Predict* predict, size_t ob
 void ForestPredictionCtg::predictLogistic(const Predict* predict, size_t obsIdx) {
   ScoreCount logOdds = predictLogOdds(predict, obsIdx);
   double p1 = 1.0 / (1.0 + exp(-logOdds.score.num));
-  ctgProb->assignBinary(obsIdx, p1); // LOWER
+  ctgProb->assignBinary(storeIdx(obsIdx), p1); // LOWER
   CtgT ctg = p1 > 0.5 ? 1 : 0;
-  census[obsIdx * nCtg + ctg] = 1;
+  census[storeIdx(obsIdx) * nCtg + ctg] = 1;
   setScore(obsIdx, ScoreCount(logOdds.nEst, ctg));
 }
 
@@ -121,7 +150,7 @@ void ForestPredictionCtg::predictLogistic(const Predict* predict, size_t obsIdx)
 void ForestPredictionCtg::predictPlurality(const Predict* predict, size_t obsIdx) {
   unsigned int nEst = 0; // # participating trees.
   vector<double> ctgJitter(nCtg); // Accumulates jitter by category.
-  unsigned int *censusRow = &census[obsIdx * nCtg];
+  unsigned int *censusRow = &census[storeIdx(obsIdx) * nCtg];
   for (unsigned int tIdx = 0; tIdx != predict->getNTree(); tIdx++) {
     double score;
     if (predict->isNodeIdx(obsIdx, tIdx, score)) {
@@ -145,7 +174,7 @@ void ForestPredictionCtg::predictPlurality(const Predict* predict, size_t obsIdx
     }
   }
 
-  ctgProb->predictRow(obsIdx, numVec, nEst); // LOWER
+  ctgProb->predictRow(storeIdx(obsIdx), numVec, nEst); // LOWER
   setScore(obsIdx, ScoreCount(nEst, argMaxJitter(numVec)));
 }
 
@@ -164,7 +193,16 @@ CtgT ForestPredictionCtg::argMaxJitter(const vector<double>& numVec) const {
 }
 
 void ForestPredictionCtg::setScore(size_t obsIdx, ScoreCount score) {
-  prediction.setScore(obsIdx, score.score.ctg);
+  prediction.setScore(storeIdx(obsIdx), score.score.ctg);
+}
+
+
+void ForestPredictionCtg::streamScores(size_t obsStart,
+				       size_t span) {
+  sink->scoresCtg(obsStart, span, nCtg, &prediction.value[0], &census[0],
+		  ctgProb->isEmpty() ? nullptr : &ctgProb->getProb()[0]);
+  // Census accumulates, so must be cleared for the next block.
+  fill(census.begin(), census.end(), 0);
 }
 
 
@@ -174,12 +212,21 @@ const vector<double>& ForestPredictionCtg::getProb() const {
 
 
 void ForestPredictionReg::setScore(const Predict* predict, size_t obsIdx, ScoreCount score) {
-  prediction.setScore(obsIdx, score.score.num);
+  prediction.setScore(storeIdx(obsIdx), score.score.num);
   // Relies on score having been assigned:
   quant->predictRow(predict, this, obsIdx);
 }
 
 
+void ForestPredictionReg::streamScores(size_t obsStart,
+				       size_t span) {
+  bool quantiles = !quant->isEmpty();
+  sink->scoresReg(obsStart, span, &prediction.value[0], quant->getNQuant(),
+		  quantiles ? &quant->getQPred()[0] : nullptr,
+		  quantiles ? &quant->getQEst()[0] : nullptr);
+}
+
+
 unique_ptr<TestReg> ForestPredictionReg::test(const vector<double>& yTest) const {
   if (yTest.empty())
     return make_unique<TestReg>();
@@ -321,11 +368,18 @@ const vector<double>& ForestPredictionReg::getQEst() const {
 
 void ForestPrediction::init(bool indexing) {
   reportIndices = indexing;
+  sink = nullptr;
+}
+
+
+void ForestPrediction::initSink(PredictSink* sink_) {
+  sink = sink_;
 }
 
 
 void ForestPrediction::deInit() {
   reportIndices = false;
+  sink = nullptr;
 }
 
 
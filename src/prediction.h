@@ -81,11 +81,13 @@ struct Prediction {
 
 struct ForestPrediction {
   static bool reportIndices;
+  static struct PredictSink* sink; ///< Nonnull iff streaming by block.
   
   const double baseScore;
   const double nu;
 
   vector<size_t> idxFinal; ///< Final index of tree walk; auxilliary.
+  size_t storeBase; ///< First observation held; nonzero only if streaming.
   
   ForestPrediction(const class Predict* predict,
 		   const struct ScoreDesc* scoreDesc);
@@ -98,6 +100,43 @@ struct ForestPrediction {
   static void deInit();
 
 
+  /**
+     @brief Installs a sink, or null, for the current invocation.
+   */
+  static void initSink(struct PredictSink* sink_);
+
+
+  static bool streams() {
+    return sink != nullptr;
+  }
+
+
+  /**
+     @return offset of an observation within score storage.
+   */
+  size_t storeIdx(size_t obsIdx) const {
+    return obsIdx - storeBase;
+  }
+
+
+  /**
+     @brief Rebases score storage, if streaming, at the head of a block.
+   */
+  void beginBlock(size_t obsStart) {
+    if (streams())
+      storeBase = obsStart;
+  }
+
+
+  /**
+     @brief Caches final indices or streams the completed block.
+   */
+  void finishBlock(const class Predict* predict,
+		   vector<IndexT>& indices,
+		   size_t span,
+		   size_t obsStart);
+
+
   /**
      @brief Caches final tree-walk indices.
    */
@@ -106,6 +145,13 @@ struct ForestPrediction {
 		    size_t obsStart);
 
 
+  /**
+     @brief Passes the block's scores to the sink and readies storage.
+   */
+  virtual void streamScores(size_t obsStart,
+			    size_t span) = 0;
+
+
   virtual void callScorer(const class Predict*, size_t obsStart, size_t obsEnd) = 0;
 };
 
@@ -160,6 +206,10 @@ struct ForestPredictionCtg : public ForestPrediction {
   void setScore(size_t obsIdx, ScoreCount score);
 
 
+  void streamScores(size_t obsStart,
+		    size_t span);
+
+
   unique_ptr<struct TestCtg> test(const vector<CtgT>& yTest) const;
 
   
@@ -200,11 +250,15 @@ struct ForestPredictionReg : public ForestPrediction {
 		  size_t obsIdx);
 
 
+  void streamScores(size_t obsStart,
+		    size_t span);
+
+
   unique_ptr<struct TestReg> test(const vector<double>& yTest) const;
 
   
   double getValue(size_t obsIdx) const {
-    return prediction.value[obsIdx];
+    return prediction.value[storeIdx(obsIdx)];
   }
   
 
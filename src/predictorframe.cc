@@ -22,6 +22,7 @@
 
 PredictorFrame::PredictorFrame(unique_ptr<RLEFrame> rleFrame_,
 			       double autoCompress,
+			       IndexT nBin_,
 			       bool enableCoproc,
 			       vector<string>& diag) :
   rleFrame(std::move(rleFrame_)),
@@ -35,7 +36,10 @@ PredictorFrame::PredictorFrame(unique_ptr<RLEFrame> rleFrame_,
   feIndex(mapPredictors(rleFrame->factorTop)),
   noRank(rleFrame->noRank),
   denseThresh(autoCompress * nObs),
+  nBin(nBin_),
   row2Rank(vector<vector<IndexT>>(nPred)),
+  rank2Code(vector<vector<IndexT>>(nPred)),
+  binFloor(vector<vector<IndexT>>(nPred)),
   nonCompact(0),
   lengthCompact(0) {
   implExpl = denseBlock();
@@ -60,14 +64,19 @@ vector<Layout> PredictorFrame::denseBlock() {
 
 Layout PredictorFrame::surveyRanks(PredictorT predIdx) {
   IndexT rankMissing = rleFrame->findRankMissing(feIndex[predIdx]);
-  
+  if (nBin > 0 && !isFactor(predIdx) && getRankMax(predIdx) >= nBin) {
+    binRanks(predIdx, rankMissing);
+    if (rankMissing != noRank)
+      rankMissing = rank2Code[predIdx][rankMissing];
+  }
+
   row2Rank[predIdx] = vector<IndexT>(nObs);
   IndexT denseMax = 0; // Running maximum of run counts.
   PredictorT argMax = noRank;
   PredictorT rankPrev = noRank; // Forces write on first iteration.
   IndexT obsCount = 0; // Dummy initialization:  written before read.
   for (auto rle : getRLE(predIdx)) {
-    IndexT rank = rle.val;
+    IndexT rank = getCode(predIdx, rle.val);
     IndexT extent = rle.extent;
     if (rank == rankPrev) {
       obsCount += extent;
@@ -94,6 +103,30 @@ Layout PredictorFrame::surveyRanks(PredictorT predIdx) {
 }
 
 
+void PredictorFrame::binRanks(PredictorT predIdx,
+			      IndexT rankMissing) {
+  vector<IndexT>& code = rank2Code[predIdx];
+  vector<IndexT>& floorRank = binFloor[predIdx];
+  code = vector<IndexT>(getRankMax(predIdx) + 1);
+  size_t obsSeen = 0; // # observations of lower rank.
+  size_t slotPrev = 0;
+  IndexT rankPrev = noRank;
+  for (auto rle : getRLE(predIdx)) { // Rank-ordered.
+    IndexT rank = rle.val;
+    if (rank != rankPrev) {
+      size_t slot = (obsSeen * nBin) / nObs;
+      if (floorRank.empty() || slot != slotPrev || rank == rankMissing) {
+	floorRank.push_back(rank);
+	slotPrev = slot;
+      }
+      rankPrev = rank;
+    }
+    code[rank] = floorRank.size() - 1;
+    obsSeen += rle.extent;
+  }
+}
+
+
 void PredictorFrame::obsPredictorFrame() {
   IndexT nPredDense = 0;
   for (auto & ie : implExpl) {
@@ -161,8 +194,13 @@ bool PredictorFrame::isFactor(const SplitNux& nux) const {
 }
 
 
+PredictorT PredictorFrame::getFactorExtent(PredictorT predIdx) const {
+  return rleFrame->getFactorTop(feIndex[predIdx]);
+}
+
+
 PredictorT PredictorFrame::getFactorExtent(const class SplitNux& nux) const {
-  return rleFrame->getFactorTop(feIndex[nux.getPredIdx()]);
+  return getFactorExtent(nux.getPredIdx());
 }
 
 
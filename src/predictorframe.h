@@ -62,8 +62,11 @@ class PredictorFrame {
   const vector<PredictorT> feIndex; ///< Maps core predictor index to user position.
   const PredictorT noRank; // Inattainable rank value.
   const IndexT denseThresh; // Threshold run length for autocompression.
+  const IndexT nBin; ///< Maximum # cut positions per numeric predictor; zero iff exact.
 
   vector<vector<IndexT>> row2Rank;
+  vector<vector<IndexT>> rank2Code; ///< Bin code of each rank; empty iff exact.
+  vector<vector<IndexT>> binFloor; ///< Lowest rank of each bin; empty iff exact.
   PredictorT nonCompact;  // Total count of uncompactified predictors.
   IndexT lengthCompact;  // Sum of compactified lengths.
   vector<Layout> implExpl;
@@ -117,6 +120,19 @@ class PredictorFrame {
    */
   Layout surveyRanks(PredictorT predIdx);
 
+
+  /**
+     @brief Quantizes the ranks of a numeric predictor into bins of
+     roughly equal population.
+
+     Runs of a single rank are never divided.  Missing data, if any,
+     occupies a bin of its own.
+
+     @param rankMissing is the rank denoting missing data, if any.
+   */
+  void binRanks(PredictorT predIdx,
+		IndexT rankMissing);
+
   
 public:
 
@@ -124,6 +140,7 @@ public:
   static PredictorFrame *Factory(unique_ptr<RLEFrame> rleFrame,
 				 const class Coproc *coproc,
 				 double autoCompress,
+				 IndexT nBin,
 				 vector<string>& diag);
 
 
@@ -133,9 +150,14 @@ public:
      @param feRow is the vector of rows allocated by the front end.
 
      @param feRank is the vector of ranks allocated by the front end.
+
+     @param nBin bounds the number of bins per numeric predictor, so
+     coarsening its cuts:  zero retains exact ranks.  Staging and
+     splitting are otherwise unchanged.
  */
   PredictorFrame(unique_ptr<RLEFrame> rleFrame_,
 		 double autoCompress,
+		 IndexT nBin,
 		 bool enableCoproc,
 		 vector<string>& diag);
 
@@ -203,6 +225,22 @@ public:
   }
 
   
+  /**
+     @return count of observations not represented implicitly.
+   */
+  IndexT getExplicitCount(PredictorT predIdx) const {
+    return implExpl[predIdx].countExpl;
+  }
+
+
+  /**
+     @return true iff predictor's ranks are coded by bin.
+   */
+  bool isBinned(PredictorT predIdx) const {
+    return !rank2Code[predIdx].empty();
+  }
+
+  
   /**
      @brief Computes a conservative buffer size, allowing strided access
      for noncompact predictors but full-width access for compact predictors.
@@ -250,6 +288,41 @@ public:
     return rleFrame->getRLE(feIndex[predIdx]).back().val;
   }
 
+
+  /**
+     @brief Maps a frame rank to the code under which it is trained.
+
+     @return bin code, if predictor binned, else the rank itself.
+   */
+  IndexT getCode(PredictorT predIdx,
+		 IndexT rank) const {
+    return rank2Code[predIdx].empty() ? rank : rank2Code[predIdx][rank];
+  }
+
+
+  /**
+     @brief Expresses a cut between two codes as a range of frame ranks.
+
+     A cut between bins spans from the top rank of the left bin to the
+     bottom rank of the right.
+
+     @param codeLeft is the code to the left of the cut.
+
+     @param codeRight is the code to the right, strictly greater.
+
+     @return rank range suitable for interpolation.
+   */
+  IndexRange getRankRange(PredictorT predIdx,
+			  IndexT codeLeft,
+			  IndexT codeRight) const {
+    if (binFloor[predIdx].empty())
+      return IndexRange(codeLeft, codeRight - codeLeft);
+
+    IndexT rankLeft = binFloor[predIdx][codeLeft + 1] - 1;
+    IndexT rankRight = binFloor[predIdx][codeRight];
+    return IndexRange(rankLeft, rankRight - rankLeft);
+  }
+
   
   /**
      @brief Determines whether predictor is numeric or factor.
@@ -270,6 +343,9 @@ public:
 
      @return top observed index value (zero iff non-factor).
    */
+  PredictorT getFactorExtent(PredictorT predIdx) const;
+
+
   PredictorT getFactorExtent(const class SplitNux& nux) const;
 
 
@@ -0,0 +1,85 @@
+// This file is part of ArboristCore.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file predictsink.h
+
+   @brief Interface receiving prediction output block by block.
+
+   @author Mark Seligman
+ */
+
+#ifndef FOREST_PREDICTSINK_H
+#define FOREST_PREDICTSINK_H
+
+#include "typeparam.h"
+
+#include <cstddef>
+
+
+/**
+   @brief Consumer of streamed prediction.
+
+   When a sink is installed, prediction retains neither terminal
+   indices nor scores beyond the current observation block:  each
+   completed block is handed to the sink and its storage reused.
+   Blocks arrive in observation order, from the calling thread.
+
+   Arrays are row-major and span only the block.  Observation indices
+   are zero-based and frame-wide.
+ */
+struct PredictSink {
+  static constexpr IndexT noLeaf = ~IndexT(0); ///< No terminal reached.
+
+  virtual ~PredictSink() = default;
+
+
+  /**
+     @brief Receives terminal leaf indices, if indexing.
+
+     @param leafIdx holds nTree tree-relative leaf indices per row, or
+     noLeaf where the walk was bagged or trapped at a nonterminal.
+   */
+  virtual void indices(size_t obsStart,
+		       size_t span,
+		       unsigned int nTree,
+		       const IndexT leafIdx[]) = 0;
+
+
+  /**
+     @brief Receives regression scores.
+
+     @param qPred holds qCount quantiles per row; null if not requested.
+
+     @param qEst holds a quantile estimate per row; null iff qPred null.
+   */
+  virtual void scoresReg(size_t obsStart,
+			 size_t span,
+			 const double yPred[],
+			 unsigned int qCount,
+			 const double qPred[],
+			 const double qEst[]) = 0;
+
+
+  /**
+     @brief Receives classification scores.
+
+     @param yPred holds zero-based training categories.
+
+     @param census holds nCtg vote counts per row.
+
+     @param prob holds nCtg probabilities per row; null if not requested.
+   */
+  virtual void scoresCtg(size_t obsStart,
+			 size_t span,
+			 CtgT nCtg,
+			 const CtgT yPred[],
+			 const unsigned int census[],
+			 const double prob[]) = 0;
+};
+
+#endif
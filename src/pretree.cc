@@ -82,12 +82,54 @@ void PreTree::addCriterion(const SplitFrontier* sf,
     critCut(sf, nux);
   }
 
+  branch(nux.getPTId(), nux.invertTest(), nux.getInfo(), preallocated);
+}
+
+
+void PreTree::branch(IndexT ptId,
+		     bool invert,
+		     double info,
+		     bool preallocated) {
   offspring(preallocated ? 0 : 1);
-  DecNode& node = getNode(nux.getPTId());
-  node.setInvert(nux.invertTest());
-  node.setDelIdx(getHeight() - 2 - nux.getPTId());
-  infoNode[nux.getPTId()] = nux.getInfo();
-  infoLocal[node.getPredIdx()] += nux.getInfo();
+  DecNode& node = getNode(ptId);
+  node.setInvert(invert);
+  node.setDelIdx(getHeight() - 2 - ptId);
+  infoNode[ptId] = info;
+  infoLocal[node.getPredIdx()] += info;
+}
+
+
+IndexT PreTree::graftCut(IndexT ptId,
+			 PredictorT predIdx,
+			 double quantRank,
+			 bool invert,
+			 double info) {
+  getNode(ptId).critCut(predIdx, quantRank);
+  branch(ptId, invert, info);
+  return getIdTrue(ptId);
+}
+
+
+IndexT PreTree::graftBits(IndexT ptId,
+			  PredictorT predIdx,
+			  PredictorT bitCount,
+			  const vector<IndexT>& codeTrue,
+			  const vector<IndexT>& codeObserved,
+			  bool invert,
+			  double info) {
+  auto bitPos = bitEnd;
+  bitEnd += bitCount;
+  splitBits.resize(bitEnd);
+  observedBits.resize(bitEnd);
+  for (IndexT code : codeTrue) {
+    splitBits.setBit(bitPos + code);
+  }
+  for (IndexT code : codeObserved) {
+    observedBits.setBit(bitPos + code);
+  }
+  getNode(ptId).critBits(predIdx, bitPos);
+  branch(ptId, invert, info);
+  return getIdTrue(ptId);
 }
 
 
@@ -119,6 +161,7 @@ void PreTree::consume(Grove* grove) const {
   grove->consumeTree(nodeVec, scores);
   grove->consumeBits(splitBits, observedBits, bitEnd);
   grove->consumeInfo(infoLocal);
+  grove->consumeRestage(restageVolume);
 }
 
 
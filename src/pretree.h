@@ -38,6 +38,7 @@ class PreTree {
   IndexT leafCount; // Running count of leaves.
   vector<double> infoLocal; //< Per-predictor split information.
   vector<double> infoNode; ///< Per-node " ".  Leaf merging onlye.
+  vector<size_t> restageVolume; ///< # observations restaged, by cause.
   SampleMap terminalMap;
 
 
@@ -62,6 +63,16 @@ class PreTree {
   void setLeafIndices();
 
 
+  /**
+     @brief Converts a terminal to a nonterminal whose criterion has been set.
+
+     @param preallocated indicates whether offspring already allocated.
+   */
+  void branch(IndexT ptId,
+	      bool invert,
+	      double info,
+	      bool preallocated = false);
+
   
  public:
   /**
@@ -127,6 +138,38 @@ class PreTree {
   void critCut(const class SplitFrontier* sf,
 	       const class SplitNux& nux);
 
+
+  /**
+     @brief Appends a cut-based split found outside the frontier.
+
+     @param ptId is the terminal to convert.
+
+     @param quantRank is the fractional rank of the cut.
+
+     @return pretree index of the true successor.
+   */
+  IndexT graftCut(IndexT ptId,
+		  PredictorT predIdx,
+		  double quantRank,
+		  bool invert,
+		  double info);
+
+
+  /**
+     @brief As above, but for a bit-based split.
+
+     @param codeTrue are the codes taking the true branch.
+
+     @param codeObserved are all codes observed at the node.
+   */
+  IndexT graftBits(IndexT ptId,
+		   PredictorT predIdx,
+		   PredictorT bitCount,
+		   const vector<IndexT>& codeTrue,
+		   const vector<IndexT>& codeObserved,
+		   bool invert,
+		   double info);
+
   
   /**
      @brief Consumes all pretree nonterminal information into crescent forest.
@@ -146,6 +189,12 @@ class PreTree {
   void setScore(const class IndexSet& iSet,
 		double score);
 
+
+  void setScore(IndexT ptId,
+		double score) {
+    scores[ptId] = score;
+  }
+
   
   double getScore(IndexT idx) const {
     return scores[idx];
@@ -166,6 +215,14 @@ class PreTree {
    */
   void setTerminals(const class SampledObs* sampledObs,
 		    SampleMap smTerminal);
+
+
+  /**
+     @brief Records the restaging tally for consumption by the grove.
+   */
+  void setRestageVolume(const vector<size_t>& volume) {
+    restageVolume = volume;
+  }
   
 
   /**
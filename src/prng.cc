@@ -0,0 +1,201 @@
+// This file is part of ArboristCore.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file prng.cc
+
+   @brief Philox4x32-10 instantiation of the PRNG methods.
+
+   @author Mark Seligman
+ */
+
+#include "prng.h"
+
+#include <array>
+
+namespace PRNG {
+  /**
+     @brief Per-thread stream coordinates and counters.
+   */
+  struct Stream {
+    uint32_t major; ///< Typically the tree index.
+    uint32_t minor; ///< Typically the level.
+    uint64_t block[static_cast<uint32_t>(Purpose::nPurpose)]; ///< Next block, per purpose.
+  };
+
+  static uint64_t sessionSeed = 0;
+  static thread_local Stream stream = {};
+
+
+  /**
+     @brief Encrypts a counter under the session key.
+
+     @return four 32-bit outputs.
+   */
+  static array<uint32_t, 4> philox(array<uint32_t, 4> ctr) {
+    constexpr uint32_t mul0 = 0xD2511F53;
+    constexpr uint32_t mul1 = 0xCD9E8D57;
+    constexpr uint32_t weyl0 = 0x9E3779B9;
+    constexpr uint32_t weyl1 = 0xBB67AE85;
+
+    uint32_t key0 = static_cast<uint32_t>(sessionSeed);
+    uint32_t key1 = static_cast<uint32_t>(sessionSeed >> 32);
+    for (unsigned int round = 0; round != 10; round++) {
+      uint64_t prod0 = static_cast<uint64_t>(mul0) * ctr[0];
+      uint64_t prod1 = static_cast<uint64_t>(mul1) * ctr[2];
+      ctr = { static_cast<uint32_t>(prod1 >> 32) ^ ctr[1] ^ key0,
+	      static_cast<uint32_t>(prod1),
+	      static_cast<uint32_t>(prod0 >> 32) ^ ctr[3] ^ key1,
+	      static_cast<uint32_t>(prod0) };
+      key0 += weyl0;
+      key1 += weyl1;
+    }
+    return ctr;
+  }
+
+
+  /**
+     @return variate on the open unit interval, from 53 random bits.
+   */
+  static double unitOpen(uint32_t hi,
+			 uint32_t lo) {
+    uint64_t bits = ((static_cast<uint64_t>(hi) << 32) | lo) >> 11;
+    return (bits + 0.5) * 0x1.0p-53;
+  }
+
+
+  /**
+     @brief Encrypts a block of the calling thread's stream.
+   */
+  static array<uint32_t, 4> blockOut(uint64_t block,
+				     uint32_t purposeIdx) {
+    return philox({ static_cast<uint32_t>(block),
+		    (purposeIdx << 24) | static_cast<uint32_t>((block >> 32) & 0xFFFFFF),
+		    stream.minor,
+		    stream.major });
+  }
+
+
+  /**
+     @brief Draws variates from the calling thread's stream.
+
+     Each block yields two variates.  An odd trailing variate discards
+     the remainder of its block.
+   */
+  static void fill(vector<double>& variate,
+		   Purpose purpose) {
+    uint32_t purposeIdx = static_cast<uint32_t>(purpose);
+    uint64_t& block = stream.block[purposeIdx];
+    for (size_t idx = 0; idx < variate.size(); idx += 2) {
+      array<uint32_t, 4> out = blockOut(block++, purposeIdx);
+      variate[idx] = unitOpen(out[0], out[1]);
+      if (idx + 1 < variate.size())
+	variate[idx + 1] = unitOpen(out[2], out[3]);
+    }
+  }
+}
+
+
+vector<double> PRNG::rUnifAt(uint64_t offset,
+			     size_t nSamp,
+			     Purpose purpose) {
+  uint32_t purposeIdx = static_cast<uint32_t>(purpose);
+  uint64_t block = stream.block[purposeIdx] + offset / 2;
+  vector<double> variate(nSamp);
+  size_t idx = 0;
+  if (offset & 1) { // Window begins mid-block.
+    array<uint32_t, 4> out = blockOut(block++, purposeIdx);
+    if (nSamp > 0)
+      variate[idx++] = unitOpen(out[2], out[3]);
+  }
+  for (; idx < nSamp; idx += 2) {
+    array<uint32_t, 4> out = blockOut(block++, purposeIdx);
+    variate[idx] = unitOpen(out[0], out[1]);
+    if (idx + 1 < nSamp)
+      variate[idx + 1] = unitOpen(out[2], out[3]);
+  }
+
+  return variate;
+}
+
+
+double PRNG::unifAt(uint64_t offset,
+		    Purpose purpose) {
+  uint32_t purposeIdx = static_cast<uint32_t>(purpose);
+  array<uint32_t, 4> out = blockOut(stream.block[purposeIdx] + offset / 2, purposeIdx);
+  return (offset & 1) ? unitOpen(out[2], out[3]) : unitOpen(out[0], out[1]);
+}
+
+
+void PRNG::skip(uint64_t nSamp,
+		Purpose purpose) {
+  stream.block[static_cast<uint32_t>(purpose)] += (nSamp + 1) / 2;
+}
+
+
+void PRNG::seed(uint64_t seed) {
+  sessionSeed = seed;
+  setStream(0);
+}
+
+
+void PRNG::setStream(unsigned int major,
+		     unsigned int minor) {
+  stream = Stream();
+  stream.major = major;
+  stream.minor = minor;
+}
+
+
+template<>
+vector<size_t> PRNG::rUnif(size_t nSamp,
+			   size_t scale,
+			   Purpose purpose) {
+  vector<double> unif(nSamp);
+  fill(unif, purpose);
+
+  vector<size_t> variates(nSamp);
+  size_t idx = 0;
+  for (double variate : unif) {
+    variates[idx++] = variate * scale;
+  }
+
+  return variates;
+}
+
+
+template<>
+vector<unsigned int> PRNG::rUnif(unsigned int nSamp,
+				 unsigned int scale,
+				 Purpose purpose) {
+  vector<double> unif(nSamp);
+  fill(unif, purpose);
+
+  vector<unsigned int> variates(nSamp);
+  unsigned int idx = 0;
+  for (double variate : unif) {
+    variates[idx++] = variate * scale;
+  }
+
+  return variates;
+}
+
+
+template<>
+vector<double> PRNG::rUnif(double nSamp,
+			   double scale,
+			   Purpose purpose) {
+  vector<double> variates(static_cast<size_t>(nSamp));
+  fill(variates, purpose);
+  if (scale != 1.0) {
+    for (double& variate : variates) {
+      variate *= scale;
+    }
+  }
+
+  return variates;
+}
@@ -9,7 +9,7 @@
 /**
    @file prng.h
 
-   @brief Interface to front end's pseudo-random variate generation.
+   @brief Counter-based pseudo-random variate generation.
 
    @author Mark Seligman
  */
@@ -17,23 +17,114 @@
 #ifndef CORE_PRNG_H
 #define CORE_PRNG_H
 
+#include <cstdint>
 #include <vector>
 using namespace std;
 
 
+/**
+   @brief Philox4x32-10 generator, keyed by a session seed.
+
+   Each variate is a pure function of the seed, the calling thread's
+   stream coordinates and the purpose of the draw.  Draws are therefore
+   reproducible independent of thread count or scheduling, so long as
+   each unit of work selects its own stream before drawing.
+ */
 namespace PRNG {
   /**
-    @brief Call-back to front-end session's uniform PRNG.
+     @brief Distinguishes draws made within a common stream.
+
+     Each purpose advances its own counter, so that draws for one
+     purpose are unaffected by the number made for another.
+   */
+  enum class Purpose : uint32_t {
+    sample,
+    jitter,
+    candidate,
+    mono,
+    permute,
+    subspace,
+    cut,
+    nPurpose
+  };
+
+
+  /**
+    @brief Call-back to front-end session's generator.
+
+    @return seed drawn from the front end's session state.
+  */
+  uint64_t frontSeed();
+
+
+  /**
+     @brief Sets the session seed and resets the calling thread's stream.
+   */
+  void seed(uint64_t seed);
+
+
+  /**
+     @brief Selects the stream of the calling thread.
+
+     Resets the counters of all purposes.
+
+     @param major is typically a tree index.
+
+     @param minor is typically a level within the tree.
+   */
+  void setStream(unsigned int major,
+		 unsigned int minor = 0);
+
+
+  /**
+    @brief Draws uniform variates from the calling thread's stream.
 
     @param nSamp is number of variates to generate.
 
     @param scale is a coefficient by which the variates are scaled.
 
-    @return std::vector copy of front end-generated random variates.
+    @param purpose selects the counter within the stream.
+
+    @return std::vector of scaled variates, drawn over (0, 1).
   */
   template<typename indexType>
   vector<indexType> rUnif(indexType nSamp,
-		          indexType scale = indexType(1));
+		          indexType scale = indexType(1),
+			  Purpose purpose = Purpose::sample);
+
+
+  /**
+     @brief Looks ahead within the calling thread's stream, without drawing.
+
+     Variates are those rUnif() would yield, were a single draw to
+     span the offset.  Sparse consumers can thereby read a window of a
+     large draw without materializing it.
+
+     @param offset is the position relative to the next variate.
+
+     @param nSamp is the number of variates to read.
+
+     @return std::vector of variates over (0, 1).
+   */
+  vector<double> rUnifAt(uint64_t offset,
+			 size_t nSamp,
+			 Purpose purpose);
+
+
+  /**
+     @return single variate at an offset, as above.
+   */
+  double unifAt(uint64_t offset,
+		Purpose purpose);
+
+
+  /**
+     @brief Advances a counter as though variates had been drawn.
+
+     @param nSamp is the number of variates passed over.
+   */
+  void skip(uint64_t nSamp,
+	    Purpose purpose);
 }
 
 #endif
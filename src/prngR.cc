@@ -18,7 +18,7 @@
 /**
    @file prng.cc
 
-   @brief R-language instantiation of base PRNG methods.
+   @brief R-language seeding of the core PRNG.
 
    @author Mark Seligman
  */
@@ -29,45 +29,12 @@
 using namespace Rcpp;
 
 
-template<>
-vector<size_t> PRNG::rUnif(size_t nSamp,
-			   size_t scale) {
+uint64_t PRNG::frontSeed() {
   RNGScope scope;
 
-  // R requires type double for vector lengths >= 2^32.
-  NumericVector rn(runif(double(nSamp)));
-
-  vector<size_t> variates(nSamp);
-  size_t idx = 0;
-  for (const double& variate : rn) {
-    variates[idx++] = variate * scale;
-  }
-
-  return variates;
-}
-
-
-template<>
-vector<unsigned int> PRNG::rUnif(unsigned int nSamp,
-				 unsigned int scale) {
-  RNGScope scope;
-
-  NumericVector rn(runif(nSamp));
-  if (scale != 1)
-    rn = rn * scale;
-
-  return vector<unsigned int>(rn.begin(), rn.end());
-}
-
-
-template<>
-vector<double> PRNG::rUnif(double nSamp,
-			   double scale) {
-  RNGScope scope;
-
-  NumericVector rn(runif(nSamp));
-  if (scale != 1.0)
-    rn = rn * scale;
-
-  return vector<double>(rn.begin(), rn.end());
+  // Two 32-bit halves, as R's variates carry fewer than 64 random bits.
+  NumericVector rn(runif(2));
+  uint64_t hi = static_cast<uint64_t>(rn[0] * 4294967296.0);
+  uint64_t lo = static_cast<uint64_t>(rn[1] * 4294967296.0);
+  return (hi << 32) | lo;
 }
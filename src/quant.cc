@@ -21,7 +21,6 @@
 #include <algorithm>
 
 
-const unsigned int Quant::binSize = 0x1000;
 vector<double> Quant::quantile = vector<double>(0);
 
 
@@ -36,8 +35,8 @@ void Quant::deInit() {
 
 
 /**
-   @brief Constructor.  Caches parameter values and computes compressed
-   leaf indices.
+   @brief Constructor.  Caches parameter values and ensures the leaves'
+   rank tables are built.
  */
 Quant::Quant(const Sampler* sampler,
 	     const Predict* predict,
@@ -46,42 +45,12 @@ Quant::Quant(const Sampler* sampler,
   empty(!reportAuxiliary || quantile.empty() || leaf.empty() || !sampler->hasSamples()),
   qCount(quantile.size()),
   trapAndBail(Predict::trapUnobserved),
-  leafDom((empty || !trapAndBail) ? vector<vector<IndexRange>>(0) : predict->forest->leafDominators()), 
-  valRank(RankedObs<double>(&(reinterpret_cast<const ResponseReg*>(sampler->getResponse())->getYTrain())[0],
-			    empty ? 0 : reinterpret_cast<const ResponseReg*>(sampler->getResponse())->getYTrain().size())),
-  rankCount(empty ? vector<vector<vector<RankCount>>>(0) : leaf.alignRanks(sampler, valRank.rank())),
-  rankScale(empty ? 0 : binScale()),
-  binMean(empty ? vector<double>(0) : binMeans(valRank)),
-  qPred(vector<double>(empty ? 0 : predict->getNObs() * qCount)),
-  qEst(vector<double>(empty ? 0 : predict->getNObs())) {
-}
-
-
-unsigned int Quant::binScale() const {
-  unsigned int shiftVal = 0;
-  while ((binSize << shiftVal) < valRank.getRankCount())
-    shiftVal++;
-
-  return shiftVal;
-}
-
-
-vector<double> Quant::binMeans(const RankedObs<double>& valRank) const {
-  vector<double> binMean(std::min(static_cast<IndexT>(binSize), valRank.getRankCount()));
-  vector<size_t> binCount(binMean.size());
-  for (IndexT idx = 0; idx < valRank.getNRow(); idx++) {
-    unsigned int binIdx = binRank(valRank.getRank(idx));
-    binMean[binIdx] += valRank.getVal(idx);
-    binCount[binIdx]++;
-  }
-  unsigned int binIdx = 0;
-  for (auto bc : binCount) {
-    if (bc == 0)
-      break;
-    binMean[binIdx++] /= bc;
-  }
-
-  return binMean;
+  leafDom((empty || !trapAndBail) ? nullptr : &predict->forest->leafDominators()),
+  rankMean(leaf.getRankMean()),
+  qPred(vector<double>(empty ? 0 : predict->getNStore() * qCount)),
+  qEst(vector<double>(empty ? 0 : predict->getNStore())) {
+  if (!empty)
+    leaf.alignRanks(sampler);
 }
 
 
@@ -90,15 +59,17 @@ void Quant::predictRow(const Predict* predict,
 		       size_t obsIdx) {
   if (isEmpty())
     return;
-  vector<IndexT> sCountBin(std::min(static_cast<IndexT>(binSize), valRank.getRankCount()));
-  IndexT totSamples = 0;
+
+  // Capacity retained across rows, as rows are scored concurrently.
+  static thread_local vector<pair<size_t, size_t>> rowLeaf;
+  rowLeaf.clear();
   if (trapAndBail) {
     for (unsigned int tIdx = 0; tIdx < predict->getNTree(); tIdx++) {
       IndexT nodeIdx;
       if (predict->getFinalIdx(obsIdx, tIdx, nodeIdx)) {
-	IndexRange leafRange = leafDom[tIdx][nodeIdx];
+	IndexRange leafRange = (*leafDom)[tIdx][nodeIdx];
 	for (IndexT leafIdx = leafRange.getStart(); leafIdx != leafRange.getEnd(); leafIdx++) {
-	  totSamples += sampleLeaf(tIdx, leafIdx, sCountBin);
+	  rowLeaf.emplace_back(leaf.getRankStart(tIdx, leafIdx), leaf.getRankStart(tIdx, leafIdx + 1));
 	}
       }
     }
@@ -107,59 +78,222 @@ void Quant::predictRow(const Predict* predict,
     for (unsigned int tIdx = 0; tIdx < predict->getNTree(); tIdx++) {
       IndexT leafIdx;
       if (predict->isLeafIdx(obsIdx, tIdx, leafIdx)) {
-	totSamples += sampleLeaf(tIdx, leafIdx, sCountBin);
+	rowLeaf.emplace_back(leaf.getRankStart(tIdx, leafIdx), leaf.getRankStart(tIdx, leafIdx + 1));
       }
     }
   }
-  // Builds sample-count thresholds for each quantile.
-  vector<double> countThreshold(qCount);
-  unsigned int qSlot = 0;
-  for (auto & thresh : countThreshold) {
-    thresh = totSamples * quantile[qSlot++];  // Rounding properties?
+
+  // Approximate costs:  sorting the pooled ranks grows as n log n for
+  // n pairs, counting as n plus the rank count and bisection as a
+  // search of every leaf per probe of the ranks.
+  size_t nPair = 0;
+  IndexT totSamples = 0;
+  for (auto span : rowLeaf) {
+    nPair += span.second - span.first;
+    totSamples += leaf.getSCountCum()[span.second - 1];
   }
+  size_t nLeaf = max(rowLeaf.size(), size_t(1));
+  size_t costMerge = nPair * Util::packedWidth(nPair);
+  size_t costCount = nPair + rankMean.size();
+  size_t costBisect = (qCount + 1) * Util::packedWidth(rankMean.size()) * nLeaf * Util::packedWidth(nPair / nLeaf);
+  if (costBisect < min(costMerge, costCount))
+    quantBisect(prediction, rowLeaf, totSamples, obsIdx);
+  else if (costCount < costMerge)
+    quantCount(prediction, rowLeaf, totSamples, obsIdx);
+  else
+    quantMerge(prediction, rowLeaf, totSamples, obsIdx);
+}
 
-  // Fills in quantile estimates.
-  quantSamples(prediction, sCountBin, countThreshold, totSamples, obsIdx);
+
+IndexT Quant::countThrough(const vector<pair<size_t, size_t>>& rowLeaf,
+			   const vector<pair<size_t, size_t>>& window,
+			   IndexT rank,
+			   vector<size_t>& through) const {
+  const vector<IndexT>& rankLeaf = leaf.getRankLeaf();
+  const vector<IndexT>& sCountCum = leaf.getSCountCum();
+  IndexT sCount = 0;
+  for (size_t leafIdx = 0; leafIdx != rowLeaf.size(); leafIdx++) {
+    through[leafIdx] = upper_bound(rankLeaf.begin() + window[leafIdx].first,
+				   rankLeaf.begin() + window[leafIdx].second, rank) - rankLeaf.begin();
+    if (through[leafIdx] != rowLeaf[leafIdx].first)
+      sCount += sCountCum[through[leafIdx] - 1];
+  }
+  return sCount;
 }
 
 
-IndexT Quant::sampleLeaf(unsigned int tIdx,
-			 IndexT leafIdx,
-			 vector<IndexT>& sCountBin) const {
-  IndexT sampleTot = 0;
-  // sampleTot can be precomputed and cached, but rank traversal is
-  // irregular.
-  for (RankCount rc : rankCount[tIdx][leafIdx]) {
-    sCountBin[binRank(rc.getRank())] += rc.getSCount();
-    sampleTot += rc.getSCount();
+IndexT Quant::rankThreshold(const vector<pair<size_t, size_t>>& rowLeaf,
+			    vector<pair<size_t, size_t>>& window,
+			    vector<size_t>& through,
+			    double threshold,
+			    IndexT& rankLow,
+			    IndexT& countLow,
+			    IndexT rankHigh,
+			    IndexT countHigh) const {
+  bool interpolate = true;
+  while (rankLow < rankHigh) {
+    // Counts grow nearly linearly with rank, so interpolation usually
+    // converges quickly.  Bisection guards against slow progress.
+    IndexT rankProbe;
+    if (interpolate) {
+      double frac = (threshold - countLow) / max(countHigh - countLow, IndexT(1));
+      rankProbe = min(rankHigh - 1, rankLow + static_cast<IndexT>(frac * (rankHigh - rankLow)));
+    }
+    else {
+      rankProbe = rankLow + (rankHigh - rankLow) / 2;
+    }
+    IndexT extent = rankHigh - rankLow;
+    IndexT countProbe = countThrough(rowLeaf, window, rankProbe, through);
+    bool reached = countProbe >= threshold;
+    // Each leaf's search narrows with the rank interval.
+    for (size_t leafIdx = 0; leafIdx != window.size(); leafIdx++) {
+      if (reached)
+	window[leafIdx].second = through[leafIdx];
+      else
+	window[leafIdx].first = through[leafIdx];
+    }
+    if (reached) {
+      rankHigh = rankProbe;
+      countHigh = countProbe;
+    }
+    else {
+      rankLow = rankProbe + 1;
+      countLow = countProbe;
+    }
+    interpolate = 2 * (rankHigh - rankLow) <= extent;
   }
-  return sampleTot; // Single leaf, so fits in IndexT.
+  return rankLow;
 }
 
 
-void Quant::quantSamples(const ForestPredictionReg* prediction,
-			 const vector<IndexT>& sCountBin,
-                         const vector<double>& threshold,
-			 IndexT totSample,
-			 size_t obsIdx) {
-  unsigned int qSlot = 0;
-  unsigned int binIdx = 0;
-  IndexT samplesSeen = 0;
-  IndexT leftSamples = 0; // # samples with y-values <= yPred.
-  double yPred = prediction->getValue(obsIdx);
-  double* qRow = &qPred[qCount * obsIdx];
-  for (auto sc : sCountBin) {
-    samplesSeen += sc;
-    while (qSlot < qCount && samplesSeen >= threshold[qSlot]) {
-      qRow[qSlot++] = binMean[binIdx];
+void Quant::quantBisect(const ForestPredictionReg* prediction,
+			const vector<pair<size_t, size_t>>& rowLeaf,
+			IndexT totSample,
+			size_t obsIdx) {
+  const vector<IndexT>& rankLeaf = leaf.getRankLeaf();
+  IndexT rankMin = rankMean.size() - 1;
+  IndexT rankMax = 0;
+  for (auto span : rowLeaf) {
+    rankMin = min(rankMin, rankLeaf[span.first]);
+    rankMax = max(rankMax, rankLeaf[span.second - 1]);
+  }
+  if (rowLeaf.empty())
+    rankMin = 0;
+  rankMax = max(rankMin, rankMax);
+
+  // Capacity retained across rows, as rows are scored concurrently.
+  static thread_local vector<pair<size_t, size_t>> window;
+  static thread_local vector<size_t> through;
+  window = rowLeaf;
+  through.resize(rowLeaf.size());
+
+  // Quantiles ascend, so each search resumes from its predecessor's
+  // lower bound.  Upper bounds are reset.
+  IndexT rankLow = rankMin;
+  IndexT countLow = 0; // # samples ranked below rankLow.
+  size_t storeIdx = prediction->storeIdx(obsIdx);
+  double* qRow = &qPred[qCount * storeIdx];
+  for (unsigned int qSlot = 0; qSlot != qCount; qSlot++) {
+    for (size_t leafIdx = 0; leafIdx != window.size(); leafIdx++) {
+      window[leafIdx].second = rowLeaf[leafIdx].second;
     }
-    if (yPred > binMean[binIdx]) {
-      leftSamples = samplesSeen;
+    qRow[qSlot] = rankMean[rankThreshold(rowLeaf, window, through, totSample * quantile[qSlot], rankLow, countLow, rankMax, totSample)];
+  }
+
+  // Counts samples with y-values < yPred.
+  IndexT rankBound = lower_bound(rankMean.begin(), rankMean.end(), prediction->getValue(obsIdx)) - rankMean.begin();
+  IndexT leftSamples = rankBound == 0 ? 0 : countThrough(rowLeaf, rowLeaf, rankBound - 1, through);
+  qEst[storeIdx] = static_cast<double>(leftSamples) / totSample;
+}
+
+
+void Quant::quantMerge(const ForestPredictionReg* prediction,
+		       const vector<pair<size_t, size_t>>& rowLeaf,
+		       IndexT totSample,
+		       size_t obsIdx) {
+  static thread_local vector<RankCount> rowRank;
+  rowRank.clear();
+  const vector<IndexT>& rankLeaf = leaf.getRankLeaf();
+  const vector<IndexT>& sCountCum = leaf.getSCountCum();
+  for (auto span : rowLeaf) {
+    IndexT sCountPrev = 0;
+    for (size_t idx = span.first; idx != span.second; idx++) {
+      rowRank.emplace_back();
+      rowRank.back().init(rankLeaf[idx], sCountCum[idx] - sCountPrev);
+      sCountPrev = sCountCum[idx];
+    }
+  }
+  // Leaf tables are individually ordered, so the sort merges runs.
+  sort(rowRank.begin(), rowRank.end(),
+       [](const RankCount& a, const RankCount& b) {
+	 return a.getRank() < b.getRank();
+       });
+
+  QuantScan scan(this, prediction, totSample, obsIdx);
+  for (RankCount rc : rowRank) {
+    if (!scan.visit(rc.getRank(), rc.getSCount()))
+      break;
+  }
+  scan.finish();
+}
+
+
+void Quant::quantCount(const ForestPredictionReg* prediction,
+		       const vector<pair<size_t, size_t>>& rowLeaf,
+		       IndexT totSample,
+		       size_t obsIdx) {
+  static thread_local vector<IndexT> sCountRank;
+  sCountRank.assign(rankMean.size(), 0);
+  const vector<IndexT>& rankLeaf = leaf.getRankLeaf();
+  const vector<IndexT>& sCountCum = leaf.getSCountCum();
+  for (auto span : rowLeaf) {
+    IndexT sCountPrev = 0;
+    for (size_t idx = span.first; idx != span.second; idx++) {
+      sCountRank[rankLeaf[idx]] += sCountCum[idx] - sCountPrev;
+      sCountPrev = sCountCum[idx];
     }
-    else if (qSlot >= qCount)
+  }
+
+  QuantScan scan(this, prediction, totSample, obsIdx);
+  for (IndexT rank = 0; rank != sCountRank.size(); rank++) {
+    if (sCountRank[rank] != 0 && !scan.visit(rank, sCountRank[rank]))
       break;
-    binIdx++;
   }
+  scan.finish();
+}
+
+
+Quant::QuantScan::QuantScan(Quant* quant_,
+			    const ForestPredictionReg* prediction,
+			    IndexT totSample_,
+			    size_t obsIdx) :
+  quant(quant_),
+  totSample(totSample_),
+  yPred(prediction->getValue(obsIdx)),
+  storeIdx(prediction->storeIdx(obsIdx)),
+  qRow(&quant->qPred[quant->qCount * storeIdx]),
+  qSlot(0),
+  samplesSeen(0),
+  leftSamples(0) {
+}
+
+
+bool Quant::QuantScan::visit(IndexT rank,
+			     IndexT sCount) {
+  double yRank = quant->rankMean[rank];
+  samplesSeen += sCount;
+  // Sample-count threshold for a quantile:  rounding properties?
+  while (qSlot < quant->qCount && samplesSeen >= totSample * quantile[qSlot]) {
+    qRow[qSlot++] = yRank;
+  }
+  if (yPred > yRank) {
+    leftSamples = samplesSeen;
+    return true;
+  }
+  return qSlot < quant->qCount;
+}
+
 
-  qEst[obsIdx] = static_cast<double>(leftSamples) / totSample;
+void Quant::QuantScan::finish() {
+  quant->qEst[storeIdx] = static_cast<double>(leftSamples) / totSample;
 }
@@ -19,9 +19,9 @@
 
 #include "typeparam.h"
 #include "prediction.h"
-#include "valrank.h"
 #include "leaf.h"
 
+#include <utility>
 #include <vector>
 
 class Predict;
@@ -32,85 +32,134 @@ struct ForestPredictReg;
  @brief Quantile signature.
 */
 class Quant {
-  static const unsigned int binSize; // # slots to track.
   static vector<double> quantile; ///< quantile values over which to predict.
   const Leaf& leaf;
   const bool empty; // if so, leave vectors empty and bail.
   const unsigned int qCount; ///< caches quantile size for quick reference.
   const bool trapAndBail; ///< Whether nonterminal exit permitted.
-  const vector<vector<IndexRange>> leafDom;
-  const RankedObs<double> valRank;
-  const vector<vector<vector<RankCount>>> rankCount; // forest-wide, by sample.
-  const unsigned int rankScale; // log2 of scaling factor.
-  const vector<double> binMean;
+  const vector<vector<IndexRange>>* leafDom; ///< Cached by forest, iff trapping.
+  const vector<double>& rankMean; ///< Mean training response, by rank:  cached by leaf.
   vector<double> qPred; // predicted quantiles.
   vector<double> qEst; // quantile of response estimates.
   
 
   /**
-     @brief Computes a bin offset for a given rank.
+     @brief Accumulates quantiles over a row's ranks, visited in order.
+   */
+  struct QuantScan {
+    Quant* quant;
+    const IndexT totSample; ///< Sum of sample counts over the row.
+    const double yPred; ///< Predicted response for the row.
+    const size_t storeIdx; ///< Storage index of the row.
+    double* qRow; ///< Quantiles of the row.
+    unsigned int qSlot; ///< Next quantile to fill.
+    IndexT samplesSeen; ///< # samples visited.
+    IndexT leftSamples; ///< # samples with y-values < yPred.
+
+    QuantScan(Quant* quant_,
+	      const ForestPredictionReg* prediction,
+	      IndexT totSample_,
+	      size_t obsIdx);
+
+
+    /**
+       @brief Visits the samples at the next rank.
+
+       @return true iff higher ranks remain relevant.
+     */
+    bool visit(IndexT rank,
+	       IndexT sCount);
+
+
+    /**
+       @brief Writes the quantile estimate.
+     */
+    void finish();
+  };
+
+
+  /**
+     @brief Writes quantiles by pooling and sorting the row's ranks.
 
-     @param rank is the rank in question.
+     Favored when the row's leaves are small.
 
-     @return bin offset.
+     @param rowLeaf are the row's leaves, as offsets into the rank tables.
+
+     @param totSample is the sum of sample counts over the leaves.
    */
-  unsigned int binRank(unsigned int rank) const {
-    return rank >> rankScale;
-  }
+  void quantMerge(const ForestPredictionReg* prediction,
+		  const vector<pair<size_t, size_t>>& rowLeaf,
+		  IndexT totSample,
+		  size_t obsIdx);
 
 
   /**
-     @brief Determines scaling factor for training response.
+     @brief As above, but counting samples by rank.
 
-     @return power-of-two divisor for training response length.
+     Favored when leaves are pooled in great number, as by trapping.
    */
-  unsigned int binScale() const;
+  void quantCount(const ForestPredictionReg* prediction,
+		  const vector<pair<size_t, size_t>>& rowLeaf,
+		  IndexT totSample,
+		  size_t obsIdx);
 
 
   /**
-n     @brief Bins response means.
+     @brief Writes quantiles by bisecting the rank range.
 
-     @param valRank contains the ranked response/row pairs.
+     Favored when the row's leaves are large, as each probe searches
+     the cumulative counts of every leaf.
 
-     @param rankScale is the bin scaling factor.
+     @param rowLeaf are the row's leaves, as offsets into the rank tables.
 
-     @return binned vector of response means.
+     @param totSample is the sum of sample counts over the leaves.
    */
-  vector<double> binMeans(const RankedObs<double>& valRank) const;
+  void quantBisect(const ForestPredictionReg* prediction,
+		   const vector<pair<size_t, size_t>>& rowLeaf,
+		   IndexT totSample,
+		   size_t obsIdx);
+
 
-  
   /**
-     @brief Writes quantile values for a row of predictions.
+     @brief Finds the least rank whose sample count reaches a threshold.
 
-     @param sCount is a bin of ranked sample counts.
+     @param[in, out] window restricts the search within each leaf.
 
-     @param threshold is the sample count threshold for a given quantile.
+     @param through is a workspace for countThrough().
 
-     @param yPred is the predicted response for the current row.
+     @param[in, out] rankLow is the least rank searched, output as the
+     rank found.
 
-     @param[out] qRow[] outputs the derived quantiles.
-   */
-  void quantSamples(const ForestPredictionReg* prediction,
-		    const vector<IndexT>& sCount,
-		    const vector<double>& threshold,
-		    IndexT totSample,
-		    size_t obsIdx);
-  
+     @param[in, out] countLow is the # samples ranked below rankLow.
 
-  /**
-     @brief Accumulates the ranks assocated with predicted leaf.
+     @param rankHigh is the greatest rank searched.
+
+     @param countHigh is the # samples ranked through rankHigh.
 
-     @param tIdx is a tree index.
+     @return rank found.
+   */
+  IndexT rankThreshold(const vector<pair<size_t, size_t>>& rowLeaf,
+		       vector<pair<size_t, size_t>>& window,
+		       vector<size_t>& through,
+		       double threshold,
+		       IndexT& rankLow,
+		       IndexT& countLow,
+		       IndexT rankHigh,
+		       IndexT countHigh) const;
 
-     @param leafIdx is a tree-relative leaf index.
 
-     @param[in,out] sCount counts the number of samples at a (binned) rank.
+  /**
+     @brief Counts samples ranked at or below a given rank, over the row's leaves.
 
-     @return count of samples subsumed by leaf.
-  */
-  IndexT sampleLeaf(unsigned int tIdx,
-		    IndexT leafIdx,
-		    vector<IndexT>& scountBin) const;
+     @param window restricts the search within each leaf.
+
+     @param[out] through outputs the offset following each leaf's last
+     pair ranked at or below rank.
+   */
+  IndexT countThrough(const vector<pair<size_t, size_t>>& rowLeaf,
+		      const vector<pair<size_t, size_t>>& window,
+		      IndexT rank,
+		      vector<size_t>& through) const;
 
 
 public:
@@ -0,0 +1,153 @@
+// This file is part of ArboristCore.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file quickscorer.cc
+
+   @brief Methods building and applying bitvector forest scoring.
+
+   @author Mark Seligman
+ */
+
+#include "quickscorer.h"
+#include "forest.h"
+#include "util.h"
+
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+// Inclusion only:
+#include "quant.h"
+
+
+/**
+   @brief Nonterminal summary, prior to sorting.
+ */
+struct QSNode {
+  PredictorT predIdx;
+  double splitVal;
+  unsigned int tIdx;
+  PackedT mask;
+  bool missingFalse;
+};
+
+
+bool QuickScorer::eligible(const Forest* forest,
+			   PredictorT nPredNum) {
+  for (unsigned int tIdx = 0; tIdx < forest->getNTree(); tIdx++) {
+    unsigned int nLeaf = 0;
+    for (IndexT nodeIdx = 0; nodeIdx < forest->getNodeCount(tIdx); nodeIdx++) {
+      if (forest->getDelIdx(tIdx, nodeIdx) == 0) {
+	if (++nLeaf > leafMax)
+	  return false;
+      }
+      else if (forest->getPredIdx(tIdx, nodeIdx) >= nPredNum) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+
+unique_ptr<QuickScorer> QuickScorer::make(const Forest* forest,
+					  PredictorT nPredNum) {
+  return nPredNum > 0 && eligible(forest, nPredNum) ? make_unique<QuickScorer>(forest, nPredNum) : nullptr;
+}
+
+
+QuickScorer::QuickScorer(const Forest* forest,
+			 PredictorT nPredNum) :
+  nTree(forest->getNTree()),
+  predHeight(vector<size_t>(nPredNum)),
+  leafNode(vector<vector<IndexT>>(nTree)) {
+  vector<QSNode> nodeMask;
+  for (unsigned int tIdx = 0; tIdx < nTree; tIdx++) {
+    encodeTree(forest->getDecTree(tIdx), tIdx, nodeMask);
+  }
+
+  sort(nodeMask.begin(), nodeMask.end(),
+       [](const QSNode& a, const QSNode& b) {
+	 return a.predIdx < b.predIdx || (a.predIdx == b.predIdx && a.splitVal < b.splitVal);
+       });
+
+  for (const QSNode& qsNode : nodeMask) {
+    predHeight[qsNode.predIdx]++;
+    splitVal.push_back(qsNode.splitVal);
+    treeIdx.push_back(qsNode.tIdx);
+    mask.push_back(qsNode.mask);
+    missingFalse.push_back(qsNode.missingFalse ? 1 : 0);
+  }
+  partial_sum(predHeight.begin(), predHeight.end(), predHeight.begin());
+}
+
+
+void QuickScorer::encodeTree(const DecTree& tree,
+			     unsigned int tIdx,
+			     vector<QSNode>& nodeMask) {
+  const vector<DecNode>& decNode = tree.getNode();
+
+  // Depth-first, true branch first, so that leaves are numbered
+  // left to right.  Nonterminals are revisited once their true
+  // subtree has been numbered, at which point the extent of the
+  // subtree is known.
+  vector<pair<IndexT, bool>> stack;
+  vector<unsigned int> leafStart(decNode.size());
+  stack.emplace_back(0, false);
+  while (!stack.empty()) {
+    IndexT nodeIdx = stack.back().first;
+    bool revisit = stack.back().second;
+    stack.pop_back();
+    const DecNode& node = decNode[nodeIdx];
+    if (node.isTerminal()) {
+      leafNode[tIdx].push_back(nodeIdx);
+    }
+    else if (!revisit) {
+      leafStart[nodeIdx] = leafNode[tIdx].size();
+      stack.emplace_back(node.getIdFalse(nodeIdx), false);
+      stack.emplace_back(nodeIdx, true);
+      stack.emplace_back(node.getIdTrue(nodeIdx), false);
+    }
+    else {
+      unsigned int leafEnd = leafNode[tIdx].size();
+      PackedT trueLeaves = 0ull;
+      for (unsigned int leafPos = leafStart[nodeIdx]; leafPos != leafEnd; leafPos++) {
+	trueLeaves |= (1ull << leafPos);
+      }
+      nodeMask.push_back(QSNode{node.getPredIdx(), node.getSplitNum(), tIdx, ~trueLeaves, !node.getInvert()});
+    }
+  }
+}
+
+
+void QuickScorer::walkObs(const double obsNum[],
+			  vector<PackedT>& leafBits,
+			  IndexT finalIdx[]) const {
+  fill(leafBits.begin(), leafBits.end(), ~0ull);
+  size_t nodeStart = 0;
+  for (PredictorT predIdx = 0; predIdx != predHeight.size(); predIdx++) {
+    size_t nodeEnd = predHeight[predIdx];
+    double val = obsNum[predIdx];
+    if (isnan(val)) {
+      for (size_t nodeIdx = nodeStart; nodeIdx != nodeEnd; nodeIdx++) {
+	if (missingFalse[nodeIdx] != 0)
+	  leafBits[treeIdx[nodeIdx]] &= mask[nodeIdx];
+      }
+    }
+    else {
+      for (size_t nodeIdx = nodeStart; nodeIdx != nodeEnd && splitVal[nodeIdx] < val; nodeIdx++) {
+	leafBits[treeIdx[nodeIdx]] &= mask[nodeIdx];
+      }
+    }
+    nodeStart = nodeEnd;
+  }
+
+  for (unsigned int tIdx = 0; tIdx != nTree; tIdx++) {
+    finalIdx[tIdx] = leafNode[tIdx][Util::lowBit(leafBits[tIdx])];
+  }
+}
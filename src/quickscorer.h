@@ -0,0 +1,109 @@
+// This file is part of ArboristCore.
+
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+/**
+   @file quickscorer.h
+
+   @brief Bitvector evaluation of numeric-only forests.
+
+   @author Mark Seligman
+ */
+
+#ifndef FOREST_QUICKSCORER_H
+#define FOREST_QUICKSCORER_H
+
+#include "typeparam.h"
+
+#include <vector>
+#include <memory>
+
+using namespace std;
+
+class Forest;
+
+
+/**
+   @brief Scores observations without walking the trees.
+
+   Leaves of each tree are numbered left to right, with the left
+   branch taken on passing (<=) the split value.  A nonterminal failing
+   its test eliminates the leaves of its left subtree.  The nonterminals
+   of the forest are sorted, per predictor, by split value, so that the
+   failing tests for an observation form a prefix of each predictor's
+   list.  The exit leaf of a tree is then the lowest bit surviving the
+   conjunction of the masks so encountered.
+
+   Applicable only when every split is numeric and every tree has at
+   most 'leafMax' leaves.
+ */
+class QuickScorer {
+  static const unsigned int leafMax = 64; ///< Leaves representable by a mask.
+
+  const unsigned int nTree;
+  vector<size_t> predHeight; ///< Accumulated node count, per predictor.
+  vector<double> splitVal; ///< Split values, sorted within predictor.
+  vector<unsigned int> treeIdx; ///< Tree of node, by sorted position.
+  vector<PackedT> mask; ///< Leaf-elimination mask, " ".
+  vector<unsigned char> missingFalse; ///< Whether NaN fails test, " ".
+  vector<vector<IndexT>> leafNode; ///< Node index of leaf, per tree.
+
+  /**
+     @brief Enumerates the leaves of a tree and records node masks.
+
+     @param[out] nodeMask collects (predictor, split, mask, NaN) tuples.
+   */
+  void encodeTree(const class DecTree& tree,
+		  unsigned int tIdx,
+		  vector<struct QSNode>& nodeMask);
+
+
+public:
+
+  QuickScorer(const Forest* forest,
+	      PredictorT nPredNum);
+
+
+  /**
+     @brief Determines whether forest may be scored by bitvector.
+
+     @param nPredNum is the number of numeric predictors in the frame.
+
+     @return true iff all splits are numeric and all trees are small.
+   */
+  static bool eligible(const Forest* forest,
+		       PredictorT nPredNum);
+
+
+  /**
+     @brief Builds a scorer, if eligible.
+
+     @return scorer if forest eligible, else null.
+   */
+  static unique_ptr<QuickScorer> make(const Forest* forest,
+				      PredictorT nPredNum);
+
+
+  /**
+     @brief Derives the final node index of every tree for an observation.
+
+     @param obsNum is the observation's numeric predictor values.
+
+     @param[in, out] leafBits is a workspace of nTree slots.
+
+     @param[out] finalIdx outputs the node reached, per tree.
+   */
+  void walkObs(const double obsNum[],
+	       vector<PackedT>& leafBits,
+	       IndexT finalIdx[]) const;
+
+
+  unsigned int getNTree() const {
+    return nTree;
+  }
+};
+
+#endif
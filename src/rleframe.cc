@@ -99,29 +99,23 @@ void RLEFrame::reorderRow() {
 }
 
 
-vector<RLEVal<szType>> RLEFrame::permute(unsigned int predIdx,
-					 const vector<size_t>& idxPerm) const {
-  vector<size_t> row2Rank(nObs);
+vector<double> RLEFrame::decodeNum(unsigned int predIdx) const {
+  vector<double> col(nObs);
+  const vector<double>& ranked = numRanked[blockIdx[predIdx]];
   for (auto rle : rlePred[predIdx]) {
-    for (size_t row = rle.row; row != rle.row + rle.extent; row++) {
-      row2Rank[row] = rle.val;
-    }
+    fill(&col[rle.row], &col[rle.row] + rle.extent, ranked[rle.val]);
   }
 
-  vector<RLEVal<szType>> rleOut;
-  size_t rankPrev = nObs; // Inattainable.  Forces new RLE on first iteration.
-  size_t row = 0;
-  for (auto idx : idxPerm) {
-    auto rankThis = row2Rank[idx];
-    if (rankThis == rankPrev) {
-      rleOut.back().extent++;
-    }
-    else {
-      rleOut.emplace_back(rankThis, row, 1);
-      rankPrev = rankThis;
-    }
-    row++;
+  return col;
+}
+
+
+vector<unsigned int> RLEFrame::decodeFac(unsigned int predIdx) const {
+  vector<unsigned int> col(nObs);
+  const vector<unsigned int>& ranked = facRanked[blockIdx[predIdx]];
+  for (auto rle : rlePred[predIdx]) {
+    fill(&col[rle.row], &col[rle.row] + rle.extent, ranked[rle.val] - 1);
   }
 
-  return rleOut;
+  return col;
 }
@@ -141,8 +141,18 @@ struct RLEFrame {
   size_t findRankMissing(unsigned int predIdx) const;
 
 
-  vector<RLEVal<szType>> permute(unsigned int predIdx,
-				 const vector<size_t>& idxPerm) const;
+  /**
+     @brief Decodes a numeric predictor in row order.
+
+     Assumes runs have been reordered by row.
+   */
+  vector<double> decodeNum(unsigned int predIdx) const;
+
+
+  /**
+     @brief As above, but decodes zero-based factor codes.
+   */
+  vector<unsigned int> decodeFac(unsigned int predIdx) const;
 
 
   /**
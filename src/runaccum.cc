@@ -19,8 +19,10 @@
 #include "splitnux.h"
 #include "runfrontier.h"
 #include "obs.h"
+#include "util.h"
 
 #include <numeric>
+#include <cmath>
 
 RunAccum::RunAccum(const SplitFrontier* sf,
 		   const SplitNux& cand) :
@@ -37,8 +39,7 @@ RunAccumReg::RunAccumReg(const SFReg* sfReg,
 RunAccumCtg::RunAccumCtg(const SFCtg* sfCtg,
 			 const SplitNux& cand) : RunAccum(sfCtg, cand),
 						 nCtg(sfCtg->getNCtg()),
-						 sampling(nCtg > 2 && cand.getRunCount() > maxWidth),
-						 sampleCount(sampling ? maxWidth : cand.getRunCount()),
+						 wide(nCtg > 2 && cand.getRunCount() > maxWidth),
 						 ctgNux(filterMissingCtg(sfCtg, cand)),
 						 runSum(vector<double>(nCtg * cand.getRunCount())) {
 }
@@ -53,7 +54,7 @@ bool RunAccum::ctgWide(const SplitFrontier* sf,
 /**
    Regression runs always maintained by heap.
 */
-vector<RunNux> RunAccum::regRuns(const SplitNux& cand) {
+ArenaVec<RunNux> RunAccum::regRuns(const SplitNux& cand) {
   if (implicitCand) {
     return regRunsImplicit(cand);
   }
@@ -63,8 +64,8 @@ vector<RunNux> RunAccum::regRuns(const SplitNux& cand) {
 }
 
 
-vector<RunNux> RunAccum::regRunsExplicit(const SplitNux& cand) {
-  vector<RunNux> runNux(cand.getRunCount());
+ArenaVec<RunNux> RunAccum::regRunsExplicit(const SplitNux& cand) {
+  ArenaVec<RunNux> runNux(cand.getRunCount());
   PredictorT runIdx = 0;
   initReg(obsStart, runNux[runIdx]);
   for (IndexT idx = obsStart + 1; idx != obsEnd; idx++) {
@@ -81,8 +82,8 @@ vector<RunNux> RunAccum::regRunsExplicit(const SplitNux& cand) {
 }
 
 
-vector<RunNux> RunAccum::regRunsImplicit(const SplitNux& cand) {
-  vector<RunNux> runNux(cand.getRunCount());
+ArenaVec<RunNux> RunAccum::regRunsImplicit(const SplitNux& cand) {
+  ArenaVec<RunNux> runNux(cand.getRunCount());
   SumCount scExplicit(sumCount);
   PredictorT runIdx = 0;
   PredictorT implicitSlot = runNux.size(); // Inattainable.
@@ -107,12 +108,12 @@ vector<RunNux> RunAccum::regRunsImplicit(const SplitNux& cand) {
 }
 
 
-vector<RunNux> RunAccum::regRunsMasked(const SplitNux& cand,
+ArenaVec<RunNux> RunAccum::regRunsMasked(const SplitNux& cand,
 				       const BranchSense* branchSense,
 				       bool maskSense) {
   IndexRange unmaskedRange = findUnmaskedRange(branchSense, maskSense);
   IndexT edgeLeft = unmaskedRange.getStart();
-  vector<RunNux> runNux(cand.getRunCount());
+  ArenaVec<RunNux> runNux(cand.getRunCount());
   SumCount scExplicit(sumCount);
   PredictorT runIdx = 0;
   initReg(edgeLeft, runNux[runIdx]);
@@ -146,21 +147,22 @@ void RunAccum::initReg(IndexT runLeft,
 }
 
 
-vector<RunNux> RunAccum::orderMean(const vector<RunNux>& runNux) {
-  heapMean(runNux);
+ArenaVec<RunNux> RunAccum::orderMean(const ArenaVec<RunNux>& runNux) {
+  heapMean(&heapZero[0], runNux);
   return slotReorder(runNux);
 }
 
 
-void RunAccum::heapMean(const vector<RunNux>& runNux) {
+void RunAccum::heapMean(BHPair<PredictorT> heap[],
+			const ArenaVec<RunNux>& runNux) {
   for (PredictorT slot = 0; slot < runNux.size(); slot++) {
-    PQueue::insert<PredictorT>(&heapZero[0], runNux[slot].sumCount.mean(), slot);
+    PQueue::insert<PredictorT>(heap, runNux[slot].sumCount.mean(), slot);
   }
 }
 
 
-vector<RunNux> RunAccumCtg::ctgRuns(RunSet* runSet, const SplitNux& cand) {
-  vector<RunNux> runNux;
+ArenaVec<RunNux> RunAccumCtg::ctgRuns(const SplitNux& cand) {
+  ArenaVec<RunNux> runNux;
   if (implicitCand)
     runNux = runsImplicit(cand);
   else
@@ -168,81 +170,134 @@ vector<RunNux> RunAccumCtg::ctgRuns(RunSet* runSet, const SplitNux& cand) {
 
   if (nCtg == 2)
     runNux = orderBinary(runNux);
-  else if (sampling) {
-    runNux = sampleRuns(runSet, cand, runNux);
+  else if (wide) {
+    runNux = orderProjection(runNux);
   }
 
   return runNux;
 }
 
 
-vector<RunNux> RunAccumCtg::orderBinary(const vector<RunNux>& runNux) {
-  heapBinary(runNux);
-  return slotReorder(runNux);
+ArenaVec<RunNux> RunAccumCtg::orderBinary(const ArenaVec<RunNux>& runNux) {
+  heapBinary(&heapZero[0], runNux, runSum);
+  return reorderCtg(runNux);
 }
 
 
-void RunAccumCtg::heapBinary(const vector<RunNux>& runNux) {
+ArenaVec<RunNux> RunAccumCtg::orderProjection(const ArenaVec<RunNux>& runNux) {
+  heapProjection(&heapZero[0], runNux, runSum, ctgNux.ctgSum, sumCount.sum);
+  return reorderCtg(runNux);
+}
+
+
+ArenaVec<RunNux> RunAccumCtg::reorderCtg(const ArenaVec<RunNux>& runNux) {
+  ArenaVec<RunNux> frOrdered(runNux.size());
+  vector<double> sumOrdered(runSum.size());
+  vector<PredictorT> idxRank = PQueue::depopulate<PredictorT>(&heapZero[0], frOrdered.size());
+
+  for (PredictorT slot = 0; slot < frOrdered.size(); slot++) {
+    PredictorT outSlot = idxRank[slot];
+    frOrdered[outSlot] = runNux[slot];
+    for (PredictorT ctg = 0; ctg < nCtg; ctg++) {
+      sumOrdered[outSlot * nCtg + ctg] = getRunSum(slot, ctg);
+    }
+  }
+  runSum = std::move(sumOrdered);
+
+  return frOrdered;
+}
+
+
+void RunAccumCtg::heapBinary(BHPair<PredictorT> heap[],
+			     const ArenaVec<RunNux>& runNux,
+			     const vector<double>& runSum) {
   // Ordering by category probability is equivalent to ordering by
   // concentration, as weighting by priors does not affect order.
   //
   // In the absence of class weighting, numerator can be (integer) slot
   // sample count, instead of slot sum.
   for (PredictorT slot = 0; slot < runNux.size(); slot++) {
-    PQueue::insert<PredictorT>(&heapZero[0], getRunSum(slot, 1) / runNux[slot].sumCount.sum, slot);
+    PQueue::insert<PredictorT>(heap, runSum[2 * slot + 1] / runNux[slot].sumCount.sum, slot);
   }
 }
 
 
-vector<RunNux> RunAccumCtg::sampleRuns(const RunSet* runSet,
-				       const SplitNux& cand,
-				       const vector<RunNux>& runNux) {
-  const double* rvAccum = runSet->rvSlice(cand.getSigIdx());
-  vector<PredictorT> idxSample(runNux.size());
-  iota(idxSample.begin(), idxSample.end(), 0);
+void RunAccumCtg::heapProjection(BHPair<PredictorT> heap[],
+				 const ArenaVec<RunNux>& runNux,
+				 const vector<double>& runSum,
+				 const vector<double>& ctgSum,
+				 double sum) {
+  PredictorT nCtg = ctgSum.size();
+  vector<double> runWeight(runNux.size());
+  for (PredictorT slot = 0; slot < runNux.size(); slot++) {
+    runWeight[slot] = runNux[slot].sumCount.sum;
+  }
+  vector<double> axis = principalAxis(runSum, runWeight, ctgSum, sum);
+  for (PredictorT slot = 0; slot < runNux.size(); slot++) {
+    double projection = 0.0;
+    for (PredictorT ctg = 0; ctg < nCtg; ctg++) {
+      projection += runSum[slot * nCtg + ctg] * axis[ctg];
+    }
+    PQueue::insert<PredictorT>(heap, runWeight[slot] > 0.0 ? projection / runWeight[slot] : 0.0, slot);
+  }
+}
+
 
-  BV runRandom(runNux.size());
-  PredictorT choiceSize = runNux.size();
-  for (unsigned int idx = 0; idx < sampleCount; idx++) {
-    PredictorT rvIdx = rvAccum[idx] * choiceSize;
-    runRandom.setBit(idxSample[rvIdx]);
-    idxSample[rvIdx] = idxSample[--choiceSize];
+vector<double> RunAccumCtg::principalAxis(const vector<double>& runSum,
+					  const vector<double>& runWeight,
+					  const vector<double>& ctgSum,
+					  double sum) {
+  PredictorT nCtg = ctgSum.size();
+  vector<double> cov(nCtg * nCtg);
+  vector<double> dev(nCtg);
+  for (PredictorT slot = 0; slot < runWeight.size(); slot++) {
+    if (runWeight[slot] <= 0.0) // Zero-weighted categories only.
+      continue;
+    for (PredictorT ctg = 0; ctg < nCtg; ctg++) {
+      dev[ctg] = runSum[slot * nCtg + ctg] / runWeight[slot] - ctgSum[ctg] / sum;
+    }
+    for (PredictorT row = 0; row < nCtg; row++) {
+      for (PredictorT col = 0; col < nCtg; col++) {
+	cov[row * nCtg + col] += runWeight[slot] * dev[row] * dev[col];
+      }
+    }
   }
 
-  vector<double> tempCtgSum(nCtg);
-  vector<double> tempSum(sampleCount * nCtg);
-  vector<RunNux> nuxSampled(runNux.size());
-  PredictorT idxSampled = 0;
-  PredictorT idxUnsampled = sampleCount;
-  for (PredictorT idx = 0; idx < runNux.size(); idx++) {
-    PredictorT outIdx;
-    if (runRandom.testBit(idx)) {
-      for (PredictorT ctg = 0; ctg < nCtg; ctg++) {
-	double sumCtg = getRunSum(idx, ctg);
-	tempCtgSum[ctg] += sumCtg;
-	tempSum[idxSampled * nCtg + ctg] = sumCtg;
+  // Power iteration, seeded by the category of greatest variance.
+  vector<double> axis(nCtg);
+  PredictorT ctgMax = 0;
+  for (PredictorT ctg = 1; ctg < nCtg; ctg++) {
+    if (cov[ctg * nCtg + ctg] > cov[ctgMax * nCtg + ctgMax])
+      ctgMax = ctg;
+  }
+  axis[ctgMax] = 1.0;
+
+  constexpr unsigned int nIter = 32;
+  vector<double> axisNext(nCtg);
+  for (unsigned int iter = 0; iter < nIter; iter++) {
+    double norm2 = 0.0;
+    for (PredictorT row = 0; row < nCtg; row++) {
+      double prod = 0.0;
+      for (PredictorT col = 0; col < nCtg; col++) {
+	prod += cov[row * nCtg + col] * axis[col];
       }
-      outIdx = idxSampled++;
+      axisNext[row] = prod;
+      norm2 += prod * prod;
     }
-    else {
-      outIdx = idxUnsampled++;
+    if (norm2 == 0.0) // Runs indistinguishable:  retains seed.
+      break;
+    double norm = sqrt(norm2);
+    for (PredictorT ctg = 0; ctg < nCtg; ctg++) {
+      axis[ctg] = axisNext[ctg] / norm;
     }
-    nuxSampled[outIdx] = runNux[idx];
   }
 
-  double tempSS = 0;
-  for (PredictorT ctg = 0; ctg < nCtg; ctg++)
-    tempSS += tempCtgSum[ctg] * tempCtgSum[ctg];
-
-  ctgNux = CtgNux(tempCtgSum, tempSS);
-  runSum = tempSum;
-
-  return nuxSampled;
+  return axis;
 }
 
 
-vector<RunNux> RunAccum::slotReorder(const vector<RunNux>& runNux) {
-  vector<RunNux> frOrdered(runNux.size());
+ArenaVec<RunNux> RunAccum::slotReorder(const ArenaVec<RunNux>& runNux) {
+  ArenaVec<RunNux> frOrdered(runNux.size());
   vector<PredictorT> idxRank = PQueue::depopulate<PredictorT>(&heapZero[0], frOrdered.size());
 
   for (PredictorT slot = 0; slot < frOrdered.size(); slot++) {
@@ -253,8 +308,8 @@ vector<RunNux> RunAccum::slotReorder(const vector<RunNux>& runNux) {
 }
 
 
-vector<RunNux> RunAccumCtg::runsExplicit(const SplitNux& cand) {
-  vector<RunNux> runNux(cand.getRunCount());
+ArenaVec<RunNux> RunAccumCtg::runsExplicit(const SplitNux& cand) {
+  ArenaVec<RunNux> runNux(cand.getRunCount());
   PredictorT runIdx = 0;
   double* sumBase = initCtg(obsStart, runNux[runIdx], runIdx);
   for (IndexT obsIdx = obsStart + 1; obsIdx != obsEnd; obsIdx++) {
@@ -269,8 +324,8 @@ vector<RunNux> RunAccumCtg::runsExplicit(const SplitNux& cand) {
 }
 
 
-vector<RunNux> RunAccumCtg::runsImplicit(const SplitNux& cand) {
-  vector<RunNux> runNux(cand.getRunCount());
+ArenaVec<RunNux> RunAccumCtg::runsImplicit(const SplitNux& cand) {
+  ArenaVec<RunNux> runNux(cand.getRunCount());
   // Cut position yields the run index at which to place the residual.
   // Observation at this position must not marked as tied.
   SumCount scExplicit(sumCount);
@@ -301,7 +356,7 @@ vector<RunNux> RunAccumCtg::runsImplicit(const SplitNux& cand) {
 }
 
 
-void RunAccumCtg::residualSums(const vector<RunNux>& runNux,
+void RunAccumCtg::residualSums(const ArenaVec<RunNux>& runNux,
 			   PredictorT implicitSlot) {
   double* ctgBase = &runSum[implicitSlot * nCtg];
   for (PredictorT ctg = 0; ctg < nCtg; ctg++) {
@@ -329,7 +384,7 @@ double* RunAccumCtg::initCtg(IndexT obsLeft,
 
 void RunAccumReg::split(const SFReg* sfReg, RunSet* runSet, SplitNux& cand) {
   RunAccumReg runAccum(sfReg, cand);
-  vector<RunNux> runNux = runAccum.initRuns(runSet, cand);
+  ArenaVec<RunNux> runNux = runAccum.initRuns(cand);
   SplitRun splitRun = runAccum.split(runNux);
   runSet->setSplit(cand, std::move(runNux), splitRun);
 }
@@ -337,127 +392,179 @@ void RunAccumReg::split(const SFReg* sfReg, RunSet* runSet, SplitNux& cand) {
 
 void RunAccumCtg::split(const SFCtg* sfCtg, RunSet* runSet, SplitNux& cand) {
   RunAccumCtg runAccum(sfCtg, cand);
-  vector<RunNux> runNux = runAccum.initRuns(runSet, cand);
+  ArenaVec<RunNux> runNux = runAccum.initRuns(cand);
   SplitRun splitRun = runAccum.split(runNux);
   runSet->setSplit(cand, std::move(runNux), splitRun);
 }
 
 
-vector<RunNux> RunAccum::initRuns(RunSet* runSet,
-				  const SplitNux& cand) {
-  vector<RunNux> runNux = regRuns(cand);
+ArenaVec<RunNux> RunAccum::initRuns(const SplitNux& cand) {
+  ArenaVec<RunNux> runNux = orderMean(regRuns(cand));
   info = (sumCount.sum * sumCount.sum) / sumCount.sCount;
   return runNux;
 }
 
 
-vector<RunNux> RunAccumCtg::initRuns(RunSet* runSet,
-				     const SplitNux& cand) {
-  vector<RunNux> runNux = ctgRuns(runSet, cand);
+ArenaVec<RunNux> RunAccumCtg::initRuns(const SplitNux& cand) {
+  ArenaVec<RunNux> runNux = ctgRuns(cand);
   info = ctgNux.sumSquares / sumCount.sum;
   return runNux;
 }
 
 
-SplitRun RunAccumReg::split(const vector<RunNux>& runNux) {
+SplitRun RunAccumReg::split(const ArenaVec<RunNux>& runNux) {
   return maxVar(runNux);
 }
 
 
-SplitRun RunAccumCtg::split(const vector<RunNux>& runNux) {
+SplitRun RunAccumCtg::split(const ArenaVec<RunNux>& runNux) {
   if (nCtg == 2) {
     return binaryGini(runNux);
   }
+  else if (wide) {
+    return orderedGini(runNux);
+  }
   else
     return ctgGini(runNux);
 }
 
 
-SplitRun RunAccum::maxVar(const vector<RunNux>& runNux) {
+SplitRun RunAccum::maxVar(const ArenaVec<RunNux>& runNux) {
   double infoCell = info;
+  PredictorT runSlot = maxVar(runNux, sumCount, info);
+  return SplitRun(info - infoCell, runSlot, runNux.size());
+}
+
+
+PredictorT RunAccum::maxVar(const ArenaVec<RunNux>& runNux,
+			    const SumCount& scTot,
+			    double& info) {
   SumCount scAccum;
   PredictorT runSlot = runNux.size() - 1;
   for (PredictorT slotTrial = 0; slotTrial < runNux.size() - 1; slotTrial++) {
     runNux[slotTrial].accum(scAccum);
-    if (trialSplit(infoVar(scAccum, sumCount))) {
+    double infoTrial = infoVar(scAccum, scTot);
+    if (infoTrial > info) {
+      info = infoTrial;
       runSlot = slotTrial;
     }
   }
-  return SplitRun(info - infoCell, runSlot, runNux.size());
+  return runSlot;
 }
 
 
-SplitRun RunAccumCtg::ctgGini(const vector<RunNux>& runNux) {
+SplitRun RunAccumCtg::ctgGini(const ArenaVec<RunNux>& runNux) {
   double infoCell = info;
+  PredictorT trueSlots = ctgGini(runNux.size(), runSum, ctgNux.ctgSum, sumCount.sum, info);
+  return SplitRun(info - infoCell, trueSlots, runNux.size());
+}
+
+
+PredictorT RunAccumCtg::ctgGini(PredictorT nRun,
+				const vector<double>& runSum,
+				const vector<double>& ctgSum,
+				double sum,
+				double& info) {
+  PredictorT nCtg = ctgSum.size();
   // Run index subsets as binary-encoded unsigneds.
   PredictorT trueSlots = 0; // Slot offsets of codes taking true branch.
 
   // High bit unset, remainder set.
-  PredictorT lowSet = (1ul << (sampleCount - 1)) - 1;
+  PredictorT lowSet = (1ul << (nRun - 1)) - 1;
 
-  // Arg-max over all nontrivial subsets, up to complement:
-  for (unsigned int subset = 1; subset <= lowSet; subset++) {
-    if (trialSplit(subsetGini(runNux, subset))) {
+  // Arg-max over all nontrivial subsets, up to complement.  The
+  // Gray code of 'grayIdx' differs from that of its predecessor at
+  // the lowest set bit of 'grayIdx'.
+  vector<double> sumSampled(nCtg);
+  PredictorT subset = 0;
+  for (PredictorT grayIdx = 1; grayIdx <= lowSet; grayIdx++) {
+    PredictorT runIdx = Util::lowBit(grayIdx);
+    subset ^= (1ul << runIdx);
+    if (subset & (1ul << runIdx)) {
+      for (PredictorT ctg = 0; ctg < nCtg; ctg++) {
+	sumSampled[ctg] += runSum[runIdx * nCtg + ctg];
+      }
+    }
+    else {
+      for (PredictorT ctg = 0; ctg < nCtg; ctg++) {
+	sumSampled[ctg] -= runSum[runIdx * nCtg + ctg];
+      }
+    }
+    double infoTrial = Accum::subsetGini(sumSampled, ctgSum, sum);
+    if (infoTrial > info) {
+      info = infoTrial;
       trueSlots = subset;
     }
   }
 
-  return SplitRun(info - infoCell, trueSlots, sampleCount);
+  return trueSlots;
 }
 
 
-double RunAccumCtg::subsetGini(const vector<RunNux>& runNux,
-			       unsigned int subset) const {
-  // getRunSum(..., ctg) decomposes 'sumCand' by category x run.
-  // getSum(runIdx) decomposes 'sumCand' by run, so may be used
-  // as a cross-check.
-  vector<double> sumSampled(nCtg);
-  PredictorT nRun = runSum.size() / nCtg;
+double RunAccumCtg::subsetGini(const vector<double>& sumSampled) const {
+  return Accum::subsetGini(sumSampled, ctgNux.ctgSum, sumCount.sum);
+}
 
-  // Looks at all subsets if complement lies outside, else
-  // looks at half of them:
-  PredictorT topIdx = runNux.size() > nRun ? nRun : nRun -1;
 
-  for (PredictorT runIdx = 0; runIdx != topIdx; runIdx++) {
-    if (subset & (1ul << runIdx)) {
-      for (PredictorT ctg = 0; ctg < nCtg; ctg++) {
-	sumSampled[ctg] += getRunSum(runIdx, ctg);
-      }
-    }
-  }
+SplitRun RunAccumCtg::orderedGini(const ArenaVec<RunNux>& runNux) {
+  double infoCell = info;
+  PredictorT argMaxRun = orderedGini(runNux.size(), runSum, ctgNux.ctgSum, sumCount.sum, info);
+  return SplitRun(info - infoCell, argMaxRun, runNux.size());
+}
 
-  double ssL = 0.0;
-  double sumL = 0.0;
-  double ssR = 0.0;
-  PredictorT ctg = 0;
-  for (auto maskedSum : sumSampled) {
-    sumL += maskedSum;
-    ssL += maskedSum * maskedSum;
-    ssR += (ctgNux.ctgSum[ctg] - maskedSum) * (ctgNux.ctgSum[ctg] - maskedSum);
-    ctg++;
+
+PredictorT RunAccumCtg::orderedGini(PredictorT nRun,
+				    const vector<double>& runSum,
+				    const vector<double>& ctgSum,
+				    double sum,
+				    double& info) {
+  PredictorT nCtg = ctgSum.size();
+  vector<double> sumLeft(nCtg);
+  PredictorT argMaxRun = nRun - 1;
+  for (PredictorT runIdx = 0; runIdx != nRun - 1; runIdx++) {
+    for (PredictorT ctg = 0; ctg < nCtg; ctg++) {
+      sumLeft[ctg] += runSum[runIdx * nCtg + ctg];
+    }
+    double infoTrial = Accum::subsetGini(sumLeft, ctgSum, sum);
+    if (infoTrial > info) {
+      info = infoTrial;
+      argMaxRun = runIdx;
+    }
   }
 
-  return infoGini(ssL, ssR, sumL, sumCount.sum - sumL);
+  return argMaxRun;
 }
 
 
-SplitRun RunAccumCtg::binaryGini(const vector<RunNux>& runNux) {
+SplitRun RunAccumCtg::binaryGini(const ArenaVec<RunNux>& runNux) {
   double infoCell = info;
-  const double tot0 = ctgNux.ctgSum[0];
-  const double tot1 = ctgNux.ctgSum[1];
+  PredictorT argMaxRun = binaryGini(runNux, runSum, ctgNux.ctgSum, sumCount.sum, info);
+  return SplitRun(info - infoCell, argMaxRun, runNux.size());
+}
+
+
+PredictorT RunAccumCtg::binaryGini(const ArenaVec<RunNux>& runNux,
+				   const vector<double>& runSum,
+				   const vector<double>& ctgSum,
+				   double sum,
+				   double& info) {
+  const double tot0 = ctgSum[0];
+  const double tot1 = ctgSum[1];
   double sumL0 = 0.0; // Running left sum at category 0.
   double sumL1 = 0.0; // " " category 1.
   PredictorT argMaxRun = runNux.size() - 1;
   for (PredictorT runIdx = 0; runIdx != runNux.size() - 1; runIdx++) {
-    if (accumBinary(runNux, runIdx, sumL0, sumL1)) { // Splitable
+    if (accumBinary(runNux, runSum, runIdx, sumL0, sumL1)) { // Splitable
       // sumR, sumL magnitudes can be ignored if no large case/class weightings.
       FltVal sumL = sumL0 + sumL1;
       double ssL = sumL0 * sumL0 + sumL1 * sumL1;
       double ssR = (tot0 - sumL0) * (tot0 - sumL0) + (tot1 - sumL1) * (tot1 - sumL1);
-      if (trialSplit(infoGini(ssL, ssR, sumL, sumCount.sum - sumL))) {
+      double infoTrial = infoGini(ssL, ssR, sumL, sum - sumL);
+      if (infoTrial > info) {
+	info = infoTrial;
         argMaxRun = runIdx;
       }
     } 
   }
-  return SplitRun(info - infoCell, argMaxRun, runNux.size());
+  return argMaxRun;
 }
@@ -72,19 +72,18 @@ protected:
   /**
      @brief Builds runs for regression.
    */
-  vector<RunNux> regRuns(const SplitNux& cand);
+  ArenaVec<RunNux> regRuns(const SplitNux& cand);
 
 
-  vector<RunNux> initRuns(class RunSet* runSet,
-			  const class SplitNux& cand);
+  ArenaVec<RunNux> initRuns(const class SplitNux& cand);
 
 
-  vector<RunNux> regRunsExplicit(const SplitNux& cand);
+  ArenaVec<RunNux> regRunsExplicit(const SplitNux& cand);
 
   /**
      @brief As above, but also tracks a residual slot.
    */
-  vector<RunNux> regRunsImplicit(const SplitNux& cand);
+  ArenaVec<RunNux> regRunsImplicit(const SplitNux& cand);
 
 
   /**
@@ -94,17 +93,35 @@ protected:
 
      @return gain in weighted variance.
    */
-  SplitRun maxVar(const vector<RunNux>& runNux);
+  SplitRun maxVar(const ArenaVec<RunNux>& runNux);
 
   
+public:
+  static constexpr unsigned int maxWidth = 16; ///< Widest exhaustive subset search.
+
+
   /**
-     @brief Sorts by mean response.
+     @brief As above, but free of splitting state, so that a finisher
+     may split its own runs.
+
+     @param scTot summarizes the runs' response.
+
+     @param[in, out] info is the information high watermark.
+
+     @return slot of the rightmost run taking the true branch.
    */
-  void heapMean(const vector<RunNux>& runNux);
+  static PredictorT maxVar(const ArenaVec<RunNux>& runNux,
+			   const SumCount& scTot,
+			   double& info);
 
   
-public:
-  static constexpr unsigned int maxWidth = 10; // Algorithmic threshold.
+  /**
+     @brief Sorts by mean response.
+
+     @param[out] heap receives a priority queue over the runs.
+   */
+  static void heapMean(BHPair<PredictorT> heap[],
+		       const ArenaVec<RunNux>& runNux);
 
 
   /**
@@ -114,9 +131,9 @@ public:
 
 
   /**
-     @brief Determines whether run count must be truncated.
+     @brief Determines whether runs are too numerous for exhaustive search.
 
-     @return true iff run count exceeds maximum.
+     @return true iff multiclass and run count exceeds maximum.
    */
   static bool ctgWide(const class SplitFrontier* sf,
 		      const class SplitNux& cand);
@@ -125,7 +142,7 @@ public:
   /**
      @brief Depopulates the heap associated with a pair and places sorted ranks into rank vector.
   */
-  vector<RunNux> slotReorder(const vector<RunNux>& runNux);
+  ArenaVec<RunNux> slotReorder(const ArenaVec<RunNux>& runNux);
 
 
   void initReg(IndexT runLeft,
@@ -137,7 +154,7 @@ public:
 
      @param maskSense indicates whether to screen set or unset mask.
    */  
-  vector<RunNux> regRunsMasked(const SplitNux& cand,
+  ArenaVec<RunNux> regRunsMasked(const SplitNux& cand,
 			       const class BranchSense* branchSense,
 			       bool maskSense);
 
@@ -145,7 +162,7 @@ public:
   /**
      @brief Heap orders by target-mean encoding.
   */
-  vector<RunNux> orderMean(const vector<RunNux>& runNux);
+  ArenaVec<RunNux> orderMean(const ArenaVec<RunNux>& runNux);
 };
 
 
@@ -165,15 +182,14 @@ public:
   /**
      @brief Private splitting entry.
    */
-  SplitRun split(const vector<RunNux>& runNux);
+  SplitRun split(const ArenaVec<RunNux>& runNux);
 };
 
 
 
 class RunAccumCtg : public RunAccum {
   const PredictorT nCtg; ///< Response category count.
-  const bool sampling; ///< Whether to split sample.
-  const PredictorT sampleCount; ///< # runs to sample.
+  const bool wide; ///< Whether runs are ordered rather than enumerated.
   
   CtgNux ctgNux;
 
@@ -181,13 +197,15 @@ class RunAccumCtg : public RunAccum {
   vector<double> runSum; ///<  run x ctg checkerboard.
 
 
-  vector<RunNux> sampleRuns(const class RunSet* runSet,
-			    const class SplitNux& cand,
-			    const vector<RunNux>& runNux);
+  /**
+     @brief Reorders runs by heap, together with their category sums.
+
+     @return runs in heap order.
+   */
+  ArenaVec<RunNux> reorderCtg(const ArenaVec<RunNux>& runNux);
 
 
-  vector<RunNux> initRuns(class RunSet* runSet,
-			  const class SplitNux& cand);
+  ArenaVec<RunNux> initRuns(const class SplitNux& cand);
 
 
 public:
@@ -196,6 +214,26 @@ public:
 	      const class SplitNux& cand);
 
 
+  /**
+     @brief Derives the principal axis of the runs' category proportions.
+
+     Proportions are weighted by run response and centred on those of
+     the node.  The axis is approximated by power iteration.
+
+     @param runWeight is the response sum of each run.
+
+     @param ctgSum is the per-category response sum of the node.
+
+     @param sum is the response sum of the node.
+
+     @return unit vector, indexed by category.
+   */
+  static vector<double> principalAxis(const vector<double>& runSum,
+				      const vector<double>& runWeight,
+				      const vector<double>& ctgSum,
+				      double sum);
+
+
   /**
      @return checkerboard value at slot for category.
    */
@@ -208,6 +246,8 @@ public:
   /**
      @brief Accumulates the two binary response sums for a run.
 
+     @param runSum is the run x category checkerboard.
+
      @param slot is a run index.
 
      @param[in, out] sum0 accumulates the response at code 0.
@@ -216,32 +256,57 @@ public:
 
      @return true iff next run sufficiently different from this.
    */
-  bool accumBinary(const vector<RunNux>& runNux,
+  static bool accumBinary(const ArenaVec<RunNux>& runNux,
+			  const vector<double>& runSum,
 			  PredictorT slot,
 			  double& sum0,
 			  double& sum1) {
-    sum0 += getRunSum(slot, 0);
-    double cell1 = getRunSum(slot, 1);
+    sum0 += runSum[2 * slot];
+    double cell1 = runSum[2 * slot + 1];
     sum1 += cell1;
 
     // Two runs are deemed significantly different if their sample
     // counts differ. If identical, then checks whether the response
     // sums differ by some measure.
     PredictorT slotNext = slot+1;
-    return (runNux[slot].sumCount.sCount != runNux[slotNext].sumCount.sCount) ||  getRunSum(slotNext, 1) > cell1;
+    return (runNux[slot].sumCount.sCount != runNux[slotNext].sumCount.sCount) ||  runSum[2 * slotNext + 1] > cell1;
   }
 
 
   /**
      @brief Writes to heap, weighting by category-1 probability.
   */
-  vector<RunNux> orderBinary(const vector<RunNux>& runNux);
+  ArenaVec<RunNux> orderBinary(const ArenaVec<RunNux>& runNux);
 
 
   /**
      @brief Sorts by probability, binary response.
+
+     @param runSum is the run x category checkerboard.
+   */
+  static void heapBinary(BHPair<PredictorT> heap[],
+			 const ArenaVec<RunNux>& runNux,
+			 const vector<double>& runSum);
+
+
+  /**
+     @brief Orders runs by projection onto the principal axis.
    */
-  void heapBinary(const vector<RunNux>& runNux);
+  ArenaVec<RunNux> orderProjection(const ArenaVec<RunNux>& runNux);
+
+
+  /**
+     @brief Sorts by projected category proportions.
+
+     @param ctgSum is the per-category response sum of the node.
+
+     @param sum is the response sum of the node.
+   */
+  static void heapProjection(BHPair<PredictorT> heap[],
+			     const ArenaVec<RunNux>& runNux,
+			     const vector<double>& runSum,
+			     const vector<double>& ctgSum,
+			     double sum);
 
 
   /**
@@ -260,35 +325,34 @@ public:
   /**
      @brief Subtracts a run's per-category responses from the current run.
    */
-  void residualSums(const vector<RunNux>& runNux,
+  void residualSums(const ArenaVec<RunNux>& runNux,
 		       PredictorT implicitSlot);
 
 
   /**
      @brief Private entry for categorical splitting.
    */
-  SplitRun split(const vector<RunNux>& runNux);
+  SplitRun split(const ArenaVec<RunNux>& runNux);
 
 
   /**
      @brief Accumulates runs for classification.
 
-     @param sumSlice is the per-category response decomposition.
+     @param cand is the splitting candidate.
   */
-  vector<RunNux> ctgRuns(class RunSet* runSet,
-			 const class SplitNux& cand);
+  ArenaVec<RunNux> ctgRuns(const class SplitNux& cand);
 
   
   /**
      @brief Builds runs without checking for implicit observations.
    */
-  vector<RunNux> runsExplicit(const class SplitNux& cand);
+  ArenaVec<RunNux> runsExplicit(const class SplitNux& cand);
 
 
   /**
      @brief As above, but also tracks a residual slot
    */
-  vector<RunNux> runsImplicit(const class SplitNux& cand);
+  ArenaVec<RunNux> runsImplicit(const class SplitNux& cand);
 
 
   /**
@@ -302,18 +366,34 @@ public:
      convention, the final run is incorporated into RHS of the split, if any.
      Excluding the final run, then, the number of candidate LHS subsets is
      '2^(runNux.size()-1) - 1'.
+
+     Subsets are visited in Gray-code order, so that each differs from
+     its predecessor by a single run.  The per-category sums are then
+     revised by a single addition or subtraction.
      
      @return Gini information gain.
   */
-  SplitRun ctgGini(const vector<RunNux>& runNux);
+  SplitRun ctgGini(const ArenaVec<RunNux>& runNux);
 
 
   /**
-     @brief Determines Gini of a subset of runs encoded as bits.
+     @brief As above, but free of splitting state, as for a finisher.
 
-     @param sumSlice decomposes the partition node response by category.
+     @param[in, out] info is the information high watermark.
 
-     @param subset bit-encodes a collection of runs.
+     @return slot offsets of the runs taking the true branch, as bits.
+   */
+  static PredictorT ctgGini(PredictorT nRun,
+			    const vector<double>& runSum,
+			    const vector<double>& ctgSum,
+			    double sum,
+			    double& info);
+
+
+  /**
+     @brief Determines Gini of a subset of runs.
+
+     @param sumSampled decomposes the subset's response by category.
 
      N.B.:  Gini value should be symmetric w.r.t. fixed-size complements.
      
@@ -322,8 +402,30 @@ public:
 
      @return Gini coefficient of subset.
    */
-  double subsetGini(const vector<RunNux>& runNux,
-		    unsigned int subset) const;
+  double subsetGini(const vector<double>& sumSampled) const;
+
+
+  /**
+     @brief Gini-based splitting over runs in projection order.
+
+     Only the leading runs of the ordering are considered as LHS
+     subsets, so that the search is linear in the run count.
+
+     @return Gini information gain.
+   */
+  SplitRun orderedGini(const ArenaVec<RunNux>& runNux);
+
+
+  /**
+     @brief As above, but free of splitting state.
+
+     @return slot of the rightmost run taking the true branch.
+   */
+  static PredictorT orderedGini(PredictorT nRun,
+				const vector<double>& runSum,
+				const vector<double>& ctgSum,
+				double sum,
+				double& info);
 
 
   /**
@@ -331,7 +433,19 @@ public:
 
      @return Gini information gain.
    */
-  SplitRun binaryGini(const vector<RunNux>& runNux);
+  SplitRun binaryGini(const ArenaVec<RunNux>& runNux);
+
+
+  /**
+     @brief As above, but free of splitting state.
+
+     @return slot of the rightmost run taking the true branch.
+   */
+  static PredictorT binaryGini(const ArenaVec<RunNux>& runNux,
+			       const vector<double>& runSum,
+			       const vector<double>& ctgSum,
+			       double sum,
+			       double& info);
 };
 
 
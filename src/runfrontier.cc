@@ -13,7 +13,6 @@
    @author Mark Seligman
  */
 
-#include "prng.h"
 #include "runaccum.h"
 #include "interlevel.h"
 #include "splitfrontier.h"
@@ -35,27 +34,25 @@ IndexT RunSet::preIndex(const SplitFrontier*sf, const SplitNux& cand) {
 }
 
 
-const double* RunSet::rvSlice(IndexT sigIdx) const {
-  return &rvWide[RunAccum::maxWidth * (lower_bound(runWide.begin(), runWide.end(), sigIdx) - runWide.begin())];
+bool RunSet::isWide(IndexT sigIdx) const {
+  return binary_search(runWide.begin(), runWide.end(), sigIdx);
 }
 
   
 void RunSet::accumPreset(const SplitFrontier* sf) {
   runSig = vector<RunSig>(nAccum);
-  if (!runWide.empty())
-    rvWide = PRNG::rUnif<double>(RunAccum::maxWidth * runWide.size());
 }
 
 
 void RunSet::setSplit(SplitNux& nux,
-		      vector<RunNux> runNux,
+		      ArenaVec<RunNux> runNux,
 		      const SplitRun& splitRun) {
   nux.setInfo(splitRun.gain);
   runSig[nux.getSigIdx()] = RunSig(std::move(runNux), splitRun.token, splitRun.runsSampled);
 }
 
 
-const vector<RunNux>& RunSet::getRunNux(const SplitNux& nux) const {
+const ArenaVec<RunNux>& RunSet::getRunNux(const SplitNux& nux) const {
   return runSig[nux.getSigIdx()].runNux;
 }
 
@@ -87,7 +84,7 @@ void RunSet::resetRunSup(PredictorT sigIdx,
 
 
 void RunSet::accumUpdate(const SplitNux& cand) {
-  runSig[cand.getSigIdx()].updateCriterion(cand, style);
+  runSig[cand.getSigIdx()].updateCriterion(cand, isWide(cand.getSigIdx()) ? SplitStyle::slots : style);
 }
 
 
@@ -37,7 +37,6 @@ class RunSet {
 
   // Non-binary categorical only:
   vector<IndexT> runWide; ///> Wide-run accumulator indices, ordered.
-  vector<double> rvWide; ///> Random variates for sampling wide runs.
 
 public:
 
@@ -50,15 +49,14 @@ public:
 
 
   /**
-     @brief Determines position of random-variate slice.
+     @brief Determines whether an accumulator's runs were ordered,
+     rather than enumerated, and so split as slots.
 
-     Slices have an implicit width of RunAccum::maxWidth.
-     
-     @param sigIdx is the index of a wide-run accumulator.
+     @param sigIdx is the index of an accumulator.
 
-     @return base variate position for accumulator.
+     @return true iff accumulator is wide.
    */
-  const double* rvSlice(IndexT sigIdx) const;
+  bool isWide(IndexT sigIdx) const;
 
 
   /**
@@ -71,7 +69,7 @@ public:
 
 
   void setSplit(class SplitNux& cand,
-		vector<RunNux> runNux,
+		ArenaVec<RunNux> runNux,
 		const struct SplitRun& splitRun);
 
   
@@ -83,7 +81,7 @@ public:
   void accumPreset(const class SplitFrontier* sf);
 
 
-  const vector<RunNux>& getRunNux(const class SplitNux& cand) const;
+  const ArenaVec<RunNux>& getRunNux(const class SplitNux& cand) const;
 
   
   vector<IndexRange> getRunRange(const class SplitNux& nux,
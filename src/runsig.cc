@@ -20,7 +20,7 @@
 #include "interlevel.h"
 
 
-RunSig::RunSig(vector<RunNux> runNux_,
+RunSig::RunSig(ArenaVec<RunNux> runNux_,
 	       PredictorT splitToken_,
 	       PredictorT runsSampled_) :
   runNux(std::move(runNux_)),
@@ -153,7 +153,7 @@ void RunSig::leadBits(const SplitNux& nux) {
 
   // Places true-sense runs to the left for range and code capture.
   // runNux.size() captures all factor levels visible to the cell.
-  vector<RunNux> frTemp;
+  ArenaVec<RunNux> frTemp;
   for (PredictorT runIdx = 0; runIdx != runNux.size(); runIdx++) {
     if (lhBits & (1ul << runIdx)) {
       frTemp.emplace_back(runNux[runIdx]);
@@ -17,6 +17,7 @@
 #define SPLIT_RUNSIG_H
 
 #include "sumcount.h"
+#include "arena.h"
 
 #include <vector>
 
@@ -98,7 +99,7 @@ struct RunNux {
  */
 struct RunSig {
   // Initialized by splitting:
-  vector<RunNux> runNux;
+  ArenaVec<RunNux> runNux;
   PredictorT splitToken; ///< Cut or bits.
 
   PredictorT runsSampled; ///< # ctg participating in split.
@@ -111,7 +112,7 @@ struct RunSig {
   RunSig() = default;
 
 
-  RunSig(vector<RunNux> runNux_,
+  RunSig(ArenaVec<RunNux> runNux_,
 	 PredictorT splitToken_,
 	 PredictorT runsSampled_);
 
@@ -53,10 +53,10 @@ struct Sample {
      @return index variates, typically w.r.t. shrinking interval.
    */
   static vector<indexType> rUnifIndex(const vector<indexType>& scale) {
-    vector<indexType> variates = PRNG::rUnif(scale.size());
-    indexType idx = 0;
-    for (indexType& var : variates) {
-      var *= scale[idx++];
+    vector<double> unif = PRNG::rUnif<double>(scale.size());
+    vector<indexType> variates(scale.size());
+    for (size_t idx = 0; idx != scale.size(); idx++) {
+      variates[idx] = unif[idx] * scale[idx];
     }
 
     return variates;
@@ -157,7 +157,7 @@ struct Sample {
    */
   static vector<indexType> permute(indexType nSlot) {
     BHeap<indexType> bHeap;
-    for (const double& variate : PRNG::rUnif<double>(nSlot)) {
+    for (const double& variate : PRNG::rUnif<double>(nSlot, 1.0, PRNG::Purpose::permute)) {
       bHeap.insert(variate);
     }
 
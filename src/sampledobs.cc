@@ -24,6 +24,7 @@
 #include "booster.h"
 
 #include <numeric>
+#include <algorithm>
 
 vector<double> SampledObs::obsWeight = vector<double>(0);
 vector<double> SampledCtg::classWeight = vector<double>(0);
@@ -56,7 +57,8 @@ SampledObs::SampledObs(const Sampler* sampler,
   adder(adder_),
   bagSum(0.0),
   obs2Sample(vector<IndexT>(sampler->getNObs())),
-  ctgRoot(vector<SumCount>(sampler->getNCtg())) {
+  ctgRoot(vector<SumCount>(sampler->getNCtg())),
+  frame(nullptr) {
 }
 
 
@@ -158,31 +160,34 @@ void SampledObs::bagTrivial(const vector<double>& y,
 
 
 void SampledObs::setRanks(const PredictorFrame* layout) {
+  frame = layout;
   sample2Rank = vector<vector<IndexT>>(layout->getNPred());
-  runCount = vector<IndexT>(layout->getNPred());
+  rankOnce = make_unique<once_flag[]>(layout->getNPred());
+}
 
-#pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
-  {
-#pragma omp for schedule(dynamic, 1)
-    for (OMPBound predIdx = 0; predIdx < layout->getNPred(); predIdx++)
-      sample2Rank[predIdx] = sampleRanks(layout, predIdx);
-  }
+
+const vector<IndexT>& SampledObs::getRanks(PredictorT predIdx) const {
+  call_once(rankOnce[predIdx], [this, predIdx]() {
+      sample2Rank[predIdx] = sampleRanks(predIdx);
+    });
+  return sample2Rank[predIdx];
 }
 
 
-vector<IndexT> SampledObs::sampleRanks(const PredictorFrame* layout, PredictorT predIdx) {
+vector<IndexT> SampledObs::sampleRanks(PredictorT predIdx) const {
   vector<IndexT> sampledRanks(bagCount);
-  const vector<IndexT>& obs2Rank = layout->getRanks(predIdx);
-  IndexT sIdx = 0;
-  vector<unsigned char> rankSeen(obs2Rank.size());
-  for (IndexT row = 0; row != obs2Rank.size(); row++) {
-    if (obs2Sample[row] < bagCount) {
-      IndexT rank = obs2Rank[row];
-      sampledRanks[sIdx++] = rank;
-      rankSeen[rank] = 1;
+  const vector<IndexT>& obs2Rank = frame->getRanks(predIdx);
+  if (nux.empty()) { // Trivial bag:  samples and rows coincide.
+    copy(obs2Rank.begin(), obs2Rank.begin() + bagCount, sampledRanks.begin());
+  }
+  else { // Gathers from the bagged rows only, in sample order.
+    IndexT sIdx = 0;
+    IndexT obsIdx = 0;
+    for (const SamplerNux& nx : nux) {
+      obsIdx += nx.getDelRow();
+      sampledRanks[sIdx++] = obs2Rank[obsIdx];
     }
   }
-  runCount[predIdx] = accumulate(rankSeen.begin(), rankSeen.end(), 0);
 
   return sampledRanks;
 }
@@ -22,6 +22,8 @@
 #include "obs.h"
 
 #include <vector>
+#include <mutex>
+#include <memory>
 
 struct NodeScorer;
 
@@ -50,9 +52,10 @@ class SampledObs {
   vector<SumCount> ctgRoot; ///< Root census of categorical response.
   vector<SampleNux> sampleNux; ///< Per-sample summary, with row-delta.
 
-  // Reset at staging:
-  vector<vector<IndexT>> sample2Rank; ///< Splitting rank map.
-  vector<IndexT> runCount; ///< Staging initialization.
+  // Mapped lazily, as trees may reference few predictors:
+  const PredictorFrame* frame; ///< Source of predictor ranks.
+  mutable vector<vector<IndexT>> sample2Rank; ///< Splitting rank map.
+  mutable unique_ptr<once_flag[]> rankOnce; ///< Guards each map.
 
 
   virtual void sampleObservations(NodeScorer*) = 0;
@@ -79,8 +82,7 @@ class SampledObs {
   /**
      @return map from sample index to predictor rank.
    */
-  vector<IndexT> sampleRanks(const PredictorFrame* layout,
-			     PredictorT predIdx);
+  vector<IndexT> sampleRanks(PredictorT predIdx) const;
 
 
 public:
@@ -221,6 +223,14 @@ public:
   }
 
 
+  /**
+     @return summary of sample at index passed.
+   */
+  const SampleNux& getSampleNux(IndexT sIdx) const {
+    return sampleNux[sIdx];
+  }
+
+
   /**
      @brief Getter for row delta.
 
@@ -249,17 +259,23 @@ public:
   }
 
 
-  IndexT getRank(PredictorT predIdx,
-			IndexT sIdx) const {
-    return sample2Rank[predIdx][sIdx];
-  }
+  /**
+     @brief Maps a predictor's ranks on first reference.  Thread-safe.
+
+     @return predictor ranks, by sample index.
+   */
+  const vector<IndexT>& getRanks(PredictorT predIdx) const;
 
 
-  IndexT getRunCount(PredictorT predIdx) const {
-    return runCount[predIdx];
+  IndexT getRank(PredictorT predIdx,
+			IndexT sIdx) const {
+    return getRanks(predIdx)[sIdx];
   }
 
   
+  /**
+     @brief Prepares rank maps for lazy construction.
+   */
   void setRanks(const PredictorFrame* layout);
 };
 
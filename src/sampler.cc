@@ -16,7 +16,9 @@
 #include "forest.h"
 #include "quant.h"
 #include "rleframe.h"
+#include "colframe.h"
 #include "bv.h"
+#include "ompthread.h"
 #include "prng.h"
 
 
@@ -35,7 +37,7 @@ Sampler::Sampler(size_t nSamp_,
   nRep(nRep_),
   nObs(nObs_),
   unobserved(unobserved_),
-  holdout(makeHoldout(nObs, nHoldout, unobserved)),
+  holdout(makeHoldout(nRep, nObs, nHoldout, unobserved)),
   noSample(makeNoSample(unobserved, holdout)),
   replace(replace_),
   omitMap(makeOmitMap(nObs, noSample, replace)),
@@ -47,9 +49,11 @@ Sampler::Sampler(size_t nSamp_,
 }
 
 
-vector<size_t> Sampler::makeHoldout(size_t nObs,
+vector<size_t> Sampler::makeHoldout(unsigned int streamIdx,
+				    size_t nObs,
 				    size_t nHoldout,
 				    const vector<size_t>& undefined) {
+  PRNG::setStream(streamIdx);
   return Sample<size_t>::sampleWithout(nObs, undefined, nHoldout);
 }
 
@@ -199,9 +203,57 @@ Sampler::Sampler(const vector<PredictorT>& yTrain,
 }
 
 
+Sampler::Sampler(const vector<double>& yTrain,
+		 vector<vector<SamplerNux>> samples_,
+		 size_t nSamp_,
+		 unique_ptr<ColFrame> colFrame) :
+  nRep(samples_.size()),
+  nObs(yTrain.size()),
+  nSamp(nSamp_),
+  response(Response::factoryReg(yTrain)),
+  samples(std::move(samples_)),
+  predict(Predict::makeRegDirect(this, std::move(colFrame))) {
+}
+
+
+Sampler::Sampler(const vector<PredictorT>& yTrain,
+		 vector<vector<SamplerNux>> samples_,
+		 size_t nSamp_,
+		 PredictorT nCtg,
+		 unique_ptr<ColFrame> colFrame) :
+  nRep(samples_.size()),
+  nObs(yTrain.size()),
+  nSamp(nSamp_),
+  response(Response::factoryCtg(yTrain, nCtg)),
+  samples(std::move(samples_)),
+  predict(Predict::makeCtgDirect(this, std::move(colFrame))) {
+}
+
+
 Sampler::~Sampler() = default;
 
 
+void Sampler::setFrame(unique_ptr<RLEFrame> rleFrame) {
+  if (getNCtg() > 0)
+    predict = Predict::makeCtg(this, std::move(rleFrame));
+  else
+    predict = Predict::makeReg(this, std::move(rleFrame));
+}
+
+
+void Sampler::clearFrame() {
+  predict = nullptr;
+}
+
+
+void Sampler::setFrame(unique_ptr<ColFrame> colFrame) {
+  if (getNCtg() > 0)
+    predict = Predict::makeCtgDirect(this, std::move(colFrame));
+  else
+    predict = Predict::makeRegDirect(this, std::move(colFrame));
+}
+
+
 unique_ptr<BitMatrix> Sampler::makeBag(bool bagging) const {
   if (!bagging)
     return make_unique<BitMatrix>(0, 0);
@@ -237,6 +289,25 @@ vector<IdCount> Sampler::obsExpand(const vector<SampleNux>& nuxen) const {
 
 
 void Sampler::sample() {
+  vector<vector<SamplerNux>> treeNux(nRep);
+#pragma omp parallel default(shared) num_threads(OmpThread::getNThread())
+  {
+#pragma omp for schedule(dynamic, 1)
+  for (OMPBound tIdx = 0; tIdx < nRep; tIdx++) {
+    treeNux[tIdx] = sampleTree(tIdx);
+  }
+  }
+
+  for (vector<SamplerNux>& nux : treeNux) {
+    sbCresc.insert(sbCresc.end(), nux.begin(), nux.end());
+    nux.clear();
+    nux.shrink_to_fit();
+  }
+}
+
+
+vector<SamplerNux> Sampler::sampleTree(unsigned int tIdx) const {
+  PRNG::setStream(tIdx);
   vector<size_t> idxOut;
   if (trivial) { // No sampling:  use entire index set.
     idxOut = vector<size_t>(nObs);
@@ -255,22 +326,37 @@ void Sampler::sample() {
     idxOut = Sample<size_t>::sampleWith(nObs, omitMap, nSamp);
   }
 
-  appendSamples(idxOut);
+  return packSamples(idxOut);
 }
 
 
-void Sampler::appendSamples(const vector<size_t>& idx) {
-  vector<IndexT> sCountRow = binIdx(nObs) > 0 ? countSamples(binIndices(nObs, idx)) : countSamples(idx);
+vector<SamplerNux> Sampler::packSamples(vector<size_t>& idx) const {
+  vector<SamplerNux> nux;
   size_t obsPrev = 0;
+  if (sparseCount(idx.size())) { // Cost proportional to sample count.
+    sort(idx.begin(), idx.end());
+    for (size_t idxStart = 0; idxStart != idx.size(); ) {
+      size_t obsIdx = idx[idxStart];
+      size_t idxEnd = idxStart + 1;
+      while (idxEnd != idx.size() && idx[idxEnd] == obsIdx)
+	idxEnd++;
+      nux.emplace_back(obsIdx - exchange(obsPrev, obsIdx), idxEnd - idxStart);
+      idxStart = idxEnd;
+    }
+    return nux;
+  }
+
+  vector<IndexT> sCountRow = binIdx(nObs) > 0 ? countSamples(binIndices(nObs, idx)) : countSamples(idx);
   for (size_t obsIdx = 0; obsIdx < nObs; obsIdx++) {
     if (sCountRow[obsIdx] > 0) {
-      sbCresc.emplace_back(obsIdx - exchange(obsPrev, obsIdx), sCountRow[obsIdx]);
+      nux.emplace_back(obsIdx - exchange(obsPrev, obsIdx), sCountRow[obsIdx]);
     }
   }
+  return nux;
 }
 
 
-vector<IndexT> Sampler::countSamples(const vector<size_t>& idx) {
+vector<IndexT> Sampler::countSamples(const vector<size_t>& idx) const {
   vector<IndexT> sampleCount(nObs);
   for (auto index : idx) {
     sampleCount[index]++;
@@ -20,6 +20,7 @@
 #include "typeparam.h"
 #include "sampledobs.h"
 #include "sample.h"
+#include "util.h"
 
 #include <memory>
 #include <vector>
@@ -93,7 +94,17 @@ class Sampler {
 
      @return vector of sample counts.
    */
-  vector<IndexT> countSamples(const vector<size_t>& idx);
+  vector<IndexT> countSamples(const vector<size_t>& idx) const;
+
+
+  /**
+     @brief Determines whether to count by sorting the sampled indices.
+
+     @return true iff sorting is cheaper than tabulating over all observations.
+   */
+  bool sparseCount(size_t nIdx) const {
+    return nIdx < nObs && nIdx * Util::packedWidth(nIdx) < nObs;
+  }
   
 
 public:
@@ -159,9 +170,50 @@ public:
 
 
   /**
-     @brief Samples response for a single tree.
+     @brief Classification constructor:  direct prediction.
+   */
+  Sampler(const vector<PredictorT>& yTrain,
+	  vector<vector<SamplerNux>> samples_,
+	  size_t nSamp_,
+	  PredictorT nCtg,
+	  unique_ptr<struct ColFrame> colFrame);
+
+
+  /**
+     @brief Regression constructor:  direct prediction.
+   */
+  Sampler(const vector<double>& yTrain,
+	  vector<vector<SamplerNux>> samples_,
+	  size_t nSamp_,
+	  unique_ptr<struct ColFrame> colFrame);
+
+
+  /**
+     @brief Replaces the frame under prediction, retaining trained state.
+
+     Permits a loaded sampler to predict successive frames without
+     being rebuilt.
+   */
+  void setFrame(unique_ptr<struct RLEFrame> rleFrame);
+
+
+  void setFrame(unique_ptr<struct ColFrame> colFrame);
+
+
+  /**
+     @brief Releases the frame under prediction, if any.
+   */
+  void clearFrame();
+
+
+  /**
+     @brief Packs a single tree's sampled indices, in observation order.
+
+     @param[in, out] idx are the sampled indices, possibly reordered.
+
+     @return tree's samples, compressed.
    */
-  void appendSamples(const vector<size_t>& idx);
+  vector<SamplerNux> packSamples(vector<size_t>& idx) const;
 
 
   const vector<SamplerNux>& getSamples(unsigned int tIdx) const {
@@ -301,10 +353,13 @@ public:
      @param nHoldout is the specified number of indices to choose.
      
      @param unobserved are indices not to be chosen.
+
+     @param streamIdx selects a PRNG stream distinct from the trees'.
      
      @return vector of held-out indices.
    */
-  static vector<size_t> makeHoldout(size_t nObs,
+  static vector<size_t> makeHoldout(unsigned int streamIdx,
+				    size_t nObs,
 				    size_t nHoldout,
 				    const vector<size_t>& unobserved);
 
@@ -345,7 +400,15 @@ public:
   /**
      @brief Samples a single tree's worth of observations.
 
-     @param obsOmit are observations to omit from sampling.
+     @param tIdx selects the tree's PRNG stream.
+
+     @return tree's samples, compressed.
+   */
+  vector<SamplerNux> sampleTree(unsigned int tIdx) const;
+
+
+  /**
+     @brief Samples all trees, in parallel, and appends them in order.
    */
   void sample();
 
@@ -23,11 +23,13 @@
    @author Mark Seligman
  */
 
+#include "corebridge.h"
 #include "prng.h"
 #include "resizeR.h"
 #include "samplerR.h"
 #include "samplerbridge.h"
 #include "rleframeR.h"
+#include "colframeR.h"
 
 #include <algorithm>
 
@@ -47,7 +49,8 @@ RcppExport SEXP rootSample(const SEXP sY,
 			   const SEXP sWithRepl,
 			   const SEXP sNHoldout,
 			   const SEXP sNFold,
-			   const SEXP sIdxUndefined) {
+			   const SEXP sIdxUndefined,
+			   const SEXP sNThread) {
   NumericVector weight(as<NumericVector>(sWeight));
   vector<size_t> undefined;
   if (Rf_isInteger(sIdxUndefined)) { // Index type specified by front end.
@@ -59,7 +62,7 @@ RcppExport SEXP rootSample(const SEXP sY,
     undefined = vector<size_t>(undefinedFE.begin(), undefinedFE.end());
   }
 
-  return SamplerR::rootSample(sY, sNSamp, sNTree, sWithRepl, vector<double>(weight.begin(), weight.end()), sNHoldout, sNFold, undefined);
+  return SamplerR::rootSample(sY, sNSamp, sNTree, sWithRepl, vector<double>(weight.begin(), weight.end()), sNHoldout, sNFold, undefined, sNThread);
 }
 
 
@@ -71,7 +74,10 @@ List SamplerR::rootSample(const SEXP sY,
 			  const vector<double>& weight,
 			  const SEXP sNHoldout,
 			  const SEXP sNFold,
-			  const vector<size_t>& undefined) {
+			  const vector<size_t>& undefined,
+			  const SEXP sNThread) {
+  CoreBridge::init(as<unsigned int>(sNThread));
+  CoreBridge::seed();
   SamplerBridge bridge(as<size_t>(sNSamp), getNObs(sY), as<unsigned int>(sNTree), as<bool>(sWithRepl), weight, as<size_t>(sNHoldout), as<unsigned int>(sNFold), undefined);
   sampleRepeatedly(bridge);
   return wrap(bridge, sY);
@@ -90,10 +96,8 @@ size_t SamplerR::getNObs(const SEXP& sY) {
 
 
 void SamplerR::sampleRepeatedly(SamplerBridge& bridge) {
-  // May be parallelized if a thread-safe PRNG is available.
-  for (unsigned int tIdx = 0; tIdx < bridge.getNRep(); tIdx++) {
-    bridge.sample();
-  }
+  // Trees are sampled in parallel, each from its own stream.
+  bridge.sample();
 }
 
 
@@ -232,6 +236,20 @@ SamplerBridge SamplerR::unwrapPredict(const List& lSampler,
 }
 
 
+void SamplerR::attachFrame(SamplerBridge& samplerBridge,
+			   const List& lSampler,
+			   const List& lDeframe,
+			   bool bagging) {
+  if (bagging)
+    checkOOB(lSampler, lDeframe);
+
+  if (lDeframe.containsElementNamed("colFrame"))
+    samplerBridge.setFrame(ColFrameR::unwrap(lDeframe));
+  else
+    samplerBridge.setFrame(RLEFrameR::unwrap(lDeframe));
+}
+
+
 // [[Rcpp::export]]
 void SamplerR::checkOOB(const List& lSampler, const List& lDeframe) {
   if (Rf_isNull(lSampler[strSamples]))
@@ -246,6 +264,13 @@ SamplerBridge SamplerR::makeBridgeNum(const List& lSampler,
 				      const List& lDeframe,
 				      bool generic) {
   NumericVector yTrain(as<NumericVector>(lSampler[strYTrain]));
+  if (!generic && lDeframe.containsElementNamed("colFrame")) {
+    return SamplerBridge(vector<double>(yTrain.begin(), yTrain.end()),
+			 as<size_t>(lSampler[strNSamp]),
+			 as<unsigned int>(lSampler[strNTree]),
+			 Rf_isNull(lSampler[strSamples]) ? nullptr : NumericVector((SEXP) lSampler[strSamples]).begin(),
+			 ColFrameR::unwrap(lDeframe));
+  }
   return SamplerBridge(vector<double>(yTrain.begin(), yTrain.end()),
 		       as<size_t>(lSampler[strNSamp]),
 		       as<unsigned int>(lSampler[strNTree]),
@@ -258,6 +283,14 @@ SamplerBridge SamplerR::makeBridgeCtg(const List& lSampler,
 				      const List& lDeframe,
 				      bool generic) {
   IntegerVector yTrain(as<IntegerVector>(lSampler[strYTrain]));
+  if (!generic && lDeframe.containsElementNamed("colFrame")) {
+    return SamplerBridge(coreCtg(yTrain),
+			 as<CharacterVector>(yTrain.attr("levels")).length(),
+			 as<size_t>(lSampler[strNSamp]),
+			 as<unsigned int>(lSampler[strNTree]),
+			 Rf_isNull(lSampler[strSamples]) ? nullptr : NumericVector((SEXP) lSampler[strSamples]).begin(),
+			 ColFrameR::unwrap(lDeframe));
+  }
   return SamplerBridge(coreCtg(yTrain),
 		       as<CharacterVector>(yTrain.attr("levels")).length(),
 		       as<size_t>(lSampler[strNSamp]),
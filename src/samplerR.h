@@ -39,7 +39,8 @@ RcppExport SEXP rootSample(const SEXP sY,
 			   const SEXP sWithRepl,
 			   const SEXP sNHoldout,
 			   const SEXP sNFold,
-			   const SEXP sUndefined);
+			   const SEXP sUndefined,
+			   const SEXP sNThread);
 
 
 /**
@@ -62,7 +63,8 @@ struct SamplerR {
 			 const vector<double>& weight,
 			 const SEXP sNHoldout,
 			 const SEXP sNFold,
-			 const vector<size_t>& undefined);
+			 const vector<size_t>& undefined,
+			 const SEXP sNThread);
 
 
   /**
@@ -178,6 +180,17 @@ struct SamplerR {
 					    bool bagging);
 
 
+  /**
+     @brief Attaches a deframed observation set to a loaded sampler.
+
+     Parameters as with unwrapPredict.
+   */
+  static void attachFrame(struct SamplerBridge& samplerBridge,
+			  const List& lSampler,
+			  const List& lDeframe,
+			  bool bagging);
+
+
   /**
      @return core-ready vector of zero-based factor codes.
    */
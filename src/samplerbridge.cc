@@ -18,6 +18,7 @@
 #include "forestbridge.h"
 #include "sampler.h"
 #include "rleframe.h"
+#include "colframe.h"
 
 #include <memory>
 using namespace std;
@@ -95,6 +96,29 @@ SamplerBridge::SamplerBridge(vector<unsigned int> yTrain,
 }
 
 
+SamplerBridge::SamplerBridge(vector<double> yTrain,
+			     size_t nSamp,
+			     unsigned int nTree,
+			     const double samples[],
+			     unique_ptr<ColFrame> colFrame) {
+  SamplerNux::setMasks(yTrain.size());
+  vector<vector<SamplerNux>> nux = SamplerNux::unpack(samples, nSamp, nTree);
+  sampler = make_unique<Sampler>(yTrain, std::move(nux), nSamp, std::move(colFrame));
+}
+
+
+SamplerBridge::SamplerBridge(vector<unsigned int> yTrain,
+			     unsigned int nCtg,
+			     size_t nSamp,
+			     unsigned int nTree,
+			     const double samples[],
+			     unique_ptr<ColFrame> colFrame) {
+  SamplerNux::setMasks(yTrain.size());
+  vector<vector<SamplerNux>> nux = SamplerNux::unpack(samples, nSamp, nTree, nCtg);
+  sampler = make_unique<Sampler>(yTrain, std::move(nux), nSamp, nCtg, std::move(colFrame));
+}
+
+
 SamplerBridge::SamplerBridge(size_t nObs,
 			     const double samples[],
 			     size_t nSamp,
@@ -112,6 +136,23 @@ SamplerBridge::SamplerBridge(SamplerBridge&& sb) :
 SamplerBridge::~SamplerBridge() = default;
 
 
+void SamplerBridge::setFrame(unique_ptr<RLEFrame> rleFrame) {
+  SamplerNux::setMasks(sampler->getNObs());
+  sampler->setFrame(std::move(rleFrame));
+}
+
+
+void SamplerBridge::setFrame(unique_ptr<ColFrame> colFrame) {
+  SamplerNux::setMasks(sampler->getNObs());
+  sampler->setFrame(std::move(colFrame));
+}
+
+
+void SamplerBridge::clearFrame() {
+  sampler->clearFrame();
+}
+
+
 void SamplerBridge::sample() {
   sampler->sample();
 }
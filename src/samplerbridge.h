@@ -80,6 +80,24 @@ struct SamplerBridge {
 		unique_ptr<struct RLEFrame> rleFrame);
 
 
+  /**
+     @brief Prediction constructors over unsorted frames.
+   */
+  SamplerBridge(vector<double> yTrain,
+		size_t nSamp,
+		unsigned int nTree,
+		const double samples[],
+		unique_ptr<struct ColFrame> colFrame);
+
+
+  SamplerBridge(vector<unsigned int> yTrain,
+		unsigned int nCtg,
+		size_t nSamp,
+		unsigned int nTree,
+		const double samples[],
+		unique_ptr<struct ColFrame> colFrame);
+
+
   /**
      @brief Generic constructor.
    */
@@ -93,7 +111,25 @@ struct SamplerBridge {
 
 
   /**
-     @brief Invokes core sampling for a single tree.
+     @brief Attaches a new frame for prediction by a loaded sampler.
+
+     Restores the sample-encoding state released by the previous
+     prediction.
+   */
+  void setFrame(unique_ptr<struct RLEFrame> rleFrame);
+
+
+  void setFrame(unique_ptr<struct ColFrame> colFrame);
+
+
+  /**
+     @brief Releases the frame following prediction.
+   */
+  void clearFrame();
+
+
+  /**
+     @brief Invokes core sampling for all trees.
    */
   void sample();
 
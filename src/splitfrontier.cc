@@ -238,7 +238,7 @@ int SFReg::getMonoMode(const SplitNux& cand) const {
 
 vector<double> SFReg::sampleMono(IndexT nSplit) {
   if (!mono.empty()) {
-    return PRNG::rUnif<double>(nSplit * mono.size());
+    return PRNG::rUnif<double>(nSplit * mono.size(), 1.0, PRNG::Purpose::mono);
   }
   else
     return vector<double>(0);
@@ -269,7 +269,7 @@ void SplitFrontier::maxSimple(const vector<SplitNux>& sc,
 }
 
 
-vector<SplitNux> SplitFrontier::maxCandidates(const vector<vector<SplitNux>>& candVV) {
+vector<SplitNux> SplitFrontier::maxCandidates(const vector<ArenaVec<SplitNux>>& candVV) {
   vector<SplitNux> argMax(nSplit); // Info initialized to zero.
 
   OMPBound splitTop = nSplit;
@@ -285,8 +285,8 @@ vector<SplitNux> SplitFrontier::maxCandidates(const vector<vector<SplitNux>>& ca
 }
 
 
-vector<vector<SplitNux>> SplitFrontier::groupCand(const vector<SplitNux>& cand) const {
-  vector<vector<SplitNux>> candVV(nSplit);
+vector<ArenaVec<SplitNux>> SplitFrontier::groupCand(const vector<SplitNux>& cand) const {
+  vector<ArenaVec<SplitNux>> candVV(nSplit);
   for (auto nux : cand) {
     candVV[nux.getNodeIdx()].emplace_back(nux);
   }
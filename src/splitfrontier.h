@@ -76,7 +76,7 @@ protected:
 		 BranchSense& branchSense);
 
   
-  vector<class SplitNux> maxCandidates(const vector<vector<class SplitNux>>& candVV);
+  vector<class SplitNux> maxCandidates(const vector<ArenaVec<class SplitNux>>& candVV);
 
   
   /**
@@ -325,7 +325,7 @@ public:
   /**
      @brief Separates candidates into split-specific vectors.
    */
-  vector<vector<class SplitNux>> groupCand(const vector<SplitNux>& cand) const;
+  vector<ArenaVec<class SplitNux>> groupCand(const vector<SplitNux>& cand) const;
 
   
   /**
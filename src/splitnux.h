@@ -59,6 +59,14 @@ public:
   static void deImmutables();
 
 
+  /**
+     @return ratio of a successor's information threshold to its parent's gain.
+   */
+  static double getMinRatio() {
+    return minRatio;
+  }
+
+
   /**
      @retrun true iff run's range exceeds bounds.
    */
@@ -21,6 +21,18 @@
 
 #include <vector>
 
+
+/**
+   @brief Reason for which a cell is restaged.
+ */
+enum class RestageCause : unsigned int {
+  demand, ///< Cell is ancestor of a splitting candidate.
+  efficiency, ///< Rear layer flushed for low occupancy.
+  pathLimit, ///< Rear layer flushed, as history would exceed paths.
+  nCause
+};
+
+
 /**
    @brief Cell statistics following (re)staging.
  */
@@ -37,21 +49,22 @@ struct StagedCell {
   IndexT obsMissing; ///< # obs with missing predictor values.
 
   /**
-     @brief Root constructor.
+     @brief Staging constructor:  cell is staged directly from the frame.
+
+     @param range_ is the node's range, revised once staged.
    */
-StagedCell(PredictorT predIdx,
-	   IndexT valIdx_,
-	   IndexT extent,
-	   IndexT runCount_,
-	   bool trackRuns_ = false)
-  : coord(SplitCoord(0, predIdx)),
+StagedCell(const SplitCoord& coord_,
+	   const IndexRange& range_)
+  : coord(coord_),
     bufIdx(0),
-    trackRuns(trackRuns_),
+    trackRuns(false),
     live(true),
-    valIdx(valIdx_),
-    runCount(runCount_),
-    obsRange(IndexRange(0, extent)),
-    preResidual(0) {
+    valIdx(0),
+    runCount(0),
+    obsRange(range_),
+    obsImplicit(0),
+    preResidual(0),
+    obsMissing(0) {
     }
   
 
@@ -112,17 +125,6 @@ StagedCell(IndexT nodeIdx,
   }
 
   
-  /**
-     @brief Updates observation statistics; root only.
-   */
-  void updateCounts(IndexT implicitCount,
-		    IndexT obsMissing) {
-    obsRange.idxExtent -= implicitCount;
-    obsImplicit = implicitCount;
-    this->obsMissing = obsMissing;
-  }
-
-
   /**
      @brief Initializes target cell from per-path statisics.
    */
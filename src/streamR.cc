@@ -0,0 +1,213 @@
+// Copyright (C)  2012-2024  Mark Seligman
+//
+// This file is part of RboristBase.
+//
+// RboristBase is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// RboristBase is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RboristBase.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+   @file streamR.cc
+
+   @brief C++ sinks streaming prediction to the front end.
+
+   @author Mark Seligman
+ */
+
+#include "streamR.h"
+#include "samplerR.h"
+#include "samplerbridge.h"
+#include "forestbridge.h"
+#include "predictbridge.h"
+
+const string StreamR::strStream = "stream";
+
+
+List StreamR::predict(const SEXP sStream,
+		      const List& lSampler,
+		      const SamplerBridge& samplerBridge,
+		      ForestBridge& forestBridge) {
+  bool isCtg = Rf_isFactor((SEXP) lSampler[SamplerR::strYTrain]);
+  CharacterVector levelsTrain(0);
+  if (isCtg) {
+    IntegerVector yTrain(as<IntegerVector>(lSampler[SamplerR::strYTrain]));
+    levelsTrain = as<CharacterVector>(yTrain.attr("levels"));
+  }
+
+  unique_ptr<StreamR> stream;
+  if (Rf_isFunction(sStream))
+    stream = make_unique<StreamCallR>(Function(sStream), levelsTrain);
+  else
+    stream = make_unique<StreamFileR>(as<string>(sStream), levelsTrain);
+
+  PredictBridge::initSink(stream.get());
+  if (isCtg) {
+    samplerBridge.predictCtg(forestBridge, vector<unsigned int>(0));
+  }
+  else {
+    samplerBridge.predictReg(forestBridge, vector<double>(0));
+  }
+  PredictBridge::initSink(nullptr);
+
+  return List::create(_["prediction"] = stream->summary());
+}
+
+
+StreamR::StreamR(const CharacterVector& levelsTrain_) :
+  levelsTrain(levelsTrain_),
+  nRow(0),
+  nBlock(0) {
+}
+
+
+List StreamR::summary() const {
+  List streamed = List::create(_["nRow"] = nRow,
+			       _["nBlock"] = nBlock);
+  streamed.attr("class") = "PredictStream";
+  return streamed;
+}
+
+
+StreamFileR::StreamFileR(const string& prefix_,
+			 const CharacterVector& levelsTrain_) :
+  StreamR(levelsTrain_),
+  prefix(prefix_) {
+}
+
+
+ofstream& StreamFileR::open(ofstream& out,
+			    const string& suffix) {
+  if (!out.is_open()) {
+    out.open(prefix + suffix, ios::binary | ios::trunc);
+    if (!out)
+      stop("Unable to open prediction stream " + prefix + suffix);
+  }
+  return out;
+}
+
+
+void StreamFileR::indices(size_t obsStart,
+			  size_t span,
+			  unsigned int nTree,
+			  const IndexT leafIdx[]) {
+  vector<int> idxOne(span * nTree);
+  for (size_t idx = 0; idx != idxOne.size(); idx++) {
+    idxOne[idx] = leafIdx[idx] == noLeaf ? NA_INTEGER : static_cast<int>(leafIdx[idx]);
+  }
+  write(open(idxOut, ".indices"), &idxOne[0], idxOne.size());
+}
+
+
+void StreamFileR::scoresReg(size_t obsStart,
+			    size_t span,
+			    const double yPred[],
+			    unsigned int qCount,
+			    const double qPred[],
+			    const double qEst[]) {
+  write(open(yPredOut, ".yPred"), yPred, span);
+  if (qPred != nullptr) {
+    write(open(qPredOut, ".qPred"), qPred, span * qCount);
+    write(open(qEstOut, ".qEst"), qEst, span);
+  }
+  tally(span);
+}
+
+
+void StreamFileR::scoresCtg(size_t obsStart,
+			    size_t span,
+			    CtgT nCtg,
+			    const CtgT yPred[],
+			    const unsigned int census[],
+			    const double prob[]) {
+  vector<int> yOne(span);
+  for (size_t row = 0; row != span; row++) {
+    yOne[row] = yPred[row] + 1;
+  }
+  write(open(yPredOut, ".yPred"), &yOne[0], span);
+  write(open(censusOut, ".census"), census, span * nCtg);
+  if (prob != nullptr) {
+    write(open(probOut, ".prob"), prob, span * nCtg);
+  }
+  tally(span);
+}
+
+
+StreamCallR::StreamCallR(const Function& callback_,
+			 const CharacterVector& levelsTrain_) :
+  StreamR(levelsTrain_),
+  callback(callback_),
+  indexBlock(R_NilValue) {
+}
+
+
+void StreamCallR::indices(size_t obsStart,
+			  size_t span,
+			  unsigned int nTree,
+			  const IndexT leafIdx[]) {
+  IntegerMatrix idxOut(span, nTree);
+  for (size_t row = 0; row != span; row++) {
+    for (unsigned int tIdx = 0; tIdx != nTree; tIdx++) {
+      IndexT leaf = leafIdx[row * nTree + tIdx];
+      idxOut(row, tIdx) = leaf == noLeaf ? NA_INTEGER : static_cast<int>(leaf);
+    }
+  }
+  indexBlock = idxOut;
+}
+
+
+void StreamCallR::scoresReg(size_t obsStart,
+			    size_t span,
+			    const double yPred[],
+			    unsigned int qCount,
+			    const double qPred[],
+			    const double qEst[]) {
+  List block = List::create(_["obsStart"] = obsStart + 1,
+			    _["yPred"] = NumericVector(yPred, yPred + span),
+			    _["qPred"] = qPred == nullptr ? NumericMatrix(0) : transpose(NumericMatrix(qCount, span, qPred)),
+			    _["qEst"] = qEst == nullptr ? NumericVector(0) : NumericVector(qEst, qEst + span),
+			    _["indices"] = indexBlock);
+  indexBlock = R_NilValue;
+  tally(span);
+  callback(block);
+}
+
+
+void StreamCallR::scoresCtg(size_t obsStart,
+			    size_t span,
+			    CtgT nCtg,
+			    const CtgT yPred[],
+			    const unsigned int census[],
+			    const double prob[]) {
+  IntegerVector yOne(span);
+  for (size_t row = 0; row != span; row++) {
+    yOne[row] = yPred[row] + 1;
+  }
+  yOne.attr("levels") = levelsTrain;
+  yOne.attr("class") = "factor";
+
+  IntegerMatrix censusOut = transpose(IntegerMatrix(nCtg, span, census));
+  censusOut.attr("dimnames") = List::create(R_NilValue, levelsTrain);
+  NumericMatrix probOut(0);
+  if (prob != nullptr) {
+    probOut = transpose(NumericMatrix(nCtg, span, prob));
+    probOut.attr("dimnames") = List::create(R_NilValue, levelsTrain);
+  }
+
+  List block = List::create(_["obsStart"] = obsStart + 1,
+			    _["yPred"] = yOne,
+			    _["census"] = censusOut,
+			    _["prob"] = probOut,
+			    _["indices"] = indexBlock);
+  indexBlock = R_NilValue;
+  tally(span);
+  callback(block);
+}
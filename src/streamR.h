@@ -0,0 +1,184 @@
+// Copyright (C)  2012-2024  Mark Seligman
+//
+// This file is part of RboristBase.
+//
+// RboristBase is free software: you can redistribute it and/or modify it
+// under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// RboristBase is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with RboristBase.  If not, see <http://www.gnu.org/licenses/>.
+
+
+/**
+   @file streamR.h
+
+   @brief C++ interface to R sinks for streamed prediction.
+
+   @author Mark Seligman
+ */
+
+#ifndef RBORIST_BASE_STREAM_R_H
+#define RBORIST_BASE_STREAM_R_H
+
+#include <Rcpp.h>
+using namespace Rcpp;
+
+#include "predictsink.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+using namespace std;
+
+struct SamplerBridge;
+struct ForestBridge;
+
+
+/**
+   @brief Front-end sink, counting the rows streamed.
+ */
+struct StreamR : public PredictSink {
+  static const string strStream;
+
+  const CharacterVector levelsTrain; ///< Empty iff regression.
+  size_t nRow; ///< # rows streamed.
+  unsigned int nBlock; ///< # blocks streamed.
+
+  StreamR(const CharacterVector& levelsTrain_);
+
+  virtual ~StreamR() = default;
+
+
+  /**
+     @brief Predicts through a sink specified by the front end.
+
+     Testing and permutation are not supported, as scores are not
+     retained.
+
+     @param sStream is either a file prefix or a function.
+
+     @return summary of the streamed prediction.
+   */
+  static List predict(const SEXP sStream,
+		      const List& lSampler,
+		      const SamplerBridge& samplerBridge,
+		      ForestBridge& forestBridge);
+
+
+  /**
+     @brief Counts a block of scores.
+   */
+  void tally(size_t span) {
+    nRow += span;
+    nBlock++;
+  }
+
+
+  /**
+     @return wrapped row and block counts.
+   */
+  List summary() const;
+};
+
+
+/**
+   @brief Appends each field to a binary file named by a common prefix.
+
+   Integers are written as 32-bit values, with missing leaves as R's
+   NA_integer_, and doubles as 64-bit values, both in native byte
+   order and row-major.  Categories are one-based.
+ */
+struct StreamFileR : public StreamR {
+  const string prefix; ///< Leads each file name.
+  ofstream idxOut; ///< Leaf indices:  ".indices".
+  ofstream yPredOut; ///< Predicted responses:  ".yPred".
+  ofstream qPredOut; ///< Quantile predictions:  ".qPred".
+  ofstream qEstOut; ///< Quantile estimates:  ".qEst".
+  ofstream censusOut; ///< Census counts:  ".census".
+  ofstream probOut; ///< Category probabilities:  ".prob".
+
+  StreamFileR(const string& prefix_,
+	      const CharacterVector& levelsTrain_);
+
+
+  /**
+     @brief Opens the file for a field on first use.
+   */
+  ofstream& open(ofstream& out,
+		 const string& suffix);
+
+
+  template<typename valType>
+  void write(ofstream& out,
+	     const valType val[],
+	     size_t nVal) {
+    out.write(reinterpret_cast<const char*>(val), nVal * sizeof(valType));
+    if (!out)
+      stop("Unable to write prediction stream " + prefix);
+  }
+
+
+  void indices(size_t obsStart,
+	       size_t span,
+	       unsigned int nTree,
+	       const IndexT leafIdx[]);
+
+
+  void scoresReg(size_t obsStart,
+		 size_t span,
+		 const double yPred[],
+		 unsigned int qCount,
+		 const double qPred[],
+		 const double qEst[]);
+
+
+  void scoresCtg(size_t obsStart,
+		 size_t span,
+		 CtgT nCtg,
+		 const CtgT yPred[],
+		 const unsigned int census[],
+		 const double prob[]);
+};
+
+
+/**
+   @brief Passes each block to an R function, as a list.
+ */
+struct StreamCallR : public StreamR {
+  Function callback;
+  RObject indexBlock; ///< Leaf indices awaiting the block's scores.
+
+  StreamCallR(const Function& callback_,
+	      const CharacterVector& levelsTrain_);
+
+
+  void indices(size_t obsStart,
+	       size_t span,
+	       unsigned int nTree,
+	       const IndexT leafIdx[]);
+
+
+  void scoresReg(size_t obsStart,
+		 size_t span,
+		 const double yPred[],
+		 unsigned int qCount,
+		 const double qPred[],
+		 const double qEst[]);
+
+
+  void scoresCtg(size_t obsStart,
+		 size_t span,
+		 CtgT nCtg,
+		 const CtgT yPred[],
+		 const unsigned int census[],
+		 const double prob[]);
+};
+
+#endif
@@ -24,6 +24,7 @@
  */
 
 #include "grovebridge.h"
+#include "forestbridge.h"
 #include "leafbridge.h"
 #include "trainR.h"
 #include "trainbridge.h"
@@ -45,13 +46,18 @@ const string TrainR::strLeaf = "leaf";
 const string TrainR::strDiagnostic = "diag";
 const string TrainR::strClassName = "arbTrain";
 const string TrainR::strAutoCompress = "autoCompress";
+const string TrainR::strCoarseCuts = "coarseCuts";
 const string TrainR::strEnableCoproc = "enableCoproc";
 const string TrainR::strVerbose = "verbose";
 const string TrainR::strProbVec = "probVec";
 const string TrainR::strPredFixed = "predFixed";
+const string TrainR::strPredTree = "predTree";
 const string TrainR::strSplitQuant ="splitQuant";
 const string TrainR::strMinNode = "minNode";
 const string TrainR::strNLevel = "nLevel";
+const string TrainR::strFinishNode = "finishNode";
+const string TrainR::strExtraTrees = "extraTrees";
+const string TrainR::strApproxNode = "approxNode";
 const string TrainR::strMinInfo = "minInfo";
 const string TrainR::strLoss = "loss";
 const string TrainR::strForestScore = "forestScore";
@@ -68,7 +74,7 @@ const string TrainR::strClassWeight = "classWeight";
 // [[Rcpp::export]]
 List TrainR::train(const List& lDeframe, const List& lSampler, const List& argList) {
   vector<string> diag;
-  TrainBridge trainBridge(RLEFrameR::unwrap(lDeframe), as<double>(argList[strAutoCompress]), as<bool>(argList[strEnableCoproc]), diag);
+  TrainBridge trainBridge(RLEFrameR::unwrap(lDeframe), as<double>(argList[strAutoCompress]), as<unsigned int>(argList[strCoarseCuts]), as<bool>(argList[strEnableCoproc]), diag);
   initPerInvocation(lDeframe, argList, trainBridge);
 
   if (verbose)
@@ -76,6 +82,8 @@ List TrainR::train(const List& lDeframe, const List& lSampler, const List& argLi
 
   TrainR trainR(lSampler);
   trainR.trainGrove(trainBridge);
+  if (verbose)
+    trainR.reportRestage();
   List outList = trainR.summarize(trainBridge, lDeframe, lSampler, argList, diag);
 
   if (verbose)
@@ -185,18 +193,41 @@ void TrainR::consume(const GroveBridge* grove,
   else {
     predInfo = predInfo + infoGrove;
   }
+  const vector<size_t>& volumeGrove = grove->getRestageVolume();
+  if (restageVolume.empty()) {
+    restageVolume = vector<size_t>(volumeGrove.size());
+  }
+  for (unsigned int cause = 0; cause < volumeGrove.size(); cause++) {
+    restageVolume[cause] += volumeGrove[cause];
+  }
   if (verbose) {
     Rcout << treeOff + chunkSize << " trees trained" << endl;
   }
 }
 
 
+void TrainR::reportRestage() const {
+  if (restageVolume.size() < 3)
+    return;
+  Rcout << "Observations restaged:  " << restageVolume[0] << " on demand, "
+	<< restageVolume[1] << " for efficiency, "
+	<< restageVolume[2] << " at path limit" << endl;
+}
+
+
 // [[Rcpp::export]]
 RcppExport SEXP expandTrainRcpp(SEXP sTrain) {
   return TrainR::expand(List(sTrain));
 }
 
 
+// [[Rcpp::export]]
+RcppExport SEXP forestCodeRcpp(SEXP sTrain,
+			       SEXP sName) {
+  return TrainR::code(List(sTrain), as<string>(sName));
+}
+
+
 // [[Rcpp::export]]
 List TrainR::expand(const List& lTrain) {
   IntegerVector predictorMap(predMap(lTrain));
@@ -213,3 +244,29 @@ List TrainR::expand(const List& lTrain) {
   ffe.attr("class") = "expandTrain";
   return ffe;
 }
+
+
+StringVector TrainR::code(const List& lTrain,
+			  const string& name) {
+  IntegerVector predictorMap(predMap(lTrain));
+  CharacterVector colName(SignatureR::unwrapName(SignatureR::getSignature(lTrain), SignatureR::strColName));
+  vector<string> predName;
+  if (colName.length() == predictorMap.length()) {
+    for (R_xlen_t predIdx = 0; predIdx < predictorMap.length(); predIdx++) {
+      predName.emplace_back(colName[predictorMap[predIdx]]);
+    }
+  }
+
+  List level(SignatureR::getLevel(lTrain));
+  vector<unsigned int> facCard;
+  for (R_xlen_t facIdx = 0; facIdx < level.length(); facIdx++) {
+    facCard.push_back(as<CharacterVector>(level[facIdx]).length());
+  }
+
+  TrainBridge::init(predictorMap.length());
+  ForestBridge forestBridge(ForestR::unwrap(lTrain));
+  string source = forestBridge.emitCode(predictorMap.length() - facCard.size(), facCard, predName, name);
+  TrainBridge::deInit();
+
+  return StringVector::create(source);
+}
@@ -48,6 +48,19 @@ using namespace std;
 RcppExport SEXP expandTrainRcpp(SEXP sTrain);
 
 
+/**
+   @brief Renders trained forest as specialized C++ source.
+
+   @param sTrain is the trained forest.
+
+   @param sName is the namespace enclosing the generated code.
+
+   @return source text as a single string.
+ */
+RcppExport SEXP forestCodeRcpp(SEXP sTrain,
+			       SEXP sName);
+
+
 struct TrainR {
 
   // Training granularity.  Values guesstimated to minimize footprint of
@@ -65,13 +78,18 @@ struct TrainR {
   static const string strDiagnostic;
   static const string strClassName;
   static const string strAutoCompress;
+  static const string strCoarseCuts;
   static const string strEnableCoproc;
   static const string strVerbose;
   static const string strProbVec;
   static const string strPredFixed;
+  static const string strPredTree;
   static const string strSplitQuant;
   static const string strMinNode;
   static const string strNLevel;
+  static const string strFinishNode;
+  static const string strExtraTrees;
+  static const string strApproxNode;
   static const string strMinInfo;
   static const string strLoss;
   static const string strForestScore;
@@ -91,6 +109,7 @@ struct TrainR {
   LeafR leaf; ///< Summarizes sample-to-leaf mapping.
   FBTrain forest; ///< Pointer to core forest.
   NumericVector predInfo; ///< Forest-wide sum of predictors' split information.
+  vector<size_t> restageVolume; ///< Forest-wide # observations restaged, by cause.
   double nu; ///< Learning rate, passed up from training.
   double baseScore; ///< Base score, " ".
 
@@ -103,6 +122,12 @@ struct TrainR {
   void trainGrove(const struct TrainBridge& tb);
 
 
+  /**
+     @brief Reports restaging volume by cause, in verbose mode.
+   */
+  void reportRestage() const;
+
+
   static IntegerVector predMap(const List& lTrain);
 
   
@@ -200,6 +225,13 @@ struct TrainR {
      @brief Expands contents as vectors interpretable by the front end.
    */
   static List expand(const List& lTrain);
+
+
+  /**
+     @brief Emits the forest as C++ source, annotated by predictor name.
+   */
+  static StringVector code(const List& lTrain,
+			   const string& name);
   
 private:
   
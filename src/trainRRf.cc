@@ -37,14 +37,19 @@ void TrainR::initPerInvocation(const List& lDeframe,
   verbose = as<bool>(argList[strVerbose]);
   NumericVector probVecNV((SEXP) argList[strProbVec]);
   vector<double> predProb(as<vector<double> >(probVecNV[predMap]));
-  trainBridge.initProb(as<unsigned int>(argList[strPredFixed]), predProb);
+  trainBridge.initProb(as<unsigned int>(argList[strPredFixed]),
+		       predProb,
+		       as<unsigned int>(argList[strPredTree]));
 
   NumericVector splitQuantNV((SEXP) argList[strSplitQuant]);
   vector<double> splitQuant(as<vector<double> >(splitQuantNV[predMap]));
   trainBridge.initSplit(as<unsigned int>(argList[strMinNode]),
 			 as<unsigned int>(argList[strNLevel]),
+			 as<unsigned int>(argList[strFinishNode]),
 			 as<double>(argList[strMinInfo]),
-			 splitQuant);
+			 splitQuant,
+			 as<bool>(argList[strExtraTrees]),
+			 as<unsigned int>(argList[strApproxNode]));
 
   trainBridge.initBooster(as<string>(argList[strLoss]),
 			  as<string>(argList[strForestScore]));
@@ -54,6 +59,7 @@ void TrainR::initPerInvocation(const List& lDeframe,
   trainBridge.initGrove(as<bool>(argList[strThinLeaves]),
 			as<unsigned int>(argList[strTreeBlock]));
   CoreBridge::init(as<unsigned int>(argList[strNThread]));
+  CoreBridge::seed();
   
   if (!Rf_isFactor((SEXP) argList[strY])) {
     NumericVector regMonoNV((SEXP) argList[strRegMono]);
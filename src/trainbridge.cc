@@ -17,7 +17,7 @@
 #include "predictorframe.h"
 #include "coproc.h"
 
-TrainBridge::TrainBridge(unique_ptr<RLEFrame> rleFrame, double autoCompress, bool enableCoproc, vector<string>& diag) : frame(make_unique<PredictorFrame>(std::move(rleFrame), autoCompress, enableCoproc, diag)) {
+TrainBridge::TrainBridge(unique_ptr<RLEFrame> rleFrame, double autoCompress, unsigned int nBin, bool enableCoproc, vector<string>& diag) : frame(make_unique<PredictorFrame>(std::move(rleFrame), autoCompress, nBin, enableCoproc, diag)) {
   init(frame->getNPred());
 }
 
@@ -37,8 +37,9 @@ void TrainBridge::initGrove(bool thinLeaves,
 
 
 void TrainBridge::initProb(unsigned int predFixed,
-                           const vector<double> &predProb) {
-  FETrain::initProb(predFixed, predProb);
+                           const vector<double> &predProb,
+			   unsigned int predTree) {
+  FETrain::initProb(predFixed, predProb, predTree);
 }
 
 
@@ -85,9 +86,12 @@ void TrainBridge::initNodeScorer(const string& scorer) {
 
 void TrainBridge::initSplit(unsigned int minNode,
                             unsigned int totLevels,
+                            unsigned int finishNode,
                             double minRatio,
-			    const vector<double>& feSplitQuant) {
-  FETrain::initSplit(minNode, totLevels, minRatio, feSplitQuant);
+			    const vector<double>& feSplitQuant,
+			    bool extraTrees,
+			    unsigned int approxNode) {
+  FETrain::initSplit(minNode, totLevels, finishNode, minRatio, feSplitQuant, extraTrees, approxNode);
 }
   
 
@@ -27,6 +27,7 @@ class PredictorFrame;
 struct TrainBridge {
   TrainBridge(unique_ptr<struct RLEFrame> rleFrame,
 	      double autoCompress,
+	      unsigned int nBin,
 	      bool enableCoproc,
 	      vector<string>& diag);
 
@@ -56,8 +57,12 @@ struct TrainBridge {
 			unsigned int trainBlock);
 
 
+  /**
+     @param predTree is the per-tree predictor subspace size, if nonzero.
+   */
   static void initProb(unsigned int predFixed,
-                       const vector<double> &predProb);
+                       const vector<double> &predProb,
+		       unsigned int predTree);
 
   /**
      @brief Registers tree-shape parameters.
@@ -106,14 +111,24 @@ struct TrainBridge {
 
      @param totLevels is the maximum tree depth to train.
 
+     @param finishNode is the node size below which splitting is depth-first, if nonzero.
+
      @param minRatio is the minimum information ratio of a node to its parent.
      
      @param splitQuant is a per-predictor quantile specification.
+
+     @param extraTrees is true iff cuts are drawn at random.
+
+     @param approxNode is the cell size above which cuts are sketched
+     from a sample, if nonzero.
   */
   static void initSplit(unsigned int minNode,
                         unsigned int totLevels,
+                        unsigned int finishNode,
                         double minRatio,
-			const vector<double>& feSplitQuant);
+			const vector<double>& feSplitQuant,
+			bool extraTrees,
+			unsigned int approxNode);
   
   /**
      @brief Registers monotone specifications for regression.
@@ -54,6 +54,20 @@ void TreeNode::critBits(const SplitNux& nux,
   setPredIdx(nux.getPredIdx());
   criterion.critBits(bitPos);
 }
+
+
+void TreeNode::critCut(PredictorT predIdx,
+		       double quantRank) {
+  setPredIdx(predIdx);
+  criterion.setNum(quantRank);
+}
+
+
+void TreeNode::critBits(PredictorT predIdx,
+			size_t bitPos) {
+  setPredIdx(predIdx);
+  criterion.critBits(bitPos);
+}
   
 
 void TreeNode::setQuantRank(const PredictorFrame* frame) {
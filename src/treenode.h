@@ -89,6 +89,14 @@ public:
   }
 
 
+  /**
+     @return true iff missing values take the true branch.
+   */
+  bool getInvert() const {
+    return invert;
+  }
+
+
   void setPredIdx(PredictorT predIdx) {
     packed |= predIdx;
   }
@@ -167,6 +175,19 @@ public:
 		size_t bitPos);
 
 
+  /**
+     @brief As above, but specified directly, as by a finisher.
+
+     @param quantRank is the fractional rank of the cut.
+   */
+  void critCut(PredictorT predIdx,
+	       double quantRank);
+
+
+  void critBits(PredictorT predIdx,
+		size_t bitPos);
+
+
   /**
      @brief Getter for numeric splitting value.
 
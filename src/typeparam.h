@@ -127,7 +127,19 @@ struct IndexRange {
 };
 
 
+/**
+   @brief Per-observation record of the path reaching the frontier.
+
+   A path of width w bits distinguishes descendants over a history of
+   at most w - 1 layers, beyond which restaging cannot be deferred.
+   Defining ARBORIST_PATH16, for example via PKG_CPPFLAGS, widens the
+   encoding to 16 bits at twice the cost in path bandwidth.
+ */
+#ifdef ARBORIST_PATH16
+using PathT = uint16_t;
+#else
 using PathT = unsigned char;
+#endif
 
 /**
    @brief Template parametrization; specialization for double.
@@ -35,6 +35,23 @@ struct Util {
 
     return width;
   }
+
+
+  /**
+     @return position of lowest set bit, which must exist.
+   */
+  static unsigned int lowBit(PackedT bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    unsigned int pos = 0;
+    while ((bits & 1ull) == 0) {
+      bits >>= 1;
+      pos++;
+    }
+    return pos;
+#endif
+  }
 };
 
 #endif